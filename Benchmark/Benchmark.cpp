@@ -0,0 +1,1491 @@
+//+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+
+// 
+//  ___________ __  .__                       ___________
+//  \_   _____//  |_|  |__ _____    ____      \_   _____/
+//   |    __)_\   __\  |  \\__  \  /    \      |    __)_ 
+//   |        \|  | |   Y  \/ __ \|   |  \     |        \
+//  /_______  /|__| |___|  (____  /___|  / /\ /_______  /
+//          \/           \/     \/     \/  \/         \/ 
+// 
+// Loopback Benchmark Driver
+//
+//  Author   Date         Description
+// --------------------------------------------------------
+//  ECE      10-17-2026   Initial Implementation, UDP packets per second
+//  ECE      10-17-2026   Runs the processing thread to drain receive queues
+//  ECE      10-17-2026   TCP throughput for 1 to N event loops
+//  ECE      10-17-2026   Received messages are handled on the handler pool
+//  ECE      10-17-2026   Servers are created in the socket registry
+//  ECE      10-17-2026   Round trip sweep of payload size, connections and protocol
+//  ECE      10-17-2026   Cost of a log call against fprintf on the calling thread
+//  ECE      10-17-2026   TCP send throughput copied against zero-copy by size
+//  ECE      10-17-2026   UNIX_STREAM pairs in the round trip sweep
+//  ECE      10-17-2026   SHARED_MEMORY pairs in the round trip sweep
+//  ECE      10-17-2026   Multicast loopback fan-in, groups told apart on one socket
+//  ECE      10-17-2026   TCP throughput on Registered I/O against EVENT_SELECT
+//  ECE      10-17-2026   Send queue contention, MPSC and SPSC rings against a mutex
+//+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+
+
+#include "Universal_Socket.h"
+#include "Communication_Interface.h"
+#include "Registered_IO.h"
+#include "Socket_Registry.h"
+
+#include <atomic>
+#include <chrono>
+#include <cstdlib>
+#include <cstring>
+#include <deque>
+#include <memory>
+#include <mutex>
+#include <thread>
+#include <vector>
+#include <string>
+
+namespace Benchmark
+{
+   const std::string LOOPBACK{ "127.0.0.1" };
+
+   // Datagrams kept in flight before waiting for the echoes
+   constexpr int WINDOW{ 64 };
+
+   // Datagrams sent for each payload size
+   constexpr int PACKETS_PER_RUN{ 200000 };
+
+   // Longest wait for an echo before it is counted as lost
+   constexpr DWORD RECEIVE_TIMEOUT_MS{ 100 };
+
+   // Framed requests kept in flight on every TCP connection
+   constexpr int PIPELINE{ 8 };
+
+   // Client threads driving a TCP server, and connections each one opens
+   constexpr int CLIENT_THREADS{ 4 };
+   constexpr int CONNECTIONS_PER_CLIENT{ 16 };
+
+   // Payload bytes of every TCP request
+   constexpr size_t TCP_PAYLOAD_SIZE{ 64 };
+
+   // How long each TCP server is driven for
+   constexpr int SCALING_SECONDS{ 3 };
+
+   // TCP servers listen on this port plus their event loop count
+   constexpr uint16_t SCALING_BASE_PORT{ 9200 };
+
+   // Command line of the child process that runs one TCP server
+   const std::string SCALING_MODE{ "tcp_scaling" };
+
+   // Command line of the child process that runs the round trip sweep
+   const std::string SWEEP_MODE{ "rtt_sweep" };
+
+   // Payload sizes swept, 16 bytes to 1 MB, UDP stops at UDP_SLOT_SIZE
+   constexpr size_t SWEEP_PAYLOAD_SIZES[] = { 16, 256, 4096, 65536, 1024 * 1024 };
+
+   // Client and server pairs swept, one request in flight on each
+   constexpr int SWEEP_CONNECTIONS[] = { 1, 8, 64 };
+
+   // Round trips before the measurement, then how long it lasts
+   constexpr int SWEEP_WARMUP_MS{ 500 };
+   constexpr int SWEEP_SECONDS{ 2 };
+
+   // Sweep servers listen on this port plus their run's block of pairs
+   constexpr uint16_t SWEEP_BASE_PORT{ 9300 };
+
+   // Largest frame the sweep's TCP sockets take, a 1 MB payload must fit
+   constexpr uint32_t SWEEP_MAX_FRAME_SIZE{ 2 * 1024 * 1024 };
+
+   // Calls every logging thread makes, and the thread counts measured
+   constexpr int LOG_CALLS_PER_THREAD{ 200000 };
+   constexpr int LOG_THREADS[] = { 1, 4 };
+
+   // Text argument of every log call, as long as a typical socket name
+   const std::string LOG_TEXT{ "Benchmark->Log_Cost_Socket" };
+
+   // Message sizes around the zero-copy crossover, every one sent copied
+   // and zero-copy for ZERO_COPY_SECONDS, each run on its own port
+   constexpr size_t ZERO_COPY_SIZES[] = { 4096, 16384, 65536, 256 * 1024, 1024 * 1024 };
+   constexpr int ZERO_COPY_SECONDS{ 2 };
+   constexpr uint16_t ZERO_COPY_BASE_PORT{ 9400 };
+
+   // Groups one receiving socket joins in each multicast run, each group
+   // has its own sending socket, every run on its own port
+   constexpr int MULTICAST_GROUPS[] = { 1, 16, 64 };
+   constexpr int MULTICAST_MAX_GROUPS{ 64 };
+   constexpr size_t MULTICAST_PAYLOAD_SIZE{ 64 };
+   constexpr uint16_t MULTICAST_BATCH_SIZE{ 64 };
+   constexpr int MULTICAST_SECONDS{ 2 };
+   constexpr uint16_t MULTICAST_BASE_PORT{ 9500 };
+
+   // Message sizes streamed over TCP on each I/O engine, every one fits a
+   // registered send slot, each run on its own port
+   constexpr size_t REGISTERED_IO_SIZES[] = { 16, 64, 512, Registered_IO::SLOT_SIZE };
+   constexpr int REGISTERED_IO_SECONDS{ 2 };
+   constexpr uint16_t REGISTERED_IO_BASE_PORT{ 9600 };
+
+   // Producers pushing pooled send buffers to one consumer at once, the
+   // messages each one pushes, and the capacity of every ring, sixteen
+   // rings of one per producer together fill the send pool
+   constexpr int QUEUE_PRODUCERS[] = { 1, 4, 16 };
+   constexpr int QUEUE_MESSAGES_PER_PRODUCER{ 100000 };
+   constexpr size_t QUEUE_PAYLOAD_SIZE{ 64 };
+   constexpr size_t QUEUE_CAPACITY{ 1024 };
+
+   // How producers hand a send buffer to the consumer in a contention run
+   enum Queue_Kind
+   {
+      MPSC_QUEUE,          // One lock free ring every producer pushes on
+      SPSC_QUEUES,         // A lock free ring per producer, popped in turn
+      MUTEX_QUEUE          // A deque behind a mutex, the baseline
+   };
+
+   struct Server_Case
+   {
+      uint16_t port;
+      uint16_t batch_size;
+   };
+
+   // Totals of every client thread driving a TCP server
+   struct Client_Counts
+   {
+      std::atomic<long long> sent{ 0 };
+      std::atomic<long long> received{ 0 };
+   };
+
+   // One client and the server only it talks to, so every pair's round
+   // trips are timed on a socket no other client loads
+   struct Sweep_Pair
+   {
+      Socket_Vars::Socket_Handle server;
+      Socket_Vars::Socket_Handle client;
+      std::atomic<long long> last_sent_at{ 0 };   // Nanoseconds, steady clock
+   };
+
+   // The sweep run in progress, read by the client handlers
+   struct Sweep_Run
+   {
+      size_t payload_size = 0;
+      std::atomic<bool> is_running{ false };
+      std::atomic<long long> sent{ 0 };
+      std::atomic<long long> received{ 0 };
+      std::vector<Sweep_Pair*> pairs;              // By client socket index
+      Stats::Latency_Histogram round_trips;
+   };
+
+   Sweep_Run* sweep_run = nullptr;
+
+   // Bytes the zero-copy or registered I/O run's server has received
+   std::atomic<long long> zero_copy_received{ 0 };
+
+   // The multicast run in progress, read by the receiver's handler, every
+   // datagram carries the index of the group it was sent to
+   struct Multicast_Run
+   {
+      std::atomic<uint32_t> group_count{ 0 };
+      uint32_t group_ids[MULTICAST_MAX_GROUPS];     // Join_Group() id of each index
+      std::atomic<long long> received_by_group[MULTICAST_MAX_GROUPS];
+      std::atomic<long long> received{ 0 };
+      std::atomic<long long> misrouted{ 0 };       // Handed up with the wrong group
+   };
+
+   Multicast_Run multicast_run;
+
+   //+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+
+   /// @brief   Sends windows of datagrams to a UDP server and
+   /// @brief   counts the echoes, prints one CSV row
+   /// @param   Server_Case       Port and batch size of the server
+   /// @param   size_t            Payload bytes of every datagram
+   /// @return  bool              False if the client could not be made
+   //+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+
+   bool Run_UDP(const Server_Case& server, size_t payload_size)
+   {
+      SOCKET client;
+      SOCKADDR_IN address{};
+      DWORD timeout = RECEIVE_TIMEOUT_MS;
+      std::string payload(payload_size, 'x');
+      char reply[Socket_Vars::UDP_SLOT_SIZE];
+      int sent = 0;
+      int received = 0;
+      int outstanding;
+      double seconds;
+
+      //
+      // 1. Connect a plain client so echoes only come from the server
+      client = socket(AF_INET, SOCK_DGRAM, IPPROTO_UDP);
+      if (INVALID_SOCKET == client)
+      {
+         Log::Write<Log::LEVEL_ERROR>("Benchmark socket() failed with: %u\n", WSAGetLastError());
+         return false;
+      }
+      address.sin_family = AF_INET;
+      address.sin_port = htons(server.port);
+      inet_pton(AF_INET, LOOPBACK.c_str(), &address.sin_addr);
+      if (SOCKET_ERROR == connect(client, reinterpret_cast<SOCKADDR*>(&address), sizeof(address)) ||
+          SOCKET_ERROR == setsockopt(client, SOL_SOCKET, SO_RCVTIMEO, reinterpret_cast<const char*>(&timeout), sizeof(timeout)))
+      {
+         Log::Write<Log::LEVEL_ERROR>("Benchmark connect() failed with: %u\n", WSAGetLastError());
+         closesocket(client);
+         return false;
+      }
+
+      //
+      // 2. Send a window, then collect its echoes so the server's
+      //    receive buffer is never the thing being measured
+      auto start = std::chrono::steady_clock::now();
+      while (sent < PACKETS_PER_RUN)
+      {
+         for (outstanding = 0; outstanding < WINDOW && sent < PACKETS_PER_RUN; outstanding++, sent++)
+         {
+            send(client, payload.data(), static_cast<int>(payload.size()), 0);
+         }
+         for (; 0 < outstanding; outstanding--)
+         {
+            if (SOCKET_ERROR == recv(client, reply, sizeof(reply), 0))
+            {
+               break;   // Timed out, the rest of the window was dropped
+            }
+            received++;
+         }
+      }
+      seconds = std::chrono::duration<double>(std::chrono::steady_clock::now() - start).count();
+
+      //
+      // 3. Echoes count as packets too, both directions went through the server
+      printf("udp_pps,UDP,%u,%u,%zu,1,%d,%d,%d,%.3f,%.0f,%.2f,,,\n",
+         Socket_Vars::event_loop_count, server.batch_size, payload_size, WINDOW,
+         sent, received, seconds, (sent + received) / seconds,
+         (sent + received) * payload_size / seconds / 1e6);
+
+      closesocket(client);
+      return true;
+   }  // END Run_UDP()
+
+   //+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+
+   /// @brief   Reads exactly length bytes off a blocking socket
+   /// @param   SOCKET            Connected socket
+   /// @param   char*             Buffer to read into
+   /// @param   int               Number of bytes to read
+   /// @return  bool              False on timeout, error or close
+   //+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+
+   bool Receive_All(SOCKET client, char* buffer, int length)
+   {
+      int bytes;
+
+      while (0 < length)
+      {
+         bytes = recv(client, buffer, length, 0);
+         if (0 >= bytes)
+         {
+            return false;
+         }
+         buffer += bytes;
+         length -= bytes;
+      }
+      return true;
+   }  // END Receive_All()
+
+   //+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+
+   /// @brief   Opens connections to a framed TCP server and keeps
+   /// @brief   PIPELINE requests in flight on each until the end
+   /// @brief   time, every reply read is answered with a request
+   /// @param   uint16_t          Port of the server
+   /// @param   steady_clock      When to stop sending
+   /// @param   Client_Counts     Totals to add this thread's counts to
+   /// @return  None
+   //+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+
+   void Run_TCP_Client(uint16_t port, std::chrono::steady_clock::time_point end, Client_Counts* counts)
+   {
+      SOCKADDR_IN address{};
+      DWORD timeout = 1000;
+      int no_delay = 1;
+      char header[Framing::MAX_HEADER_SIZE];
+      char reply[Socket_Vars::UDP_SLOT_SIZE];
+      uint32_t reply_length;
+      uint32_t header_size;
+      std::string request;
+      std::vector<SOCKET> clients;
+      long long sent = 0;
+      long long received = 0;
+
+      //
+      // 1. Build one framed request, every send reuses it
+      request.assign(TCP_PAYLOAD_SIZE, 'x');
+      header_size = Framing::Encode_Header(Framing::FIXED_32, static_cast<uint32_t>(TCP_PAYLOAD_SIZE), header);
+      request.insert(0, header, header_size);
+
+      //
+      // 2. Connect every client and fill its pipeline
+      address.sin_family = AF_INET;
+      address.sin_port = htons(port);
+      inet_pton(AF_INET, LOOPBACK.c_str(), &address.sin_addr);
+      for (int i = 0; i < CONNECTIONS_PER_CLIENT; i++)
+      {
+         SOCKET client = socket(AF_INET, SOCK_STREAM, IPPROTO_TCP);
+         if (INVALID_SOCKET == client ||
+             SOCKET_ERROR == connect(client, reinterpret_cast<SOCKADDR*>(&address), sizeof(address)))
+         {
+            Log::Write<Log::LEVEL_ERROR>("Benchmark TCP connect() failed with: %u\n", WSAGetLastError());
+            if (INVALID_SOCKET != client)
+            {
+               closesocket(client);
+            }
+            continue;
+         }
+         setsockopt(client, IPPROTO_TCP, TCP_NODELAY, reinterpret_cast<const char*>(&no_delay), sizeof(no_delay));
+         setsockopt(client, SOL_SOCKET, SO_RCVTIMEO, reinterpret_cast<const char*>(&timeout), sizeof(timeout));
+         for (int j = 0; j < PIPELINE; j++)
+         {
+            send(client, request.data(), static_cast<int>(request.size()), 0);
+            sent++;
+         }
+         clients.push_back(client);
+      }
+
+      //
+      // 3. Read one framed reply from each client in turn and answer it,
+      //    a client that stalls is dropped from the run
+      while (!clients.empty() && std::chrono::steady_clock::now() < end)
+      {
+         for (size_t i = 0; i < clients.size(); i++)
+         {
+            if (!Receive_All(clients[i], header, 4))
+            {
+               closesocket(clients[i]);
+               clients[i] = clients.back();
+               clients.pop_back();
+               i--;
+               continue;
+            }
+            reply_length = (static_cast<uint32_t>(static_cast<uint8_t>(header[0])) << 24) |
+                           (static_cast<uint32_t>(static_cast<uint8_t>(header[1])) << 16) |
+                           (static_cast<uint32_t>(static_cast<uint8_t>(header[2])) << 8) |
+                            static_cast<uint32_t>(static_cast<uint8_t>(header[3]));
+            if (sizeof(reply) < reply_length || !Receive_All(clients[i], reply, static_cast<int>(reply_length)))
+            {
+               closesocket(clients[i]);
+               clients[i] = clients.back();
+               clients.pop_back();
+               i--;
+               continue;
+            }
+            received++;
+
+            send(clients[i], request.data(), static_cast<int>(request.size()), 0);
+            sent++;
+         }
+      }
+
+      for (SOCKET client : clients)
+      {
+         closesocket(client);
+      }
+      counts->sent.fetch_add(sent);
+      counts->received.fetch_add(received);
+   }  // END Run_TCP_Client()
+
+   //+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+
+   /// @brief   Runs one framed TCP echo server on event_loop_count
+   /// @brief   event loops, drives it from the client threads and
+   /// @brief   prints one CSV row, a fresh process for every loop
+   /// @brief   count since the count is fixed by the first socket
+   /// @return  bool              False if the server could not start
+   //+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+
+   bool Run_TCP_Scaling()
+   {
+      bool result = true;
+      uint16_t port = static_cast<uint16_t>(SCALING_BASE_PORT + Socket_Vars::event_loop_count);
+      Client_Counts counts;
+      std::vector<std::thread> clients;
+      double seconds;
+
+      //
+      // 1. Start the server and one receiving and sending thread per loop
+      Socket_Vars::Socket_Handle server = Socket_Vars::Sockets().Create
+      (
+         Socket_Vars::TCP,
+         Socket_Vars::SERVER,
+         LOOPBACK,
+         port,
+         "Benchmark->TCP_Loops_" + std::to_string(Socket_Vars::event_loop_count)
+      );
+      result &= (nullptr != Socket_Vars::Sockets().Get(server));
+      if (result)
+      {
+         Socket_Vars::Sockets().Get(server)->Set_Framing(Framing::FIXED_32);
+         result &= Socket_Vars::Sockets().Start(server);
+      }
+      if (!result)
+      {
+         Log::Write<Log::LEVEL_ERROR>("Problem occurred starting the TCP benchmark server!\n");
+         return result;
+      }
+      for (uint16_t loop = 0; loop < Socket_Vars::event_loop_count; loop++)
+      {
+         std::thread(Comms_Interface::Socket_Receiving_Thread, loop).detach();
+         std::thread(Comms_Interface::Socket_Sending_Thread, loop).detach();
+      }
+
+      //
+      // 2. Drive it from every client thread for the same fixed time
+      auto start = std::chrono::steady_clock::now();
+      auto end = start + std::chrono::seconds(SCALING_SECONDS);
+      for (int i = 0; i < CLIENT_THREADS; i++)
+      {
+         clients.emplace_back(Run_TCP_Client, port, end, &counts);
+      }
+      for (std::thread& client : clients)
+      {
+         client.join();
+      }
+      seconds = std::chrono::duration<double>(std::chrono::steady_clock::now() - start).count();
+
+      //
+      // 3. Requests and replies both went through the server
+      printf("tcp_scaling,TCP,%u,1,%zu,%d,%d,%lld,%lld,%.3f,%.0f,%.2f,,,\n",
+         Socket_Vars::event_loop_count, TCP_PAYLOAD_SIZE, CLIENT_THREADS * CONNECTIONS_PER_CLIENT, PIPELINE,
+         counts.sent.load(), counts.received.load(), seconds,
+         (counts.sent.load() + counts.received.load()) / seconds,
+         (counts.sent.load() + counts.received.load()) * TCP_PAYLOAD_SIZE / seconds / 1e6);
+
+      return result;
+   }  // END Run_TCP_Scaling()
+
+   //+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+
+   /// @brief   Nanoseconds on the steady clock, what requests carry
+   /// @return  long long         Nanoseconds since the clock's epoch
+   //+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+
+   inline long long Now_Nanoseconds()
+   {
+      return std::chrono::duration_cast<std::chrono::nanoseconds>(
+         std::chrono::steady_clock::now().time_since_epoch()).count();
+   }
+
+   //+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+
+   /// @brief   Path a UNIX_STREAM sweep server listens on, in the
+   /// @brief   temporary directory and named for its port
+   /// @param   uint16_t          Port the pair would use over TCP
+   /// @return  std::string       Path of the socket
+   //+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+
+   std::string Unix_Path(uint16_t port)
+   {
+      char directory[MAX_PATH];
+      DWORD length = GetTempPathA(MAX_PATH, directory);
+
+      return std::string(directory, length) + "universal_socket_" + std::to_string(port) + ".sock";
+   }  // END Unix_Path()
+
+   //+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+
+   /// @brief   Queues one request on a sweep client, stamped with
+   /// @brief   the time it was sent in its first 8 bytes
+   /// @param   Sweep_Pair        Pair the request goes out on
+   /// @return  None
+   //+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+
+   void Send_Request(Sweep_Pair& pair)
+   {
+      std::string request(sweep_run->payload_size, 'x');
+      long long sent_at = Now_Nanoseconds();
+
+      memcpy(&request[0], &sent_at, sizeof(sent_at));
+      pair.last_sent_at.store(sent_at, std::memory_order_relaxed);
+      if (Socket_Vars::Queue_Message(pair.client.index, std::move(request)))
+      {
+         sweep_run->sent.fetch_add(1, std::memory_order_relaxed);
+      }
+   }  // END Send_Request()
+
+   //+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+
+   /// @brief   Sweep servers send every message straight back, from
+   /// @brief   the buffer it was received into
+   /// @param   Message_Context   Server socket's context
+   /// @param   Received_Message  Request to echo
+   /// @return  None
+   //+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+
+   void Echo_Handler(Socket_Vars::Message_Context& context, Socket_Vars::Received_Message& received)
+   {
+      if (Socket_Vars::MESSAGE_RECEIVED == received.event)
+      {
+         Socket_Vars::Reply(context, received, received.message);
+      }
+   }  // END Echo_Handler()
+
+   //+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+
+   /// @brief   Sweep clients time the echo against the stamp it
+   /// @brief   carries and send the next request while running
+   /// @param   Message_Context   Client socket's context
+   /// @param   Received_Message  Echo of the last request
+   /// @return  None
+   //+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+
+   void Round_Trip_Handler(Socket_Vars::Message_Context& context, Socket_Vars::Received_Message& received)
+   {
+      long long sent_at;
+
+      if (Socket_Vars::MESSAGE_RECEIVED != received.event || sizeof(sent_at) > received.message.Size())
+      {
+         return;
+      }
+      memcpy(&sent_at, received.message.Data(), sizeof(sent_at));
+      sweep_run->round_trips.Record(static_cast<uint64_t>(Now_Nanoseconds() - sent_at));
+      sweep_run->received.fetch_add(1, std::memory_order_relaxed);
+
+      if (sweep_run->is_running.load(std::memory_order_relaxed))
+      {
+         Send_Request(*sweep_run->pairs[context.socket_index]);
+      }
+   }  // END Round_Trip_Handler()
+
+   //+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+
+   /// @brief   Times round trips over connection_count pairs for
+   /// @brief   one protocol and payload size, prints one CSV row
+   /// @param   Protocol          TCP, UDP, UNIX_STREAM or SHARED_MEMORY
+   /// @param   size_t            Payload bytes of every request
+   /// @param   int               Client and server pairs
+   /// @param   uint16_t          First port of the run's servers
+   /// @return  bool              False if a pair could not start
+   //+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+
+   bool Run_Sweep(Socket_Vars::Protocol protocol, size_t payload_size, int connection_count, uint16_t port)
+   {
+      bool result = true;
+      const char* protocol_name = (Socket_Vars::TCP == protocol) ? "TCP"
+         : (Socket_Vars::UDP == protocol) ? "UDP"
+         : (Socket_Vars::UNIX_STREAM == protocol) ? "UNIX" : "SHM";
+      std::vector<Sweep_Pair> pairs(connection_count);
+      Stats::Histogram_Snapshot round_trips;
+      long long sent;
+      long long received;
+      double seconds;
+
+      sweep_run->payload_size = payload_size;
+      sweep_run->sent = 0;
+      sweep_run->received = 0;
+      sweep_run->round_trips.Reset();
+
+      //
+      // 1. Start every pair, the server on its own port, path or mapping,
+      //    and a client that only talks to it
+      for (int i = 0; i < connection_count && result; i++)
+      {
+         uint16_t pair_port = static_cast<uint16_t>(port + i);
+         std::string name = std::string("Benchmark->Sweep_") + protocol_name + "_" + std::to_string(i);
+         std::string address = (Socket_Vars::UNIX_STREAM == protocol) ? Unix_Path(pair_port)
+            : (Socket_Vars::SHARED_MEMORY == protocol) ? "Benchmark_Sweep_" + std::to_string(pair_port) : LOOPBACK;
+
+         pairs[i].server = Socket_Vars::Sockets().Create(protocol, Socket_Vars::SERVER, address, pair_port, name + "_Server");
+         pairs[i].client = Socket_Vars::Sockets().Create(protocol, Socket_Vars::CLIENT, address, pair_port, name + "_Client");
+         if (nullptr == Socket_Vars::Sockets().Get(pairs[i].server) || nullptr == Socket_Vars::Sockets().Get(pairs[i].client))
+         {
+            result &= false;
+            break;
+         }
+         if (Socket_Vars::Is_Stream(protocol))
+         {
+            Socket_Vars::Sockets().Get(pairs[i].server)->Set_Framing(Framing::FIXED_32, SWEEP_MAX_FRAME_SIZE);
+            Socket_Vars::Sockets().Get(pairs[i].client)->Set_Framing(Framing::FIXED_32, SWEEP_MAX_FRAME_SIZE);
+         }
+         Socket_Vars::Sockets().Get(pairs[i].server)->Set_Message_Handler(Echo_Handler);
+         Socket_Vars::Sockets().Get(pairs[i].client)->Set_Message_Handler(Round_Trip_Handler);
+         if (sweep_run->pairs.size() <= pairs[i].client.index)
+         {
+            sweep_run->pairs.resize(pairs[i].client.index + 1, nullptr);
+         }
+         sweep_run->pairs[pairs[i].client.index] = &pairs[i];
+         result &= Socket_Vars::Sockets().Start(pairs[i].server);
+         result &= Socket_Vars::Sockets().Start(pairs[i].client);
+      }
+
+      //
+      // 2. Stream and shared memory clients connect in the background, wait
+      //    for all of them before the first request
+      auto connect_end = std::chrono::steady_clock::now() + std::chrono::seconds(5);
+      for (int i = 0; i < connection_count && result; i++)
+      {
+         while (!Socket_Vars::Sockets().Get(pairs[i].client)->Is_Socket_Connected() &&
+                std::chrono::steady_clock::now() < connect_end)
+         {
+            std::this_thread::sleep_for(std::chrono::milliseconds(10));
+         }
+         result &= Socket_Vars::Sockets().Get(pairs[i].client)->Is_Socket_Connected();
+      }
+
+      //
+      // 3. One request in flight per pair, warm up then measure, a UDP
+      //    request unanswered for RECEIVE_TIMEOUT_MS was dropped and is
+      //    sent again so its pair keeps going
+      if (result)
+      {
+         sweep_run->is_running = true;
+         for (Sweep_Pair& pair : pairs)
+         {
+            Send_Request(pair);
+         }
+         std::this_thread::sleep_for(std::chrono::milliseconds(SWEEP_WARMUP_MS));
+         sent = sweep_run->sent.load();
+         received = sweep_run->received.load();
+         sweep_run->round_trips.Reset();
+
+         auto start = std::chrono::steady_clock::now();
+         auto end = start + std::chrono::seconds(SWEEP_SECONDS);
+         while (std::chrono::steady_clock::now() < end)
+         {
+            std::this_thread::sleep_for(std::chrono::milliseconds(10));
+            for (Sweep_Pair& pair : pairs)
+            {
+               if (Socket_Vars::UDP == protocol &&
+                   Now_Nanoseconds() - pair.last_sent_at.load(std::memory_order_relaxed) > RECEIVE_TIMEOUT_MS * 1000000LL)
+               {
+                  Send_Request(pair);
+               }
+            }
+         }
+         seconds = std::chrono::duration<double>(std::chrono::steady_clock::now() - start).count();
+         sent = sweep_run->sent.load() - sent;
+         received = sweep_run->received.load() - received;
+         sweep_run->round_trips.Copy_To(round_trips);
+
+         //
+         // 4. Both directions went through the server, latency is the
+         //    client's round trip in microseconds
+         printf("rtt_sweep,%s,%u,1,%zu,%d,1,%lld,%lld,%.3f,%.0f,%.2f,%.1f,%.1f,%.1f\n",
+            protocol_name, Socket_Vars::event_loop_count, payload_size, connection_count,
+            sent, received, seconds, (sent + received) / seconds,
+            (sent + received) * payload_size / seconds / 1e6,
+            round_trips.Percentile(50.0) / 1000.0,
+            round_trips.Percentile(99.0) / 1000.0,
+            round_trips.Percentile(99.9) / 1000.0);
+      }
+      else
+      {
+         Log::Write<Log::LEVEL_ERROR>("Problem occurred starting the %s sweep with %d connections!\n", protocol_name, connection_count);
+      }
+
+      //
+      // 5. Stop sending, let the last echoes land, then close the pairs
+      sweep_run->is_running = false;
+      std::this_thread::sleep_for(std::chrono::milliseconds(RECEIVE_TIMEOUT_MS));
+      for (Sweep_Pair& pair : pairs)
+      {
+         Socket_Vars::Sockets().Destroy(pair.client);
+         Socket_Vars::Sockets().Destroy(pair.server);
+      }
+      std::this_thread::sleep_for(std::chrono::milliseconds(RECEIVE_TIMEOUT_MS));
+      for (Sweep_Pair& pair : pairs)
+      {
+         if (pair.client.index < sweep_run->pairs.size())
+         {
+            sweep_run->pairs[pair.client.index] = nullptr;
+         }
+      }
+
+      return result;
+   }  // END Run_Sweep()
+
+   //+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+
+   /// @brief   Sweeps payload size, connection count and protocol
+   /// @brief   on event_loop_count event loops, every run on its
+   /// @brief   own ports so none waits out TIME_WAIT
+   /// @return  bool              False if any run failed
+   //+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+
+   bool Run_Round_Trip_Sweep()
+   {
+      bool result = true;
+      const Socket_Vars::Protocol protocols[] = { Socket_Vars::TCP, Socket_Vars::UNIX_STREAM, Socket_Vars::SHARED_MEMORY, Socket_Vars::UDP };
+      uint16_t port = SWEEP_BASE_PORT;
+
+      sweep_run = new Sweep_Run;
+      for (uint16_t loop = 0; loop < Socket_Vars::event_loop_count; loop++)
+      {
+         std::thread(Comms_Interface::Socket_Receiving_Thread, loop).detach();
+         std::thread(Comms_Interface::Socket_Sending_Thread, loop).detach();
+      }
+
+      for (Socket_Vars::Protocol protocol : protocols)
+      {
+         for (size_t payload_size : SWEEP_PAYLOAD_SIZES)
+         {
+            if (Socket_Vars::UDP == protocol && Socket_Vars::UDP_SLOT_SIZE < payload_size)
+            {
+               continue;   // Would not fit in a receive slot
+            }
+            for (int connection_count : SWEEP_CONNECTIONS)
+            {
+               result &= Run_Sweep(protocol, payload_size, connection_count, port);
+               port = static_cast<uint16_t>(port + connection_count);
+            }
+         }
+      }
+
+      // Handlers may still hold it until the process exits
+      return result;
+   }  // END Run_Round_Trip_Sweep()
+
+   //+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+
+   /// @brief   Times every log call made from thread_count threads
+   /// @brief   on the calling thread, through fprintf or the
+   /// @brief   asynchronous log, both written to the null device so
+   /// @brief   the console is not measured, prints one CSV row
+   /// @param   bool              True for the asynchronous log
+   /// @param   int               Threads logging at once
+   /// @return  bool              False if the null device would not open
+   //+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+
+   bool Run_Log_Cost(bool is_async, int thread_count)
+   {
+      FILE* null_file = fopen("NUL", "w");
+      Stats::Latency_Histogram* call_times = new Stats::Latency_Histogram;
+      Stats::Histogram_Snapshot snapshot;
+      std::vector<std::thread> threads;
+      uint64_t dropped;
+      long long calls = static_cast<long long>(thread_count) * LOG_CALLS_PER_THREAD;
+      long long written;
+      double seconds;
+
+      if (nullptr == null_file)
+      {
+         Log::Write<Log::LEVEL_ERROR>("Benchmark fopen() of the null device failed!\n");
+         delete call_times;
+         return false;
+      }
+
+      //
+      // 1. Every thread logs the same line, a number and a text argument
+      Log::Set_Output(null_file);
+      dropped = Log::Get_Dropped();
+      auto start = std::chrono::steady_clock::now();
+      for (int i = 0; i < thread_count; i++)
+      {
+         threads.emplace_back([is_async, null_file, call_times]()
+         {
+            for (int call = 0; call < LOG_CALLS_PER_THREAD; call++)
+            {
+               auto call_start = std::chrono::steady_clock::now();
+               if (is_async)
+               {
+                  Log::Write<Log::LEVEL_INFO>("%s Send() queued message %d\n", LOG_TEXT, call);
+               }
+               else
+               {
+                  fprintf(null_file, "%s Send() queued message %d\n", LOG_TEXT.c_str(), call);
+               }
+               call_times->Record_Since(call_start);
+            }
+         });
+      }
+      for (std::thread& thread : threads)
+      {
+         thread.join();
+      }
+      seconds = std::chrono::duration<double>(std::chrono::steady_clock::now() - start).count();
+
+      //
+      // 2. Everything still on the rings is written before the output
+      //    goes back to stdout, records a full ring turned away are lost
+      Log::Set_Output(nullptr);
+      written = calls - static_cast<long long>(Log::Get_Dropped() - dropped);
+      call_times->Copy_To(snapshot);
+      printf("log_cost,%s,0,1,%zu,%d,0,%lld,%lld,%.3f,%.0f,,%.3f,%.3f,%.3f\n",
+         is_async ? "async_log" : "fprintf", LOG_TEXT.size(), thread_count,
+         calls, written, seconds, calls / seconds,
+         snapshot.Percentile(50.0) / 1000.0,
+         snapshot.Percentile(99.0) / 1000.0,
+         snapshot.Percentile(99.9) / 1000.0);
+
+      fclose(null_file);
+      delete call_times;
+      return true;
+   }  // END Run_Log_Cost()
+
+   //+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+
+   /// @brief   Zero-copy and registered I/O run servers only count
+   /// @brief   what arrives
+   /// @param   Message_Context   Server socket's context
+   /// @param   Received_Message  Message to count
+   /// @return  None
+   //+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+
+   void Count_Handler(Socket_Vars::Message_Context& context, Socket_Vars::Received_Message& received)
+   {
+      if (Socket_Vars::MESSAGE_RECEIVED == received.event)
+      {
+         zero_copy_received.fetch_add(static_cast<long long>(received.message.Size()), std::memory_order_relaxed);
+      }
+   }  // END Count_Handler()
+
+   //+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+
+   /// @brief   Streams messages of one size from a TCP client to a
+   /// @brief   counting server as fast as the send watermarks let
+   /// @brief   it, copied or zero-copy, prints one CSV row
+   /// @param   size_t            Payload bytes of every message
+   /// @param   bool              True to send zero-copy
+   /// @param   uint16_t          Port of the run's server
+   /// @return  bool              False if the pair could not start
+   //+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+
+   bool Run_Zero_Copy(size_t payload_size, bool is_zero_copy, uint16_t port)
+   {
+      bool result = true;
+      std::string name = std::string("Benchmark->") + (is_zero_copy ? "Zero_Copy_" : "Copy_") + std::to_string(payload_size);
+      Socket_Vars::Socket_Handle server = Socket_Vars::Sockets().Create(Socket_Vars::TCP, Socket_Vars::SERVER, LOOPBACK, port, name + "_Server");
+      Socket_Vars::Socket_Handle client = Socket_Vars::Sockets().Create(Socket_Vars::TCP, Socket_Vars::CLIENT, LOOPBACK, port, name + "_Client");
+      long long sent = 0;
+      long long received;
+      double seconds;
+
+      //
+      // 1. Every message of the zero-copy run is over the threshold
+      if (nullptr == Socket_Vars::Sockets().Get(server) || nullptr == Socket_Vars::Sockets().Get(client))
+      {
+         result &= false;
+      }
+      else
+      {
+         Socket_Vars::Sockets().Get(server)->Set_Framing(Framing::FIXED_32, SWEEP_MAX_FRAME_SIZE);
+         Socket_Vars::Sockets().Get(server)->Set_Message_Handler(Count_Handler);
+         Socket_Vars::Sockets().Get(client)->Set_Framing(Framing::FIXED_32, SWEEP_MAX_FRAME_SIZE);
+         Socket_Vars::Sockets().Get(client)->Set_Zero_Copy(is_zero_copy, 1);
+         result &= Socket_Vars::Sockets().Start(server);
+         result &= Socket_Vars::Sockets().Start(client);
+      }
+
+      auto connect_end = std::chrono::steady_clock::now() + std::chrono::seconds(5);
+      while (result && !Socket_Vars::Sockets().Get(client)->Is_Socket_Connected() &&
+             std::chrono::steady_clock::now() < connect_end)
+      {
+         std::this_thread::sleep_for(std::chrono::milliseconds(10));
+      }
+      result = result && Socket_Vars::Sockets().Get(client)->Is_Socket_Connected();
+
+      //
+      // 2. Keep the queue between the watermarks, throughput is what the
+      //    server received
+      if (result)
+      {
+         zero_copy_received = 0;
+         auto start = std::chrono::steady_clock::now();
+         auto end = start + std::chrono::seconds(ZERO_COPY_SECONDS);
+         while (std::chrono::steady_clock::now() < end)
+         {
+            if (Socket_Vars::Is_Send_Throttled(client.index))
+            {
+               std::this_thread::yield();
+               continue;
+            }
+            if (Socket_Vars::Queue_Message(client.index, std::string(payload_size, 'x')))
+            {
+               sent++;
+            }
+         }
+         seconds = std::chrono::duration<double>(std::chrono::steady_clock::now() - start).count();
+         received = zero_copy_received.load() / static_cast<long long>(payload_size);
+
+         printf("zero_copy,%s,%u,1,%zu,1,%zu,%lld,%lld,%.3f,%.0f,%.2f,,,\n",
+            is_zero_copy ? "tcp_zero_copy" : "tcp_copy", Socket_Vars::event_loop_count, payload_size,
+            is_zero_copy ? Socket_Vars::ZERO_COPY_MAX_IN_FLIGHT : size_t{ 0 },
+            sent, received, seconds, received / seconds,
+            zero_copy_received.load() / seconds / 1e6);
+      }
+      else
+      {
+         Log::Write<Log::LEVEL_ERROR>("Problem occurred starting the %s zero-copy run!\n", name);
+      }
+
+      //
+      // 3. Let the last messages land before closing the pair
+      std::this_thread::sleep_for(std::chrono::milliseconds(RECEIVE_TIMEOUT_MS));
+      Socket_Vars::Sockets().Destroy(client);
+      Socket_Vars::Sockets().Destroy(server);
+
+      return result;
+   }  // END Run_Zero_Copy()
+
+   //+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+
+   /// @brief   Streams messages of one size from a TCP client to a
+   /// @brief   counting server, both on the same I/O engine, as fast
+   /// @brief   as the send watermarks let it, prints one CSV row
+   /// @param   size_t            Payload bytes of every message
+   /// @param   IO_Engine         Engine of both the client and the server
+   /// @param   uint16_t          Port of the run's server
+   /// @return  bool              False if the pair could not start
+   //+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+
+   bool Run_Registered_IO(size_t payload_size, Socket_Vars::IO_Engine io_engine, uint16_t port)
+   {
+      bool result = true;
+      bool is_registered = (Socket_Vars::REGISTERED_IO == io_engine);
+      std::string name = std::string("Benchmark->") + (is_registered ? "Registered_IO_" : "Event_Select_") + std::to_string(payload_size);
+      Socket_Vars::Socket_Handle server = Socket_Vars::Sockets().Create(Socket_Vars::TCP, Socket_Vars::SERVER, LOOPBACK, port, name + "_Server");
+      Socket_Vars::Socket_Handle client = Socket_Vars::Sockets().Create(Socket_Vars::TCP, Socket_Vars::CLIENT, LOOPBACK, port, name + "_Client");
+      long long sent = 0;
+      double seconds;
+
+      //
+      // 1. Unframed, the server counts bytes so how the stream is split
+      //    into reads does not matter
+      if (nullptr == Socket_Vars::Sockets().Get(server) || nullptr == Socket_Vars::Sockets().Get(client))
+      {
+         result &= false;
+      }
+      else
+      {
+         Socket_Vars::Sockets().Get(server)->Set_IO_Engine(io_engine);
+         Socket_Vars::Sockets().Get(server)->Set_Message_Handler(Count_Handler);
+         Socket_Vars::Sockets().Get(client)->Set_IO_Engine(io_engine);
+         result &= Socket_Vars::Sockets().Start(server);
+         result &= Socket_Vars::Sockets().Start(client);
+      }
+
+      auto connect_end = std::chrono::steady_clock::now() + std::chrono::seconds(5);
+      while (result && !Socket_Vars::Sockets().Get(client)->Is_Socket_Connected() &&
+             std::chrono::steady_clock::now() < connect_end)
+      {
+         std::this_thread::sleep_for(std::chrono::milliseconds(10));
+      }
+      result = result && Socket_Vars::Sockets().Get(client)->Is_Socket_Connected();
+
+      //
+      // 2. Keep the queue between the watermarks, throughput is what the
+      //    server received
+      if (result)
+      {
+         zero_copy_received = 0;
+         auto start = std::chrono::steady_clock::now();
+         auto end = start + std::chrono::seconds(REGISTERED_IO_SECONDS);
+         while (std::chrono::steady_clock::now() < end)
+         {
+            if (Socket_Vars::Is_Send_Throttled(client.index))
+            {
+               std::this_thread::yield();
+               continue;
+            }
+            if (Socket_Vars::Queue_Message(client.index, std::string(payload_size, 'x')))
+            {
+               sent++;
+            }
+         }
+         seconds = std::chrono::duration<double>(std::chrono::steady_clock::now() - start).count();
+         long long received = zero_copy_received.load() / static_cast<long long>(payload_size);
+
+         printf("registered_io,%s,%u,1,%zu,1,,%lld,%lld,%.3f,%.0f,%.2f,,,\n",
+            is_registered ? "tcp_registered_io" : "tcp_event_select", Socket_Vars::event_loop_count, payload_size,
+            sent, received, seconds, received / seconds,
+            zero_copy_received.load() / seconds / 1e6);
+      }
+      else
+      {
+         Log::Write<Log::LEVEL_ERROR>("Problem occurred starting the %s registered I/O run!\n", name);
+      }
+
+      //
+      // 3. Let the last messages land before closing the pair
+      std::this_thread::sleep_for(std::chrono::milliseconds(RECEIVE_TIMEOUT_MS));
+      Socket_Vars::Sockets().Destroy(client);
+      Socket_Vars::Sockets().Destroy(server);
+
+      return result;
+   }  // END Run_Registered_IO()
+
+   //+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+
+   /// @brief   Times every push of a pooled send buffer from
+   /// @brief   producer_count threads to one consumer popping a
+   /// @brief   batch at a time, the way a send queue is used,
+   /// @brief   prints one CSV row
+   /// @param   Queue_Kind        Queue the producers push on
+   /// @param   int               Threads pushing at once
+   /// @return  bool              True, every push is retried until it fits
+   //+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+
+   bool Run_Queue_Contention(Queue_Kind kind, int producer_count)
+   {
+      static const char* KIND_NAMES[] = { "mpsc", "spsc", "mutex_queue" };
+      Lock_Free::MPSC_Queue<Buffers::Buffer_View> mpsc_queue;
+      std::unique_ptr<Lock_Free::SPSC_Queue<Buffers::Buffer_View>[]> spsc_queues;
+      std::mutex queue_mutex;
+      std::deque<Buffers::Buffer_View> mutex_queue;
+      Buffers::Buffer_View batch[Socket_Vars::SEND_BATCH_SIZE];
+      Stats::Latency_Histogram* push_times = new Stats::Latency_Histogram;
+      Stats::Histogram_Snapshot snapshot;
+      std::vector<std::thread> producers;
+      const std::string payload(QUEUE_PAYLOAD_SIZE, 'x');
+      long long sent = static_cast<long long>(producer_count) * QUEUE_MESSAGES_PER_PRODUCER;
+      long long received = 0;
+      size_t count;
+      size_t next_queue = 0;
+      double seconds;
+
+      //
+      // 1. One ring shared by every producer, or one ring each
+      if (MPSC_QUEUE == kind)
+      {
+         mpsc_queue.Initialize(QUEUE_CAPACITY);
+      }
+      else if (SPSC_QUEUES == kind)
+      {
+         spsc_queues.reset(new Lock_Free::SPSC_Queue<Buffers::Buffer_View>[producer_count]);
+         for (int i = 0; i < producer_count; i++)
+         {
+            spsc_queues[i].Initialize(QUEUE_CAPACITY);
+         }
+      }
+
+      //
+      // 2. Every producer copies the payload into a send buffer and pushes
+      //    it, a full queue is waited on and counted in the push's time
+      auto start = std::chrono::steady_clock::now();
+      for (int i = 0; i < producer_count; i++)
+      {
+         producers.emplace_back([&, i]()
+         {
+            for (int message = 0; message < QUEUE_MESSAGES_PER_PRODUCER; message++)
+            {
+               auto push_start = std::chrono::steady_clock::now();
+               Buffers::Buffer_View buffer = Buffers::Copy_To_Send_Pool(payload.data(), payload.size());
+               bool is_pushed = false;
+               while (!is_pushed)
+               {
+                  if (MPSC_QUEUE == kind)
+                  {
+                     is_pushed = mpsc_queue.Push_Batch(&buffer, 1);
+                  }
+                  else if (SPSC_QUEUES == kind)
+                  {
+                     is_pushed = (1 == spsc_queues[i].Push_Batch(&buffer, 1));
+                  }
+                  else
+                  {
+                     std::lock_guard<std::mutex> lock(queue_mutex);
+                     if (mutex_queue.size() < QUEUE_CAPACITY)
+                     {
+                        mutex_queue.push_back(std::move(buffer));
+                        is_pushed = true;
+                     }
+                  }
+                  if (!is_pushed)
+                  {
+                     std::this_thread::yield();
+                  }
+               }
+               push_times->Record_Since(push_start);
+            }
+         });
+      }
+
+      //
+      // 3. This thread pops a batch at a time and lets go of every buffer,
+      //    as a sending thread does once the batch is written
+      while (received < sent)
+      {
+         count = 0;
+         if (MPSC_QUEUE == kind)
+         {
+            count = mpsc_queue.Pop_Batch(batch, Socket_Vars::SEND_BATCH_SIZE);
+         }
+         else if (SPSC_QUEUES == kind)
+         {
+            count = spsc_queues[next_queue].Pop_Batch(batch, Socket_Vars::SEND_BATCH_SIZE);
+            next_queue = (next_queue + 1) % static_cast<size_t>(producer_count);
+         }
+         else
+         {
+            std::lock_guard<std::mutex> lock(queue_mutex);
+            while (count < Socket_Vars::SEND_BATCH_SIZE && !mutex_queue.empty())
+            {
+               batch[count++] = std::move(mutex_queue.front());
+               mutex_queue.pop_front();
+            }
+         }
+         for (size_t k = 0; k < count; k++)
+         {
+            batch[k].Reset();
+         }
+         received += count;
+         if (0 == count)
+         {
+            std::this_thread::yield();
+         }
+      }
+      for (std::thread& producer : producers)
+      {
+         producer.join();
+      }
+      seconds = std::chrono::duration<double>(std::chrono::steady_clock::now() - start).count();
+
+      push_times->Copy_To(snapshot);
+      printf("queue_contention,%s,0,%zu,%zu,%d,%zu,%lld,%lld,%.3f,%.0f,%.2f,%.3f,%.3f,%.3f\n",
+         KIND_NAMES[kind], Socket_Vars::SEND_BATCH_SIZE, QUEUE_PAYLOAD_SIZE, producer_count, QUEUE_CAPACITY,
+         sent, received, seconds, received / seconds,
+         received * QUEUE_PAYLOAD_SIZE / seconds / 1e6,
+         snapshot.Percentile(50.0) / 1000.0,
+         snapshot.Percentile(99.0) / 1000.0,
+         snapshot.Percentile(99.9) / 1000.0);
+
+      delete push_times;
+      return true;
+   }  // END Run_Queue_Contention()
+
+   //+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+
+   /// @brief   Address of a multicast run's group, administratively
+   /// @brief   scoped for IPv4 and site-local for IPv6
+   /// @param   bool              True for an IPv6 group
+   /// @param   int               Index of the group, under MULTICAST_MAX_GROUPS
+   /// @return  std::string       Group address
+   //+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+
+   std::string Group_Address(bool is_ipv6, int index)
+   {
+      return (is_ipv6 ? "ff15::" : "239.255.0.") + std::to_string(index + 1);
+   }  // END Group_Address()
+
+   //+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+
+   /// @brief   Multicast receivers check every datagram was handed
+   /// @brief   up with the group it was sent to
+   /// @param   Message_Context   Receiver's context
+   /// @param   Received_Message  Datagram and the group it arrived on
+   /// @return  None
+   //+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+
+   void Multicast_Handler(Socket_Vars::Message_Context& context, Socket_Vars::Received_Message& received)
+   {
+      uint32_t index;
+
+      if (Socket_Vars::MESSAGE_RECEIVED != received.event || sizeof(index) > received.message.Size())
+      {
+         return;
+      }
+      memcpy(&index, received.message.Data(), sizeof(index));
+      if (multicast_run.group_count.load(std::memory_order_acquire) <= index)
+      {
+         return;   // Left over from the last run
+      }
+      if (received.group == multicast_run.group_ids[index])
+      {
+         multicast_run.received_by_group[index].fetch_add(1, std::memory_order_relaxed);
+      }
+      else
+      {
+         multicast_run.misrouted.fetch_add(1, std::memory_order_relaxed);
+      }
+      multicast_run.received.fetch_add(1, std::memory_order_relaxed);
+   }  // END Multicast_Handler()
+
+   //+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+
+   /// @brief   One receiving socket joins group_count groups looped
+   /// @brief   back on this host, one sending socket per group
+   /// @brief   sends to it in turn, fails if any datagram came up
+   /// @brief   with the wrong group or a group received nothing,
+   /// @brief   prints one CSV row
+   /// @param   bool              True for IPv6 groups
+   /// @param   int               Groups, up to MULTICAST_MAX_GROUPS
+   /// @param   uint16_t          Port every socket of the run binds
+   /// @return  bool              False if the run could not start or misrouted
+   //+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+
+   bool Run_Multicast(bool is_ipv6, int group_count, uint16_t port)
+   {
+      bool result = true;
+      std::string name = std::string("Benchmark->Multicast_") + (is_ipv6 ? "IPv6_" : "IPv4_") + std::to_string(group_count);
+      std::vector<Socket_Vars::Socket_Handle> senders(group_count);
+      Socket_Vars::Socket_Handle receiver;
+      std::string payload(MULTICAST_PAYLOAD_SIZE, 'x');
+      uint32_t index = 0;
+      long long sent = 0;
+      long long lost = 0;
+      long long received = 0;
+      long long last_received = 0;
+      int silent_groups = 0;
+      double seconds;
+
+      multicast_run.group_count = 0;
+      multicast_run.received = 0;
+      multicast_run.misrouted = 0;
+
+      //
+      // 1. The receiver joins every group before it starts, each sender's
+      //    address is its group so it sends there without joining, and
+      //    every socket shares the one port
+      receiver = Socket_Vars::Sockets().Create(Socket_Vars::UDP, Socket_Vars::SERVER, Group_Address(is_ipv6, 0), port, name + "_Receiver");
+      if (nullptr == Socket_Vars::Sockets().Get(receiver))
+      {
+         Log::Write<Log::LEVEL_ERROR>("Problem occurred creating the %s receiver!\n", name);
+         return false;
+      }
+      for (int i = 0; i < group_count; i++)
+      {
+         multicast_run.group_ids[i] = Socket_Vars::Sockets().Get(receiver)->Join_Group(Group_Address(is_ipv6, i));
+         multicast_run.received_by_group[i] = 0;
+         result &= (Socket_Vars::NO_GROUP != multicast_run.group_ids[i]);
+      }
+      multicast_run.group_count.store(static_cast<uint32_t>(group_count), std::memory_order_release);
+      Socket_Vars::Sockets().Get(receiver)->Set_Message_Handler(Multicast_Handler);
+      Socket_Vars::Sockets().Get(receiver)->Set_UDP_Batch_Size(MULTICAST_BATCH_SIZE);
+      result &= Socket_Vars::Sockets().Start(receiver);
+      for (int i = 0; i < group_count && result; i++)
+      {
+         senders[i] = Socket_Vars::Sockets().Create(Socket_Vars::UDP, Socket_Vars::CLIENT, Group_Address(is_ipv6, i), port, name + "_Sender_" + std::to_string(i));
+         if (nullptr == Socket_Vars::Sockets().Get(senders[i]))
+         {
+            result &= false;
+            break;
+         }
+         Socket_Vars::Sockets().Get(senders[i])->Set_Multicast_Options(0, Socket_Vars::MULTICAST_TTL, true);
+         result &= Socket_Vars::Sockets().Start(senders[i]);
+      }
+
+      //
+      // 2. Send round the groups with at most WINDOW datagrams unreceived,
+      //    what has not arrived after RECEIVE_TIMEOUT_MS without progress
+      //    was dropped and is counted lost so sending goes on
+      if (result)
+      {
+         auto start = std::chrono::steady_clock::now();
+         auto end = start + std::chrono::seconds(MULTICAST_SECONDS);
+         auto last_progress = start;
+         while (std::chrono::steady_clock::now() < end)
+         {
+            received = multicast_run.received.load(std::memory_order_relaxed);
+            if (received != last_received)
+            {
+               last_received = received;
+               last_progress = std::chrono::steady_clock::now();
+            }
+            if (WINDOW <= sent - received - lost)
+            {
+               if (std::chrono::steady_clock::now() - last_progress > std::chrono::milliseconds(RECEIVE_TIMEOUT_MS))
+               {
+                  lost = sent - received;
+                  last_progress = std::chrono::steady_clock::now();
+               }
+               std::this_thread::yield();
+               continue;
+            }
+            memcpy(&payload[0], &index, sizeof(index));
+            if (Socket_Vars::Queue_Message(senders[index].index, payload))
+            {
+               sent++;
+            }
+            index = (index + 1) % static_cast<uint32_t>(group_count);
+         }
+         seconds = std::chrono::duration<double>(std::chrono::steady_clock::now() - start).count();
+         std::this_thread::sleep_for(std::chrono::milliseconds(RECEIVE_TIMEOUT_MS));
+         received = multicast_run.received.load();
+
+         //
+         // 3. Only the receiver's side is counted, every group must have
+         //    been told apart from the others on the one socket
+         printf("multicast,%s,%u,%u,%zu,%d,%d,%lld,%lld,%.3f,%.0f,%.2f,,,\n",
+            is_ipv6 ? "UDP6" : "UDP", Socket_Vars::event_loop_count, MULTICAST_BATCH_SIZE, MULTICAST_PAYLOAD_SIZE,
+            group_count, WINDOW, sent, received, seconds, received / seconds,
+            received * MULTICAST_PAYLOAD_SIZE / seconds / 1e6);
+         for (int i = 0; i < group_count; i++)
+         {
+            silent_groups += (0 == multicast_run.received_by_group[i].load()) ? 1 : 0;
+         }
+         if (0 < multicast_run.misrouted.load() || 0 < silent_groups)
+         {
+            Log::Write<Log::LEVEL_ERROR>("%s handed up %lld datagrams with the wrong group, %d groups received nothing!\n",
+               name, multicast_run.misrouted.load(), silent_groups);
+            result &= false;
+         }
+      }
+      else
+      {
+         Log::Write<Log::LEVEL_ERROR>("Problem occurred starting the %s run!\n", name);
+      }
+
+      //
+      // 4. Leave every group, then close the run's sockets
+      multicast_run.group_count = 0;
+      for (int i = 0; i < group_count; i++)
+      {
+         if (Socket_Vars::NO_GROUP != multicast_run.group_ids[i])
+         {
+            Socket_Vars::Sockets().Get(receiver)->Leave_Group(multicast_run.group_ids[i]);
+         }
+      }
+      for (Socket_Vars::Socket_Handle& sender : senders)
+      {
+         Socket_Vars::Sockets().Destroy(sender);
+      }
+      Socket_Vars::Sockets().Destroy(receiver);
+
+      return result;
+   }  // END Run_Multicast()
+
+   //+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+
+   /// @brief   Runs this program again as a child in the mode given
+   /// @param   std::string       SCALING_MODE or SWEEP_MODE
+   /// @param   uint16_t          Event loops the child runs
+   /// @return  bool              False if the child failed
+   //+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+
+   bool Spawn_Child(const std::string& mode, uint16_t loops)
+   {
+      char path[MAX_PATH];
+      std::string command;
+      STARTUPINFOA startup_info{};
+      PROCESS_INFORMATION process_info{};
+      DWORD exit_code = EXIT_FAILURE;
+
+      //
+      // 1. The child writes its row to the same console, flush ours first
+      //    so rows stay in order
+      Log::Flush();
+      fflush(stdout);
+      GetModuleFileNameA(nullptr, path, MAX_PATH);
+      command = "\"" + std::string(path) + "\" " + mode + " " + std::to_string(loops);
+      startup_info.cb = sizeof(startup_info);
+      if (!CreateProcessA(nullptr, &command[0], nullptr, nullptr, FALSE, 0, nullptr, nullptr, &startup_info, &process_info))
+      {
+         Log::Write<Log::LEVEL_ERROR>("Benchmark CreateProcess() failed with: %u\n", GetLastError());
+         return false;
+      }
+
+      //
+      // 2. Wait for its rows before the next child starts
+      WaitForSingleObject(process_info.hProcess, INFINITE);
+      GetExitCodeProcess(process_info.hProcess, &exit_code);
+      CloseHandle(process_info.hThread);
+      CloseHandle(process_info.hProcess);
+
+      return EXIT_SUCCESS == exit_code;
+   }  // END Spawn_Child()
+
+}  // END namespace Benchmark
+
+//+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+
+/// Entry point for the Benchmark project
+//+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+
+int main(int argc, char* argv[])
+{
+   bool result = true;
+   const Benchmark::Server_Case servers[] = { { 9100, 1 }, { 9101, 64 } };
+   const size_t payload_sizes[] = { 16, 64, 512, 1024 };
+   unsigned int hardware_threads = std::thread::hardware_concurrency();
+   uint16_t max_loops;
+
+   // Printing every message would measure the console instead
+   Socket_Vars::print_messages = false;
+
+   // Event loops go up to one per hardware thread, the handler pool
+   // always has one worker per hardware thread
+   max_loops = static_cast<uint16_t>(
+      (0 == hardware_threads) ? 1 :
+      (Socket_Vars::MAX_EVENT_LOOPS < hardware_threads) ? Socket_Vars::MAX_EVENT_LOOPS : hardware_threads);
+   Work_Pool::Handler_Pool().Start(max_loops);
+
+   //
+   // 0. A child process runs one TCP server, or the round trip sweep, at
+   //    the event loop count given
+   if (3 == argc && Benchmark::SCALING_MODE == argv[1])
+   {
+      Socket_Vars::event_loop_count = static_cast<uint16_t>(atoi(argv[2]));
+      result &= Benchmark::Run_TCP_Scaling();
+      Log::Flush();
+      return result ? EXIT_SUCCESS : EXIT_FAILURE;
+   }
+   if (3 == argc && Benchmark::SWEEP_MODE == argv[1])
+   {
+      Socket_Vars::event_loop_count = static_cast<uint16_t>(atoi(argv[2]));
+      result &= Benchmark::Run_Round_Trip_Sweep();
+      Log::Flush();
+      return result ? EXIT_SUCCESS : EXIT_FAILURE;
+   }
+
+   //
+   // 1. One echo server per batch size, unbatched first as the baseline
+   for (const Benchmark::Server_Case& server : servers)
+   {
+      Socket_Vars::Socket_Handle handle = Socket_Vars::Sockets().Create
+      (
+         Socket_Vars::UDP,
+         Socket_Vars::SERVER,
+         Benchmark::LOOPBACK,
+         server.port,
+         "Benchmark->UDP_Batch_" + std::to_string(server.batch_size)
+      );
+      if (nullptr == Socket_Vars::Sockets().Get(handle))
+      {
+         result &= false;
+         continue;
+      }
+      Socket_Vars::Sockets().Get(handle)->Set_UDP_Batch_Size(server.batch_size);
+      result &= Socket_Vars::Sockets().Start(handle);
+   }
+   if (!result)
+   {
+      Log::Write<Log::LEVEL_ERROR>("Problem occurred starting the benchmark servers!\n");
+      Log::Flush();
+      return EXIT_FAILURE;
+   }
+
+   //
+   // 2. The socket threads run for the life of the program, the UDP
+   //    servers run on the one default event loop
+   std::thread(Comms_Interface::Socket_Receiving_Thread, 0).detach();
+   std::thread(Comms_Interface::Socket_Sending_Thread, 0).detach();
+
+   //
+   // 3. Every payload size against every server
+   printf("test,protocol,event_loops,batch,payload_bytes,connections,window,sent,received,seconds,messages_per_second,megabytes_per_second,p50_us,p99_us,p999_us\n");
+   for (const Benchmark::Server_Case& server : servers)
+   {
+      for (size_t payload_size : payload_sizes)
+      {
+         result &= Benchmark::Run_UDP(server, payload_size);
+      }
+   }
+
+   //
+   // 4. The TCP server on 1, 2, 4 and so on event loops up to one per
+   //    hardware thread, each in its own process
+   for (uint16_t loops = 1; loops <= max_loops; loops *= 2)
+   {
+      result &= Benchmark::Spawn_Child(Benchmark::SCALING_MODE, loops);
+      if (loops < max_loops && max_loops < loops * 2)
+      {
+         result &= Benchmark::Spawn_Child(Benchmark::SCALING_MODE, max_loops);
+      }
+   }
+
+   //
+   // 5. What a log call costs the thread making it, against fprintf
+   for (int thread_count : Benchmark::LOG_THREADS)
+   {
+      result &= Benchmark::Run_Log_Cost(false, thread_count);
+      result &= Benchmark::Run_Log_Cost(true, thread_count);
+   }
+
+   //
+   // 6. TCP sends copied into the socket buffer against zero-copy, from
+   //    below the threshold to well past it
+   uint16_t zero_copy_port = Benchmark::ZERO_COPY_BASE_PORT;
+   for (size_t payload_size : Benchmark::ZERO_COPY_SIZES)
+   {
+      result &= Benchmark::Run_Zero_Copy(payload_size, false, zero_copy_port++);
+      result &= Benchmark::Run_Zero_Copy(payload_size, true, zero_copy_port++);
+   }
+
+   //
+   // 7. Multicast groups looped back to one receiving socket, IPv4 and
+   //    IPv6, every datagram must come up with the group it was sent to
+   uint16_t multicast_port = Benchmark::MULTICAST_BASE_PORT;
+   for (int group_count : Benchmark::MULTICAST_GROUPS)
+   {
+      result &= Benchmark::Run_Multicast(false, group_count, multicast_port++);
+      result &= Benchmark::Run_Multicast(true, group_count, multicast_port++);
+   }
+
+   //
+   // 8. TCP streams on Registered I/O against the same on EVENT_SELECT,
+   //    sizes up to a registered send slot
+   uint16_t registered_io_port = Benchmark::REGISTERED_IO_BASE_PORT;
+   for (size_t payload_size : Benchmark::REGISTERED_IO_SIZES)
+   {
+      result &= Benchmark::Run_Registered_IO(payload_size, Socket_Vars::EVENT_SELECT, registered_io_port++);
+      result &= Benchmark::Run_Registered_IO(payload_size, Socket_Vars::REGISTERED_IO, registered_io_port++);
+   }
+
+   //
+   // 9. Producers pushing pooled send buffers at once, one shared lock
+   //    free ring and a ring each against a mutex guarded deque
+   for (int producer_count : Benchmark::QUEUE_PRODUCERS)
+   {
+      result &= Benchmark::Run_Queue_Contention(Benchmark::MPSC_QUEUE, producer_count);
+      result &= Benchmark::Run_Queue_Contention(Benchmark::SPSC_QUEUES, producer_count);
+      result &= Benchmark::Run_Queue_Contention(Benchmark::MUTEX_QUEUE, producer_count);
+   }
+
+   //
+   // 10. Round trips across payload sizes, connections and protocols on
+   //     every event loop
+   result &= Benchmark::Spawn_Child(Benchmark::SWEEP_MODE, max_loops);
+
+   Log::Flush();
+   return result ? EXIT_SUCCESS : EXIT_FAILURE;
+}  // END main()
@@ -0,0 +1,117 @@
+//+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+
+// 
+//  ___________ __  .__                       ___________
+//  \_   _____//  |_|  |__ _____    ____      \_   _____/
+//   |    __)_\   __\  |  \\__  \  /    \      |    __)_ 
+//   |        \|  | |   Y  \/ __ \|   |  \     |        \
+//  /_______  /|__| |___|  (____  /___|  / /\ /_______  /
+//          \/           \/     \/     \/  \/         \/ 
+// 
+// Async Task Implementation File
+//
+//  Author   Date         Description
+// --------------------------------------------------------
+//  ECE      10-17-2026   Initial Implementation
+//  ECE      10-17-2026   Messages go to the asynchronous log
+//+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+
+
+#include "Async_Task.h"
+#include "Socket_Log.h"
+
+#include <exception>
+#include <new>
+
+namespace Async
+{
+   constexpr size_t FRAME_CLASS_COUNT{ MAX_POOLED_FRAME_SIZE / FRAME_SIZE_STEP };
+
+   // A free frame links to the next one through its own first bytes
+   struct Free_Frame
+   {
+      Free_Frame* next;
+   };
+
+   // Free frames of each size class, per thread so no lock is taken,
+   // the memory goes back to the heap when the thread exits
+   struct Frame_Cache
+   {
+      Free_Frame* frames[FRAME_CLASS_COUNT] = {};
+      size_t counts[FRAME_CLASS_COUNT] = {};
+
+      ~Frame_Cache()
+      {
+         for (size_t i = 0; i < FRAME_CLASS_COUNT; i++)
+         {
+            while (nullptr != frames[i])
+            {
+               Free_Frame* frame = frames[i];
+               frames[i] = frame->next;
+               ::operator delete(frame);
+            }
+         }
+      }
+   };
+
+   static thread_local Frame_Cache frame_cache;
+
+   //+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+
+   /// Takes a coroutine frame
+   //+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+
+   void* Allocate_Frame(size_t size)
+   {
+      size_t size_class = (size - 1) / FRAME_SIZE_STEP;
+      Free_Frame* frame;
+
+      //
+      // 1. Too big to pool
+      if (FRAME_CLASS_COUNT <= size_class)
+      {
+         return ::operator new(size);
+      }
+
+      //
+      // 2. Reuse a frame of the same class, otherwise allocate the whole
+      //    class size so the frame can later serve any size in the class
+      frame = frame_cache.frames[size_class];
+      if (nullptr == frame)
+      {
+         return ::operator new((size_class + 1) * FRAME_SIZE_STEP);
+      }
+      frame_cache.frames[size_class] = frame->next;
+      frame_cache.counts[size_class]--;
+
+      return frame;
+   }  // END Allocate_Frame()
+
+   //+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+
+   /// Returns a coroutine frame
+   //+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+
+   void Release_Frame(void* frame, size_t size)
+   {
+      size_t size_class = (size - 1) / FRAME_SIZE_STEP;
+      Free_Frame* free_frame;
+
+      // A full cache hands the frame back to the heap rather than
+      // hoarding frames moved here from other threads
+      if (FRAME_CLASS_COUNT <= size_class || FRAMES_CACHED_PER_CLASS <= frame_cache.counts[size_class])
+      {
+         ::operator delete(frame);
+         return;
+      }
+
+      free_frame = static_cast<Free_Frame*>(frame);
+      free_frame->next = frame_cache.frames[size_class];
+      frame_cache.frames[size_class] = free_frame;
+      frame_cache.counts[size_class]++;
+   }  // END Release_Frame()
+
+   //+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+
+   /// A coroutine let an exception escape, nothing can catch it
+   //+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+
+   void Task::promise_type::unhandled_exception()
+   {
+      Log::Write<Log::LEVEL_ERROR>("ERROR, exception escaped an Async::Task!\n");
+      std::terminate();
+   }  // END unhandled_exception()
+
+}  // END namespace Async
@@ -0,0 +1,217 @@
+//+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+
+// 
+//  ___________ __  .__                       ___________
+//  \_   _____//  |_|  |__ _____    ____      \_   _____/
+//   |    __)_\   __\  |  \\__  \  /    \      |    __)_ 
+//   |        \|  | |   Y  \/ __ \|   |  \     |        \
+//  /_______  /|__| |___|  (____  /___|  / /\ /_______  /
+//          \/           \/     \/     \/  \/         \/ 
+// 
+// Async Task Header File
+//
+//  Author   Date         Description
+// --------------------------------------------------------
+//  ECE      10-17-2026   Initial Implementation
+//+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+
+
+#pragma once
+
+#include "Work_Pool.h"
+
+#include <coroutine>
+#include <cstddef>
+#include <deque>
+#include <mutex>
+#include <utility>
+
+namespace Async
+{
+   // Coroutine frames are recycled in size classes of this many bytes
+   constexpr size_t FRAME_SIZE_STEP{ 128 };
+
+   // Largest recycled frame, bigger frames come from the heap every time
+   constexpr size_t MAX_POOLED_FRAME_SIZE{ 4096 };
+
+   // Most free frames each thread keeps per size class
+   constexpr size_t FRAMES_CACHED_PER_CLASS{ 256 };
+
+   //+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+
+   /// @brief   Takes a coroutine frame from the calling thread's
+   /// @brief   free list of its size class, or the heap
+   /// @param   size_t            Bytes the frame needs
+   /// @return  void*             Frame
+   //+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+
+   void* Allocate_Frame(size_t size);
+
+   //+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+
+   /// @brief   Returns a coroutine frame to the calling thread's
+   /// @brief   free list, a frame may be freed on any thread
+   /// @param   void*             Frame from Allocate_Frame()
+   /// @param   size_t            Size it was allocated with
+   /// @return  None
+   //+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+
+   void Release_Frame(void* frame, size_t size);
+
+   //+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+
+   /// @brief   Return type of a coroutine that runs on its own,
+   /// @brief   it starts at once and its frame is recycled when
+   /// @brief   it finishes, nothing waits on it
+   //+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+
+   class Task
+   {
+   public:
+
+      struct promise_type
+      {
+         Task get_return_object() { return Task(); }
+         std::suspend_never initial_suspend() noexcept { return {}; }
+         std::suspend_never final_suspend() noexcept { return {}; }
+         void return_void() {}
+         void unhandled_exception();
+
+         static void* operator new(size_t size) { return Allocate_Frame(size); }
+         static void operator delete(void* frame, size_t size) { Release_Frame(frame, size); }
+      };
+
+   };  // END class Task
+
+   //+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+
+   /// @brief   Awaitable that moves the rest of the coroutine
+   /// @brief   onto the handler pool
+   //+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+
+   class Resume_On_Pool : public Work_Pool::Task
+   {
+   public:
+
+      bool await_ready() { return false; }
+      void await_suspend(std::coroutine_handle<> handle)
+      {
+         _handle = handle;
+         Work_Pool::Handler_Pool().Submit(this);
+      }
+      void await_resume() {}
+
+      void Run() override { _handle.resume(); }
+
+   private:
+
+      std::coroutine_handle<> _handle;
+
+   };  // END class Resume_On_Pool
+
+   //+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+
+   /// @brief   Unbounded list of items one coroutine awaits at a
+   /// @brief   time, the awaiting coroutine is resumed on the
+   /// @brief   handler pool when an item is delivered
+   //+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+
+   template <typename T>
+   class Channel
+   {
+   public:
+
+      //+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+
+      /// @brief   co_await of Receive(), completes at once when an
+      /// @brief   item is already waiting
+      //+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+
+      class Awaiter : public Work_Pool::Task
+      {
+      public:
+
+         explicit Awaiter(Channel& channel) : _channel(channel) {}
+
+         bool await_ready() { return _channel.Try_Take(_item); }
+         bool await_suspend(std::coroutine_handle<> handle)
+         {
+            _handle = handle;
+            return _channel.Wait(this);
+         }
+         T await_resume() { return std::move(_item); }
+
+         void Run() override { _handle.resume(); }
+
+      private:
+
+         friend class Channel;
+
+         Channel& _channel;
+         T _item;
+         std::coroutine_handle<> _handle;
+
+      };  // END class Awaiter
+
+      //+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+
+      /// @brief   Awaits the next item
+      /// @return  Awaiter           co_await it for the item
+      //+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+
+      Awaiter Receive() { return Awaiter(*this); }
+
+      //+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+
+      /// @brief   Hands an item to the waiting coroutine, or keeps
+      /// @brief   it until one awaits, safe from any thread
+      /// @param   T                 Item, moved into the channel
+      /// @return  None
+      //+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+
+      void Deliver(T item)
+      {
+         Awaiter* waiter = nullptr;
+         {
+            std::lock_guard<std::mutex> lock(_lock);
+            if (nullptr == _waiter)
+            {
+               _items.push_back(std::move(item));
+               return;
+            }
+            waiter = _waiter;
+            _waiter = nullptr;
+            waiter->_item = std::move(item);
+         }
+         Work_Pool::Handler_Pool().Submit(waiter);
+      }
+
+      //+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+
+      /// @brief   Drops every item nobody took, a waiting coroutine
+      /// @brief   keeps waiting
+      /// @return  None
+      //+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+
+      void Clear()
+      {
+         std::lock_guard<std::mutex> lock(_lock);
+         _items.clear();
+      }
+
+   private:
+
+      std::mutex _lock;
+      std::deque<T> _items;
+      Awaiter* _waiter = nullptr;
+
+      bool Try_Take(T& item)
+      {
+         std::lock_guard<std::mutex> lock(_lock);
+         if (_items.empty())
+         {
+            return false;
+         }
+         item = std::move(_items.front());
+         _items.pop_front();
+         return true;
+      }
+
+      // Parks the awaiter, or hands it an item delivered since
+      // await_ready() and tells the coroutine not to suspend
+      bool Wait(Awaiter* waiter)
+      {
+         std::lock_guard<std::mutex> lock(_lock);
+         if (!_items.empty())
+         {
+            waiter->_item = std::move(_items.front());
+            _items.pop_front();
+            return false;
+         }
+         _waiter = waiter;
+         return true;
+      }
+
+   };  // END class Channel
+
+}  // END namespace Async
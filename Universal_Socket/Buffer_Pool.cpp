@@ -0,0 +1,304 @@
+//+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+
+// 
+//  ___________ __  .__                       ___________
+//  \_   _____//  |_|  |__ _____    ____      \_   _____/
+//   |    __)_\   __\  |  \\__  \  /    \      |    __)_ 
+//   |        \|  | |   Y  \/ __ \|   |  \     |        \
+//  /_______  /|__| |___|  (____  /___|  / /\ /_______  /
+//          \/           \/     \/     \/  \/         \/ 
+// 
+// Buffer Pool Implementation File
+//
+//  Author   Date         Description
+// --------------------------------------------------------
+//  ECE      10-17-2026   Initial Implementation
+//  ECE      10-17-2026   Added the broadcast pool
+//  ECE      10-17-2026   Added the send pool queued messages are copied into
+//+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+
+
+#include "Buffer_Pool.h"
+
+#include <cstring>
+#include <new>
+
+namespace Buffers
+{
+   //+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+
+   /// Rounds a size up to whole cache lines
+   //+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+
+   static size_t Round_To_Cache_Line(size_t size)
+   {
+      return (size + Lock_Free::CACHE_LINE_SIZE - 1) & ~(Lock_Free::CACHE_LINE_SIZE - 1);
+   }  // END Round_To_Cache_Line()
+
+   //+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+
+   /// Pool every socket receives into
+   //+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+
+   Buffer_Pool& Receive_Pool()
+   {
+      static Buffer_Pool pool(RECEIVE_BUFFER_SIZE, RECEIVE_BUFFER_COUNT);
+      return pool;
+   }  // END Receive_Pool()
+
+   //+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+
+   /// Pool broadcasts are framed into
+   //+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+
+   Buffer_Pool& Broadcast_Pool()
+   {
+      static Buffer_Pool pool(BROADCAST_BUFFER_SIZE, BROADCAST_BUFFER_COUNT);
+      return pool;
+   }  // END Broadcast_Pool()
+
+   //+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+
+   /// Pool queued messages are copied into
+   //+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+
+   Buffer_Pool& Send_Pool()
+   {
+      static Buffer_Pool pool(SEND_BUFFER_SIZE, SEND_BUFFER_COUNT);
+      return pool;
+   }  // END Send_Pool()
+
+   //+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+
+   /// Copies a message into a send pool buffer
+   //+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+
+   Buffer_View Copy_To_Send_Pool(const char* data, size_t length)
+   {
+      Buffer_View buffer = Send_Pool().Acquire(length);
+
+      if (0 < length)
+      {
+         memcpy(buffer.Get_Buffer(), data, length);
+      }
+      return buffer.Slice(0, length);
+   }  // END Copy_To_Send_Pool()
+
+   //-+-+-+-+-+-+-+-+-+-+-+Buffer_View FUNCTIONS+-+-+-+-+-+-+-+-+-+-+-+-+
+
+   //+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+
+   /// Constructors
+   //+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+
+   Buffer_View::Buffer_View()
+      : _header(nullptr), _data(nullptr), _size(0)
+   {
+   }
+
+   Buffer_View::Buffer_View(Buffer_Header* header)
+      : _header(header), _data(reinterpret_cast<const char*>(header + 1)), _size(header->capacity)
+   {
+      _header->references.store(1, std::memory_order_relaxed);
+   }
+
+   Buffer_View::Buffer_View(const Buffer_View& other)
+      : _header(other._header), _data(other._data), _size(other._size)
+   {
+      if (nullptr != _header)
+      {
+         _header->references.fetch_add(1, std::memory_order_relaxed);
+      }
+   }
+
+   Buffer_View::Buffer_View(Buffer_View&& other) noexcept
+      : _header(other._header), _data(other._data), _size(other._size)
+   {
+      other._header = nullptr;
+      other._data = nullptr;
+      other._size = 0;
+   }  // END Constructors
+
+   //+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+
+   /// Assignment, the old buffer is released after the new one is held
+   //+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+
+   Buffer_View& Buffer_View::operator=(const Buffer_View& other)
+   {
+      if (this != &other)
+      {
+         if (nullptr != other._header)
+         {
+            other._header->references.fetch_add(1, std::memory_order_relaxed);
+         }
+         Reset();
+         _header = other._header;
+         _data = other._data;
+         _size = other._size;
+      }
+      return *this;
+   }
+
+   Buffer_View& Buffer_View::operator=(Buffer_View&& other) noexcept
+   {
+      if (this != &other)
+      {
+         Reset();
+         _header = other._header;
+         _data = other._data;
+         _size = other._size;
+         other._header = nullptr;
+         other._data = nullptr;
+         other._size = 0;
+      }
+      return *this;
+   }  // END Assignment
+
+   //+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+
+   /// Destructor
+   //+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+
+   Buffer_View::~Buffer_View()
+   {
+      Reset();
+   }  // END Destructor
+
+   //+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+
+   /// Makes a view of part of the same buffer
+   //+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+
+   Buffer_View Buffer_View::Slice(size_t offset, size_t length) const
+   {
+      Buffer_View slice(*this);
+      slice._data = Get_Buffer() + offset;
+      slice._size = length;
+      return slice;
+   }  // END Slice()
+
+   //+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+
+   /// Releases the buffer and views nothing
+   //+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+
+   void Buffer_View::Reset()
+   {
+      //
+      // 1. The last view out returns the buffer, acquire release so every
+      //    read through other views finishes before it can be reused
+      if (nullptr != _header && 1 == _header->references.fetch_sub(1, std::memory_order_acq_rel))
+      {
+         Buffer_Pool::Release(_header);
+      }
+      _header = nullptr;
+      _data = nullptr;
+      _size = 0;
+   }  // END Reset()
+
+   //+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+
+   /// Checks that no other view shares the buffer
+   //+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+
+   bool Buffer_View::Is_Unique() const
+   {
+      return nullptr != _header && 1 == _header->references.load(std::memory_order_acquire);
+   }  // END Is_Unique()
+
+   //-+-+-+-+-+-+-+-+-+-+-+Buffer_Pool FUNCTIONS+-+-+-+-+-+-+-+-+-+-+-+-+
+
+   //+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+
+   /// Constructor
+   //+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+
+   Buffer_Pool::Buffer_Pool(size_t buffer_size, uint32_t buffer_count)
+   {
+      _buffer_size = buffer_size;
+      _buffer_count = buffer_count;
+      _stride = sizeof(Buffer_Header) + Round_To_Cache_Line(buffer_size);
+
+      // Left uninitialized so pages are only touched as buffers are carved
+      _allocation.reset(new char[_stride * buffer_count + Lock_Free::CACHE_LINE_SIZE]);
+      _arena = reinterpret_cast<char*>(Round_To_Cache_Line(reinterpret_cast<uintptr_t>(_allocation.get())));
+
+      _free_head.store(NO_BUFFER, std::memory_order_relaxed);
+      _carved.store(0, std::memory_order_relaxed);
+   }  // END Constructor
+
+   //+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+
+   /// Gets a buffer of at least size bytes
+   //+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+
+   Buffer_View Buffer_Pool::Acquire(size_t size)
+   {
+      Buffer_Header* header;
+      uint64_t head;
+      uint32_t index = NO_BUFFER;
+      char* allocation;
+
+      if (size <= _buffer_size)
+      {
+         //
+         // 1. Pop the free list, the tag in the upper half changes on every
+         //    pop so a head popped and pushed back meanwhile fails the swap
+         head = _free_head.load(std::memory_order_acquire);
+         while (NO_BUFFER != static_cast<uint32_t>(head))
+         {
+            index = static_cast<uint32_t>(head);
+            uint64_t next = ((head >> 32) + 1) << 32 | Get_Header(index)->next_free.load(std::memory_order_relaxed);
+            if (_free_head.compare_exchange_weak(head, next, std::memory_order_acquire, std::memory_order_acquire))
+            {
+               break;
+            }
+            index = NO_BUFFER;
+         }
+
+         //
+         // 2. Nothing free, carve a buffer never handed out before
+         if (NO_BUFFER == index && _carved.load(std::memory_order_relaxed) < _buffer_count)
+         {
+            index = _carved.fetch_add(1, std::memory_order_relaxed);
+            if (_buffer_count <= index)
+            {
+               index = NO_BUFFER;
+            }
+            else
+            {
+               header = new (Get_Header(index)) Buffer_Header();
+               header->pool = this;
+               header->allocation = nullptr;
+               header->capacity = _buffer_size;
+            }
+         }
+
+         if (NO_BUFFER != index)
+         {
+            return Buffer_View(Get_Header(index));
+         }
+      }
+
+      //
+      // 3. Too large for the pool or the pool is empty, fall back to the heap
+      if (size < _buffer_size)
+      {
+         size = _buffer_size;
+      }
+      allocation = new char[sizeof(Buffer_Header) + size + Lock_Free::CACHE_LINE_SIZE];
+      header = new (reinterpret_cast<char*>(Round_To_Cache_Line(reinterpret_cast<uintptr_t>(allocation)))) Buffer_Header();
+      header->pool = nullptr;
+      header->allocation = allocation;
+      header->capacity = size;
+
+      return Buffer_View(header);
+   }  // END Acquire()
+
+   //+-+-+-+-+-+-+-+-+-+-+PRIVATE FUNCTIONS+-+-+-+-+-+-+-+-+-+-+-+-+-+
+
+   //+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+
+   /// Returns a buffer whose last view was released
+   //+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+
+   void Buffer_Pool::Release(Buffer_Header* header)
+   {
+      Buffer_Pool* pool = header->pool;
+      uint64_t head;
+      uint64_t next;
+      uint32_t index;
+
+      //
+      // 1. Unpooled buffers go back to the heap
+      if (nullptr == pool)
+      {
+         char* allocation = header->allocation;
+         header->~Buffer_Header();
+         delete[] allocation;
+         return;
+      }
+
+      //
+      // 2. Push onto the free list, the tag only changes on pops
+      index = static_cast<uint32_t>((reinterpret_cast<char*>(header) - pool->_arena) / pool->_stride);
+      head = pool->_free_head.load(std::memory_order_relaxed);
+      do
+      {
+         header->next_free.store(static_cast<uint32_t>(head), std::memory_order_relaxed);
+         next = (head & 0xFFFFFFFF00000000ull) | index;
+      } while (!pool->_free_head.compare_exchange_weak(head, next, std::memory_order_release, std::memory_order_relaxed));
+   }  // END Release()
+
+}  // END namespace Buffers
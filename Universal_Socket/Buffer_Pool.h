@@ -0,0 +1,238 @@
+//+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+
+// 
+//  ___________ __  .__                       ___________
+//  \_   _____//  |_|  |__ _____    ____      \_   _____/
+//   |    __)_\   __\  |  \\__  \  /    \      |    __)_ 
+//   |        \|  | |   Y  \/ __ \|   |  \     |        \
+//  /_______  /|__| |___|  (____  /___|  / /\ /_______  /
+//          \/           \/     \/     \/  \/         \/ 
+// 
+// Buffer Pool Header File
+//
+//  Author   Date         Description
+// --------------------------------------------------------
+//  ECE      10-17-2026   Initial Implementation
+//  ECE      10-17-2026   Added the broadcast pool
+//  ECE      10-17-2026   Added the send pool queued messages are copied into
+//+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+
+
+#pragma once
+
+#include "Lock_Free_Queue.h"
+
+#include <atomic>
+#include <cstddef>
+#include <cstdint>
+#include <memory>
+
+namespace Buffers
+{
+   // Bytes in every pooled receive buffer
+   constexpr size_t RECEIVE_BUFFER_SIZE{ 16384 };
+
+   // Pooled receive buffers, carved from one arena as they are first needed
+   constexpr uint32_t RECEIVE_BUFFER_COUNT{ 2048 };
+
+   // Bytes in every pooled broadcast buffer, a larger broadcast gets a
+   // heap buffer of its own
+   constexpr size_t BROADCAST_BUFFER_SIZE{ 4096 };
+
+   // Pooled broadcast buffers, each held until its last subscriber sent it
+   constexpr uint32_t BROADCAST_BUFFER_COUNT{ 1024 };
+
+   // Bytes in every pooled send buffer, a larger message gets a heap
+   // buffer of its own
+   constexpr size_t SEND_BUFFER_SIZE{ 1024 };
+
+   // Pooled send buffers, each held until its message is sent
+   constexpr uint32_t SEND_BUFFER_COUNT{ 16384 };
+
+   // Index used when a free list link points at nothing
+   constexpr uint32_t NO_BUFFER{ 0xFFFFFFFF };
+
+   class Buffer_Pool;
+
+   //+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+
+   /// @brief   Sits in front of every buffer's bytes, the bytes
+   /// @brief   start on the next cache line
+   //+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+
+   struct alignas(Lock_Free::CACHE_LINE_SIZE) Buffer_Header
+   {
+      std::atomic<uint32_t> references;
+      std::atomic<uint32_t> next_free;    // Next buffer on the pool's free list
+      Buffer_Pool* pool;                  // nullptr for a buffer the pool could not supply
+      char* allocation;                   // Heap block of an unpooled buffer
+      size_t capacity;
+   };
+
+   //+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+
+   /// @brief   Reference counted view of part of a buffer. Copies
+   /// @brief   share the buffer, it goes back to its pool when
+   /// @brief   the last view is released, from any thread
+   //+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+
+   class Buffer_View
+   {
+   public:
+
+      //+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+
+      /// @brief   Constructor, views nothing
+      //+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+
+      Buffer_View();
+
+      Buffer_View(const Buffer_View& other);
+      Buffer_View(Buffer_View&& other) noexcept;
+      Buffer_View& operator=(const Buffer_View& other);
+      Buffer_View& operator=(Buffer_View&& other) noexcept;
+
+      //+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+
+      /// @brief   Destructor, releases this view's reference
+      //+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+
+      ~Buffer_View();
+
+      //+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+
+      /// @brief   Makes a view of part of the same buffer
+      /// @param   size_t            Offset from the start of the buffer
+      /// @param   size_t            Length of the view
+      /// @return  Buffer_View       View sharing the buffer
+      //+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+
+      Buffer_View Slice(size_t offset, size_t length) const;
+
+      //+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+
+      /// @brief   Releases the buffer and views nothing
+      /// @return  None
+      //+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+
+      void Reset();
+
+      //+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+
+      /// @brief   Checks that no other view shares the buffer, only
+      /// @brief   then may bytes already handed out be written over
+      /// @return  bool              True if this is the only view
+      //+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+
+      bool Is_Unique() const;
+
+      inline const char* Data() const { return _data; }
+      inline size_t Size() const { return _size; }
+      inline bool Is_Valid() const { return nullptr != _header; }
+
+      //+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+
+      /// @brief   Gets the start of the whole buffer for the one
+      /// @brief   filling it
+      /// @return  char*             Start of the buffer
+      //+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+
+      inline char* Get_Buffer() const { return reinterpret_cast<char*>(_header + 1); }
+
+      //+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+
+      /// @brief   Gets the size of the whole buffer
+      /// @return  size_t            Capacity, 0 when viewing nothing
+      //+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+
+      inline size_t Get_Capacity() const { return (nullptr == _header) ? 0 : _header->capacity; }
+
+   private:
+
+      friend class Buffer_Pool;
+
+      //+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+
+      /// @brief   Constructor, takes the buffer's first reference
+      //+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+
+      explicit Buffer_View(Buffer_Header* header);
+
+      Buffer_Header* _header;
+      const char* _data;
+      size_t _size;
+
+   };  // END class Buffer_View
+
+   //+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+
+   /// @brief   Fixed size buffers carved from one arena. Any
+   /// @brief   thread may acquire and release, the free list is
+   /// @brief   a lock free stack tagged against reuse races
+   //+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+
+   class Buffer_Pool
+   {
+   public:
+
+      //+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+
+      /// @brief   Constructor, reserves the arena, no buffer is
+      /// @brief   touched until it is first acquired
+      /// @param   size_t            Bytes in every buffer
+      /// @param   uint32_t          Number of buffers
+      //+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+
+      Buffer_Pool(size_t buffer_size, uint32_t buffer_count);
+
+      Buffer_Pool(const Buffer_Pool&) = delete;
+      Buffer_Pool& operator=(const Buffer_Pool&) = delete;
+
+      //+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+
+      /// @brief   Gets a buffer of at least size bytes, viewed whole.
+      /// @brief   Sizes over the buffer size, or an empty pool, get
+      /// @brief   a heap buffer freed when its last view goes
+      /// @param   size_t            Bytes needed
+      /// @return  Buffer_View       Only view of the buffer
+      //+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+
+      Buffer_View Acquire(size_t size);
+
+      //+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+
+      /// @brief   Gets the size of every pooled buffer
+      /// @return  size_t            _buffer_size
+      //+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+
+      inline size_t Get_Buffer_Size() const { return _buffer_size; }
+
+   private:
+
+      friend class Buffer_View;
+
+      std::unique_ptr<char[]> _allocation;
+      char* _arena;                       // _allocation aligned to a cache line
+      size_t _stride;                     // Header plus buffer, whole cache lines
+      size_t _buffer_size;
+      uint32_t _buffer_count;
+      alignas(Lock_Free::CACHE_LINE_SIZE) std::atomic<uint64_t> _free_head;   // Tag above, index below
+      alignas(Lock_Free::CACHE_LINE_SIZE) std::atomic<uint32_t> _carved;      // Buffers handed out at least once
+
+      //+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+
+      /// @brief   Gets the header of a pooled buffer
+      /// @param   uint32_t          Index of the buffer
+      /// @return  Buffer_Header*    Header of the buffer
+      //+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+
+      inline Buffer_Header* Get_Header(uint32_t index)
+      {
+         return reinterpret_cast<Buffer_Header*>(_arena + index * _stride);
+      }
+
+      //+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+
+      /// @brief   Returns a buffer whose last view was released,
+      /// @brief   unpooled buffers are freed instead
+      /// @param   Buffer_Header*    Header of the buffer
+      /// @return  None
+      //+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+
+      static void Release(Buffer_Header* header);
+
+   };  // END class Buffer_Pool
+
+   //+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+
+   /// @brief   Pool every socket receives into, created on first use
+   /// @return  Buffer_Pool&      Shared receive pool
+   //+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+
+   Buffer_Pool& Receive_Pool();
+
+   //+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+
+   /// @brief   Pool broadcasts are framed into, created on first use
+   /// @return  Buffer_Pool&      Shared broadcast pool
+   //+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+
+   Buffer_Pool& Broadcast_Pool();
+
+   //+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+
+   /// @brief   Pool queued messages are copied into, created on first use
+   /// @return  Buffer_Pool&      Shared send pool
+   //+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+
+   Buffer_Pool& Send_Pool();
+
+   //+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+
+   /// @brief   Copies a message into a send pool buffer
+   /// @param   const char*       Message to be copied
+   /// @param   size_t            Length of the message
+   /// @return  Buffer_View       View of exactly the copied bytes
+   //+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+
+   Buffer_View Copy_To_Send_Pool(const char* data, size_t length);
+
+}  // END namespace Buffers
@@ -14,22 +14,43 @@
 //  ECE      08-11-2024   Initial Implementation
 //  ECE      08-14-2024   Added connection check before send
 //  ECE      08-15-2024   Added another TCP server socket object
+//  ECE      10-17-2026   Receiving thread polls every socket with WSAPoll
+//  ECE      10-17-2026   Batched sends for registered I/O sockets
+//  ECE      10-17-2026   Sending thread sleeps until a socket is scheduled
+//  ECE      10-17-2026   Batch pops from the lock free send queues
+//  ECE      10-17-2026   Polls and sends to every accepted server connection
+//  ECE      10-17-2026   Sends messages by length so they may be binary
+//  ECE      10-17-2026   One gathered write per batch of queued messages
+//  ECE      10-17-2026   Added Socket_Processing_Thread for received messages
+//  ECE      10-17-2026   One receiving and one sending thread per event loop
+//  ECE      10-17-2026   Received messages go to the handler pool, no processing thread
+//  ECE      10-17-2026   Sockets are created in the registry, loops walk their own lists
+//  ECE      10-17-2026   Poll timeout follows the earliest connect or backoff deadline
+//  ECE      10-17-2026   Send backlogs written first, popped bytes released
+//  ECE      10-17-2026   Handle_Event() latency recorded per socket
+//  ECE      10-17-2026   Messages go to the asynchronous log
+//  ECE      10-17-2026   Sending thread waits alertable for zero-copy completions
+//  ECE      10-17-2026   Queued files started once the send queue is drained
+//  ECE      10-17-2026   Poll timeout and expiries come from the loop's timer wheel
+//  ECE      10-17-2026   Queued messages are held in pooled buffers
+//  ECE      10-17-2026   Queued sends carry their datagram destination
 //+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+
 
 #include "Communication_Interface.h"
+#include "Registered_IO.h"
+#include "Socket_Registry.h"
+
+#include <chrono>
 
 namespace Comms_Interface
 {
-   // List of all sockets
-   std::vector<Universal_Socket> Socket_List;
-
    //+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+    
    /// Creates and starts all sockets
    //+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+
    bool Setup_Comms()
    {
       bool result = true;
-      printf("Beginning Universal Socket!\n");
+      Log::Write<Log::LEVEL_INFO>("Beginning Universal Socket!\n");
       Socket_Vars::Protocol protocol_type = Socket_Vars::UDP;
       Socket_Vars::Connection_Type connect_type = Socket_Vars::SERVER;
       std::string ip_address = "127.0.0.1";
@@ -37,8 +58,10 @@ namespace Comms_Interface
       int port = 8080;
 
       //
-      // 1. Create the all the Socket objects
-      Universal_Socket Server_Socket = Universal_Socket
+      // 1. Create the all the Socket objects in the registry, more can be
+      //    created and any destroyed while the event loops run
+      Socket_Vars::Socket_Handle handles[2];
+      handles[0] = Socket_Vars::Sockets().Create
       (
          protocol_type,
          connect_type,
@@ -51,7 +74,7 @@ namespace Comms_Interface
       socket_name = "Universal_Socket->Port8090";
       port = 8090;
       protocol_type = Socket_Vars::TCP;
-      Universal_Socket Server_Socket_8090 = Universal_Socket
+      handles[1] = Socket_Vars::Sockets().Create
       (
          protocol_type,
          connect_type,
@@ -61,19 +84,14 @@ namespace Comms_Interface
       );
 
       //
-      // 2. Add all Socket objects to the list of socket objects
-      Socket_List.push_back(std::move(Server_Socket));
-      Socket_List.push_back(std::move(Server_Socket_8090));
-
-      //
-      // 3. Start all the sockets in the Socket_List
-      for (int i = 0; i != Socket_List.size(); i++)
+      // 2. Start all the sockets, each joins its event loop
+      for (int i = 0; i != 2; i++)
       {
-         result &= Socket_List[i].Start();
+         result &= Socket_Vars::Sockets().Start(handles[i]);
          if (!result)
          {
-            printf("Problem occurred starting socket %d\n", i);
-            Socket_List[i].Stop();
+            Log::Write<Log::LEVEL_ERROR>("Problem occurred starting socket %d\n", i);
+            Socket_Vars::Sockets().Destroy(handles[i]);
             exit(EXIT_FAILURE);
          }
 
@@ -83,100 +101,271 @@ namespace Comms_Interface
    }  // END Setup_Comms()
 
    //+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+
-   /// Main processing loop for all Socket Sending
+   /// Main processing loop for one event loop's Socket Sending
    //+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+
-   void Socket_Sending_Thread()
+   void Socket_Sending_Thread(uint16_t loop)
    {
       bool keep_comms_alive = true;
       bool send_result = true;
-      std::string message;    // second item in the pair
+      DWORD wait_result;
+      size_t message_count;
+      size_t message_bytes;
+      Socket_Vars::Queued_Send messages[Socket_Vars::SEND_BATCH_SIZE];
+      std::vector<uint32_t> scheduled_sockets;
+      Universal_Socket* socket;
 
-      // Main socket loop to receive and send messages to any connections
+      // Main socket loop to send messages to any connections
       while (keep_comms_alive)
       {
-         for (int i = 0; i < Socket_List.size(); i++)
+         //
+         // 1. Sleep until a producer schedules a socket on this loop, the
+         //    wait is alertable so zero-copy completion routines run here
+         //    and schedule their socket again
+         wait_result = WaitForSingleObjectEx(Socket_Vars::send_wake_events[loop], INFINITE, TRUE);
+         if (WAIT_IO_COMPLETION == wait_result)
+         {
+            continue;
+         }
+         if (WAIT_OBJECT_0 != wait_result)
+         {
+            Log::Write<Log::LEVEL_ERROR>("Socket_Sending_Thread() wait failed with: %u\n", GetLastError());
+            keep_comms_alive = false;
+            continue;
+         }
+
+         //
+         // 2. Service only the sockets that were scheduled since the last wakeup
+         Socket_Vars::Take_Scheduled_Sends(loop, scheduled_sockets);
+         for (uint32_t i : scheduled_sockets)
          {
+            socket = Socket_Vars::Sockets().Get(i);
+            if (nullptr == socket)
+            {
+               continue;
+            }
+
             //
-            // 1. Lock the send_mutex for thread safety
-            std::unique_lock<std::mutex> lock(Socket_Vars::send_mutex[i]);
+            // 2a. TCP servers send to each of their accepted connections
+            //     on this loop, even with none left closed connections
+            //     must be released
+            if (socket->Has_Connections())
+            {
+               send_result = socket->Send_Connections(loop);
+               if (!send_result)
+               {
+                  Log::Write<Log::LEVEL_ERROR>("Socket %u Send_Connections() failed!\n", i);
+               }
+               continue;
+            }
 
             //
-            // 2. If the queue is not empty, then send the message waiting in the queue
-            if (false == Socket_Vars::send_queue[i].empty()
-                &&
-                Socket_List[i].Is_Socket_Connected())
+            // 2b. Messages queued while disconnected wait until the socket
+            //     is scheduled again on connect
+            if (!socket->Is_Socket_Connected())
             {
-               //
-               // 2a. Dequeue the message from the send queue
-               message = Socket_Vars::send_queue[i].front();
-               Socket_Vars::send_queue[i].pop();
-
-               //
-               // 2b. Send the message
-               send_result = Socket_List[i].Send(message.c_str());
+               continue;
+            }
+
+            //
+            // 2c. Registered I/O sockets submit everything queued in one batch
+            if (Socket_Vars::REGISTERED_IO == socket->Get_IO_Engine())
+            {
+               send_result = Registered_IO::Send_Queued(socket->Get_Queue_Index(), socket->Get_Send_Address());
                if (!send_result)
                {
-                  printf("Socket %d Send() failed!\n", i);
+                  Log::Write<Log::LEVEL_ERROR>("Socket %u Send_Queued() failed!\n", i);
+               }
+               continue;
+            }
+
+            //
+            // 2d. Anything a full socket buffer left goes first, the event
+            //     loop schedules the socket again once it is writable
+            send_result = socket->Flush_Send_Backlog();
+            if (!send_result)
+            {
+               Log::Write<Log::LEVEL_ERROR>("Socket %u Flush_Send_Backlog() failed!\n", i);
+            }
+
+            //
+            // 2e. Send every message waiting in the queue, a batch at a time
+            //     with one gathered write per batch, no lock is held so
+            //     producers are never blocked by the send, nothing more is
+            //     popped while a backlog waits
+            while (!socket->Has_Send_Backlog())
+            {
+               message_count = Socket_Vars::Get_Send_Queue(i).Pop_Batch(messages, Socket_Vars::SEND_BATCH_SIZE);
+               message_bytes = 0;
+               for (size_t k = 0; k < message_count; k++)
+               {
+                  message_bytes += messages[k].message.Size();
+               }
+               Socket_Vars::Release_Send_Bytes(i, message_bytes);
+               if (0 < message_count)
+               {
+                  send_result = socket->Send_Batch(messages, message_count);
+                  if (!send_result)
+                  {
+                     Log::Write<Log::LEVEL_ERROR>("Socket %u Send_Batch() failed!\n", i);
+                  }
+
+                  // The sent buffers go back to the send pool now rather
+                  // than when the next batch is popped over them
+                  for (size_t k = 0; k < message_count; k++)
+                  {
+                     messages[k].message.Reset();
+                  }
+               }
+               if (Socket_Vars::SEND_BATCH_SIZE != message_count)
+               {
+                  break;
                }
             }
-         }  // END Socket_List loop
+
+            //
+            // 2f. A queued file starts once the queue is drained, one chunk
+            //     at a time so the other sockets on this loop get their turn
+            send_result = socket->Send_Queued_File();
+            if (!send_result)
+            {
+               Log::Write<Log::LEVEL_ERROR>("Socket %u Send_Queued_File() failed!\n", i);
+            }
+         }  // END scheduled_sockets loop
+
+         //
+         // 3. Let go of destroyed sockets no longer scheduled on this loop
+         Socket_Vars::Sockets().Release_Retired(loop);
 
       }  // END while keep_comms_alive
 
-      printf("Closing Socket_Sending_Thread()!\n");
+      Log::Write<Log::LEVEL_INFO>("Closing Socket_Sending_Thread()!\n");
 
    }  // END Socket_Sending_Thread()
 
    //+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+
-   /// Main processing loop for all Socket Receiving
+   /// Main processing loop for one event loop's Socket Receiving
    //+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+
-   void Socket_Receiving_Thread()
+   void Socket_Receiving_Thread(uint16_t loop)
    {
       bool result = true;
       bool keep_comms_alive = true;
-      DWORD event_number;
+      int ready_count;
+      int poll_timeout;
+      WSAPOLLFD wake_fd;
+      std::chrono::steady_clock::time_point event_start;
+      Timers::Timer_Wheel& wheel = Socket_Vars::Get_Timer_Wheel(loop);
+      std::vector<WSAPOLLFD> poll_fds;       // One entry per pollable socket
+      std::vector<Universal_Socket*> poll_owners;   // Socket of each poll_fds entry
+      std::vector<uint32_t> poll_connections; // Connection index of each entry, or NO_CONNECTION
+
+      //
+      // 0. Open the socket other threads wake this loop's poll with,
+      //    it is always the first entry of the poll set
+      wake_fd.fd = Socket_Vars::Open_Event_Loop(loop);
+      wake_fd.events = POLLRDNORM;
+      wake_fd.revents = 0;
+      if (INVALID_SOCKET == wake_fd.fd)
+      {
+         keep_comms_alive = false;
+      }
 
-      // Main receiving loop for all sockets
+      // Main receiving loop for this loop's sockets
       while (keep_comms_alive)
       {
          //
-         // 1. Wait until an event is triggered on a socket
-         //    return value is the index which event was triggered
-         event_number = WSAWaitForMultipleEvents(
-            Socket_Vars::event_count,    // Number of events to wait for
-            Socket_Vars::socket_events,  // List of event handles
-            FALSE,                       // Wait for all events to be signaled
-            WSA_INFINITE,                // Timeout interval
-            TRUE                         // Whether the wait should be alterable
+         // 1. Build the poll set from every socket of this loop that currently
+         //    has a handle, rebuilt each pass since accepts and reconnects swap
+         //    the handle, other loops hand over accepted connections and
+         //    sockets are created and destroyed, each socket's timers are
+         //    put on the wheel as it goes
+         Socket_Vars::Sockets().Adopt(loop);
+         poll_fds.clear();
+         poll_owners.clear();
+         poll_connections.clear();
+         poll_fds.push_back(wake_fd);
+         poll_owners.push_back(nullptr);
+         poll_connections.push_back(Socket_Vars::NO_CONNECTION);
+         for (Universal_Socket* socket : Socket_Vars::Sockets().Get_Loop_Sockets(loop))
+         {
+            socket->Get_Poll_Sockets(poll_fds, poll_connections, loop);
+            poll_owners.resize(poll_fds.size(), socket);
+            socket->Arm_Timers(loop);
+         }
+
+         //
+         // 2. Wait until at least one socket is ready, or until the wheel's
+         //    next timer is due, indefinitely with none, return value is the
+         //    number of ready sockets
+         poll_timeout = wheel.Get_Timeout(std::chrono::steady_clock::now());
+         ready_count = WSAPoll(
+            poll_fds.data(),                       // List of sockets to poll
+            static_cast<ULONG>(poll_fds.size()),   // Number of sockets in the list
+            poll_timeout                           // Until the next timer
          );
 
          //
-         // 2. If the event that triggered was a failure then exit the Communication Loop
-         if (WSA_WAIT_FAILED == event_number)
+         // 3. If the poll failed then exit the Communication Loop
+         if (SOCKET_ERROR == ready_count)
          {
-            printf("WSAWaitForMultipleEvents() failed with: %u\n", WSAGetLastError());
+            Log::Write<Log::LEVEL_ERROR>("WSAPoll() failed with: %u\n", WSAGetLastError());
             keep_comms_alive = false;
          }
          //
-         // 3. If the event that triggered was a timeout then exit the Communication Loop
-         else if (WSA_WAIT_TIMEOUT == event_number)
+         // 4. If the poll timed out with nothing due then exit the Communication Loop
+         else if (0 == ready_count && -1 == poll_timeout)
          {
-            printf("WSAWaitForMultipleEvents() Timeout failed, shouldn't happen, %u\n", WSAGetLastError());
+            Log::Write<Log::LEVEL_ERROR>("WSAPoll() Timeout failed, shouldn't happen, %u\n", WSAGetLastError());
             keep_comms_alive = false;
          }
          //
-         // 4. Otherwise, handle the event for the socket that triggered the event
+         // 5. Otherwise, handle the event for every socket that is ready,
+         //    stop scanning once all ready sockets have been handled
          else
          {
-            result = Socket_List[(event_number - WAIT_OBJECT_0)].Handle_Event();
-            if (!result)
+            for (size_t j = 0; j < poll_fds.size() && 0 < ready_count; j++)
             {
-               printf("Handle_Event() returned false!\n");
+               if (0 == poll_fds[j].revents)
+               {
+                  continue;
+               }
+               ready_count--;
+
+               if (poll_fds[j].revents & POLLNVAL)
+               {
+                  continue;   // Socket was closed underneath us, skip it
+               }
+
+               if (0 == j)
+               {
+                  Socket_Vars::Clear_Event_Loop_Wake(loop);
+                  continue;   // Woken to rebuild the poll set
+               }
+
+               event_start = std::chrono::steady_clock::now();
+               if (Socket_Vars::NO_CONNECTION == poll_connections[j])
+               {
+                  result = poll_owners[j]->Handle_Event(poll_fds[j].revents);
+               }
+               else
+               {
+                  result = poll_owners[j]->Handle_Connection_Event(poll_connections[j], poll_fds[j].revents);
+               }
+               poll_owners[j]->Get_Stats().handle_event.Record_Since(event_start);
+               if (!result)
+               {
+                  Log::Write<Log::LEVEL_ERROR>("Handle_Event() returned false!\n");
+               }
             }
          }
 
+         //
+         // 6. Fire every timer now due, connects whose backoff passed or
+         //    that were too slow, idle links and heartbeats, the ticks with
+         //    nothing due are skipped
+         wheel.Advance(std::chrono::steady_clock::now());
+
       }  // END while keep_comms_alive
-      printf("Closing Socket_Receiving_Thread()!\n");
+      Log::Write<Log::LEVEL_INFO>("Closing Socket_Receiving_Thread()!\n");
 
    }  // END Socket_Receiving_Thread()
 
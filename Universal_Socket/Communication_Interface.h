@@ -12,6 +12,10 @@
 //  Author   Date         Description
 // --------------------------------------------------------
 //  ECE      08-11-2024   Initial Implementation
+//  ECE      10-17-2026   Added Socket_Processing_Thread for received messages
+//  ECE      10-17-2026   One receiving and one sending thread per event loop
+//  ECE      10-17-2026   Received messages go to the handler pool, no processing thread
+//  ECE      10-17-2026   Sockets are created in the registry, no Socket_List
 //+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+
 
 #pragma once
@@ -22,9 +26,6 @@
 
 namespace Comms_Interface
 {
-   // List of all sockets
-   extern std::vector<Universal_Socket> Socket_List;
-
    //+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+
    /// @brief   Creates and starts all sockets
    /// @return  bool              Result of sockets creation
@@ -32,15 +33,19 @@ namespace Comms_Interface
    bool Setup_Comms();
 
    //+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+
-   /// @brief   Main processing loop for all Socket Sending
+   /// @brief   Main processing loop for Socket Sending, one
+   /// @brief   thread per event loop
+   /// @param   uint16_t          Event loop whose sockets are sent on
    /// @return  None
    //+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+
-   void Socket_Sending_Thread();
+   void Socket_Sending_Thread(uint16_t loop);
    
    //+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+
-   /// @brief   Main processing loop for all Socket Receiving
+   /// @brief   Main processing loop for Socket Receiving, one
+   /// @brief   thread per event loop
+   /// @param   uint16_t          Event loop whose sockets are polled
    /// @return  None
    //+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+
-   void Socket_Receiving_Thread();
+   void Socket_Receiving_Thread(uint16_t loop);
 
 }  // END namespace Comms_Interface
\ No newline at end of file
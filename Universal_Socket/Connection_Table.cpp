@@ -0,0 +1,483 @@
+//+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+
+// 
+//  ___________ __  .__                       ___________
+//  \_   _____//  |_|  |__ _____    ____      \_   _____/
+//   |    __)_\   __\  |  \\__  \  /    \      |    __)_ 
+//   |        \|  | |   Y  \/ __ \|   |  \     |        \
+//  /_______  /|__| |___|  (____  /___|  / /\ /_______  /
+//          \/           \/     \/     \/  \/         \/ 
+// 
+// Connection Table Implementation File
+//
+//  Author   Date         Description
+// --------------------------------------------------------
+//  ECE      10-17-2026   Initial Implementation
+//  ECE      10-17-2026   Received messages go on the server's receive queue
+//  ECE      10-17-2026   Connections are spread across event loops
+//  ECE      10-17-2026   Each connection's messages are handled on its own strand
+//  ECE      10-17-2026   Added Is_Idle so a destroyed server waits for its handlers
+//  ECE      10-17-2026   Unsent bytes wait in a backlog until the socket is writable
+//  ECE      10-17-2026   Messages go to the asynchronous log
+//  ECE      10-17-2026   Adopt returns how many connections joined the loop
+//  ECE      10-17-2026   Added Queue_Broadcast and Set_Subscribed
+//  ECE      10-17-2026   Stale connection ids are refused once their slot is reused
+//  ECE      10-17-2026   Queued messages are held in pooled buffers
+//  ECE      10-17-2026   Active lists change under their loop's mutex
+//  ECE      10-17-2026   Removing a connection wakes its parked async sends
+//+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+
+
+#include "Connection_Table.h"
+#include "Socket_Log.h"
+
+
+//+-+-+-+-+-+-+-+-+-+-+PRIVATE FUNCTIONS+-+-+-+-+-+-+-+-+-+-+-+-+-+
+
+//+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+
+/// Allocates the next slab and frees its slots
+//+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+
+bool Connection_Table::Add_Slab()
+{
+   bool result = true;
+
+   uint32_t slab = _slab_count.load(std::memory_order_relaxed);
+
+   //
+   // 1. Check there is a slab left
+   if (Socket_Vars::MAX_CONNECTION_SLABS <= slab)
+   {
+      Log::Write<Log::LEVEL_WARNING>("Too many connections!\n");
+      result &= false;
+      return result;
+   }
+
+   //
+   // 2. Allocate the state and queues for every slot in the slab
+   Connection* states = new Connection[Socket_Vars::CONNECTIONS_PER_SLAB];
+   Connection_Queues* queues = new Connection_Queues[Socket_Vars::CONNECTIONS_PER_SLAB];
+   for (uint32_t i = 0; i < Socket_Vars::CONNECTIONS_PER_SLAB; i++)
+   {
+      states[i].socket = INVALID_SOCKET;
+      states[i].active_position = 0;
+      states[i].loop.store(0, std::memory_order_relaxed);
+      states[i].is_connected.store(false, std::memory_order_relaxed);
+      states[i].is_send_scheduled.store(false, std::memory_order_relaxed);
+      states[i].is_waiting_writable.store(false, std::memory_order_relaxed);
+      states[i].groups.store(0, std::memory_order_relaxed);
+      states[i].is_too_slow.store(false, std::memory_order_relaxed);
+      states[i].generation.store(0, std::memory_order_relaxed);
+      states[i].producers.store(0, std::memory_order_relaxed);
+      queues[i].send_queue.Initialize(Socket_Vars::CONNECTION_QUEUE_CAPACITY);
+      queues[i].broadcast_queue.Initialize(Socket_Vars::BROADCAST_QUEUE_CAPACITY);
+
+      // The connection index picks the strand's worker, so connections
+      // spread evenly and each keeps its worker's caches
+      queues[i].strand.Initialize(
+         Socket_Vars::CONNECTION_RECEIVE_CAPACITY,
+         _handler,
+         _handler_context,
+         static_cast<uint16_t>(slab * Socket_Vars::CONNECTIONS_PER_SLAB + i),
+         Socket_Vars::CONNECTION_EVENT_CELLS);
+   }
+
+   //
+   // 3. Publish the slab, then free its slots lowest index last so it is used first
+   _states[slab].store(states, std::memory_order_release);
+   _queues[slab].store(queues, std::memory_order_release);
+   _slab_count.store(slab + 1, std::memory_order_release);
+   for (uint32_t i = Socket_Vars::CONNECTIONS_PER_SLAB; i > 0; i--)
+   {
+      _free.push_back(slab * Socket_Vars::CONNECTIONS_PER_SLAB + i - 1);
+   }
+
+   return result;
+}  // END Add_Slab()
+
+//-+-+-+-+-+-+-+-+-+-+-+PUBLIC FUNCTIONS+-+-+-+-+-+-+-+-+-+-+-+-+-+
+
+//+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+
+/// Constructor
+//+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+
+Connection_Table::Connection_Table(uint16_t loop_count, Socket_Vars::Message_Strand::Handler handler, void* context)
+{
+   _handler = handler;
+   _handler_context = context;
+   for (uint32_t i = 0; i < Socket_Vars::MAX_CONNECTION_SLABS; i++)
+   {
+      _states[i].store(nullptr, std::memory_order_relaxed);
+      _queues[i].store(nullptr, std::memory_order_relaxed);
+   }
+   _slab_count.store(0, std::memory_order_relaxed);
+   _active_count.store(0, std::memory_order_relaxed);
+
+   // A connection is on each list at most once, so these never fill
+   _released.Initialize(Socket_Vars::MAX_CONNECTIONS);
+   _loop_count = (0 == loop_count) ? 1 : loop_count;
+   _loops.reset(new Loop_Connections[_loop_count]);
+   for (uint16_t i = 0; i < _loop_count; i++)
+   {
+      _loops[i].handed_off.Initialize(Socket_Vars::MAX_CONNECTIONS);
+      _loops[i].pending_sends.Initialize(Socket_Vars::MAX_CONNECTIONS);
+      _loops[i].closed.Initialize(Socket_Vars::MAX_CONNECTIONS);
+   }
+}  // END Constructor
+
+//+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+
+/// Destructor, closes any connection still open
+//+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+
+Connection_Table::~Connection_Table()
+{
+   uint32_t slab_count = _slab_count.load(std::memory_order_acquire);
+
+   // Removed connections the sending thread never released still hold a socket
+   for (uint32_t connection = 0; connection < Get_Capacity(); connection++)
+   {
+      if (INVALID_SOCKET != Get(connection).socket)
+      {
+         closesocket(Get(connection).socket);
+      }
+   }
+
+   for (uint32_t i = 0; i < slab_count; i++)
+   {
+      delete[] _states[i].load(std::memory_order_relaxed);
+      delete[] _queues[i].load(std::memory_order_relaxed);
+   }
+}  // END Destructor
+
+//+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+
+/// Takes a free slot for an accepted socket
+//+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+
+uint32_t Connection_Table::Add(SOCKET socket, uint16_t loop)
+{
+   uint32_t slot;
+
+   //
+   // 1. Take a free slot, adding a slab when none are left
+   while (_released.Pop(slot))
+   {
+      _free.push_back(slot);
+   }
+   if (_free.empty() && !Add_Slab())
+   {
+      return Socket_Vars::NO_CONNECTION;
+   }
+   slot = _free.back();
+   _free.pop_back();
+   uint32_t connection = Get_Id(slot);
+
+   //
+   // 2. Fill in the state, it joins an active list once handed off
+   Connection& state = Get(connection);
+   state.socket = socket;
+   state.active_position = 0;
+   state.loop.store(static_cast<uint16_t>(loop % _loop_count), std::memory_order_relaxed);
+   state.is_send_scheduled.store(false, std::memory_order_relaxed);
+   state.is_waiting_writable.store(false, std::memory_order_relaxed);
+   state.idle_timer = 0;
+   state.heartbeat_timer = 0;
+   state.last_receive_tick = 0;
+   state.groups.store(0, std::memory_order_relaxed);
+   state.is_too_slow.store(false, std::memory_order_relaxed);
+
+   return connection;
+}  // END Add()
+
+//+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+
+/// Hands a filled in connection to its event loop
+//+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+
+void Connection_Table::Hand_Off(uint32_t connection)
+{
+   Connection& state = Get(connection);
+
+   // The push publishes everything filled in since Add() to the loop
+   state.is_connected.store(true, std::memory_order_release);
+   _active_count.fetch_add(1, std::memory_order_relaxed);
+   _loops[state.loop.load(std::memory_order_relaxed)].handed_off.Push(connection);
+}  // END Hand_Off()
+
+//+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+
+/// Moves connections handed to an event loop onto its active list
+//+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+
+uint32_t Connection_Table::Adopt(uint16_t loop)
+{
+   uint32_t connection;
+   uint32_t adopted = 0;
+   std::vector<uint32_t>& active = _loops[loop].active;
+   std::lock_guard<std::mutex> lock(_loops[loop].active_mutex);
+
+   while (_loops[loop].handed_off.Pop(connection))
+   {
+      Get(connection).active_position = static_cast<uint32_t>(active.size());
+      active.push_back(connection);
+      adopted++;
+   }
+   return adopted;
+}  // END Adopt()
+
+//+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+
+/// Marks a connection closed and lists it for the sending thread
+//+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+
+void Connection_Table::Remove(uint32_t connection)
+{
+   Connection& state = Get(connection);
+   uint16_t loop = state.loop.load(std::memory_order_relaxed);
+
+   if (!state.is_connected.load(std::memory_order_acquire))
+   {
+      return;
+   }
+
+   //
+   // 1. Swap the last active connection of its loop into this one's position,
+   //    under the lock so a walk from another thread sees either list whole
+   {
+      std::lock_guard<std::mutex> lock(_loops[loop].active_mutex);
+      std::vector<uint32_t>& active = _loops[loop].active;
+      uint32_t moved = active.back();
+      active[state.active_position] = moved;
+      Get(moved).active_position = state.active_position;
+      active.pop_back();
+   }
+   _active_count.fetch_sub(1, std::memory_order_relaxed);
+
+   //
+   // 2. Stop new messages, the socket stays open until the sending thread
+   //    releases the slot so a send can never land on a reused handle,
+   //    a producer counted in before this sees it after, see Queue_Message(),
+   //    async sends parked on the queue are woken to find the client gone
+   state.is_connected.store(false, std::memory_order_seq_cst);
+   Get_Queues(connection).send_waiters.Wake();
+
+   //
+   // 3. The loop's sending thread owns the send queue, list the connection so
+   //    it drains the queue and releases the slot
+   _loops[loop].closed.Push(connection);
+}  // END Remove()
+
+//+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+
+/// Releases connections removed on an event loop
+//+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+
+void Connection_Table::Release_Closed(uint16_t loop)
+{
+   uint32_t connection;
+   std::vector<uint32_t> waiting;
+
+   while (_loops[loop].closed.Pop(connection))
+   {
+      //
+      // 1. A thread still inside Queue_Message() or Queue_Broadcast() may
+      //    push after the drain, the connection waits for it to leave
+      if (0 != Get(connection).producers.load(std::memory_order_seq_cst))
+      {
+         waiting.push_back(connection);
+         continue;
+      }
+
+      //
+      // 2. Claiming the scheduled flag keeps the connection off the pending
+      //    send list, a listing already there is popped on a later pass and
+      //    the connection waits for it, the slot is never reused before
+      if (Get(connection).is_send_scheduled.exchange(true, std::memory_order_acq_rel))
+      {
+         waiting.push_back(connection);
+         continue;
+      }
+
+      //
+      // 3. Nothing can reach it now, close the socket and free the slot
+      Release(connection);
+   }
+
+   for (uint32_t connection : waiting)
+   {
+      _loops[loop].closed.Push(connection);
+   }
+}  // END Release_Closed()
+
+//+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+
+/// Closes a removed connection's socket and returns its slot
+//+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+
+void Connection_Table::Release(uint32_t connection)
+{
+   Connection& state = Get(connection);
+   Buffers::Buffer_View message;
+   Buffers::Buffer_View broadcast;
+
+   //
+   // 1. Drop anything still queued or left unsent for the closed connection,
+   //    its references to shared broadcasts are let go of
+   while (Get_Queues(connection).send_queue.Pop(message))
+   {
+   }
+   while (Get_Queues(connection).broadcast_queue.Pop(broadcast))
+   {
+   }
+   message.Reset();
+   broadcast.Reset();
+   Get_Queues(connection).backlog.Clear();
+
+   //
+   // 2. Close the socket
+   closesocket(state.socket);
+   state.socket = INVALID_SOCKET;
+
+   //
+   // 3. Move the slot to its next generation, every id handed out for this
+   //    connection is refused from here on
+   state.generation.store(
+      ((connection >> Socket_Vars::CONNECTION_SLOT_BITS) + 1) & Socket_Vars::CONNECTION_GENERATION_MASK,
+      std::memory_order_release);
+
+   //
+   // 4. Hand the slot back to the accepting event loop thread, Add() clears
+   //    the scheduled flag claimed by Release_Closed()
+   _released.Push(connection & Socket_Vars::CONNECTION_SLOT_MASK);
+}  // END Release()
+
+//+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+
+/// Places a message on a connection's send queue
+//+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+
+bool Connection_Table::Queue_Message(uint32_t connection, Buffers::Buffer_View message)
+{
+   bool result = true;
+   Connection& state = Get(connection);
+
+   //
+   // 1. Count this thread in first, the slot is not released until it
+   //    leaves, so the checks below hold until the message is queued
+   state.producers.fetch_add(1, std::memory_order_seq_cst);
+
+   //
+   // 2. Place the message on the connection's own queue, an id from
+   //    before the slot was reused belongs to a client long gone
+   if (!Is_Current(connection)
+       ||
+       !state.is_connected.load(std::memory_order_seq_cst)
+       ||
+       !Get_Queues(connection).send_queue.Push(std::move(message)))
+   {
+      state.producers.fetch_sub(1, std::memory_order_seq_cst);
+      result &= false;
+      return result;
+   }
+
+   //
+   // 3. List the connection for its loop's sending thread
+   Schedule_Send(connection);
+   state.producers.fetch_sub(1, std::memory_order_seq_cst);
+
+   return result;
+}  // END Queue_Message()
+
+//+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+
+/// Places a reference to a broadcast on a connection's queue
+//+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+
+bool Connection_Table::Queue_Broadcast(uint32_t connection, const Buffers::Buffer_View& broadcast)
+{
+   bool result = true;
+   Connection& state = Get(connection);
+
+   //
+   // 1. Count this thread in first, as in Queue_Message()
+   state.producers.fetch_add(1, std::memory_order_seq_cst);
+
+   //
+   // 2. Only the reference is queued, every subscriber shares the buffer
+   if (!Is_Current(connection)
+       ||
+       !state.is_connected.load(std::memory_order_seq_cst)
+       ||
+       !Get_Queues(connection).broadcast_queue.Push(broadcast))
+   {
+      state.producers.fetch_sub(1, std::memory_order_seq_cst);
+      result &= false;
+      return result;
+   }
+
+   //
+   // 3. List the connection for its loop's sending thread
+   Schedule_Send(connection);
+   state.producers.fetch_sub(1, std::memory_order_seq_cst);
+
+   return result;
+}  // END Queue_Broadcast()
+
+//+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+
+/// Subscribes or unsubscribes a connection from a broadcast group
+//+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+
+bool Connection_Table::Set_Subscribed(uint32_t connection, uint32_t group, bool is_subscribed)
+{
+   bool result = true;
+   Connection& state = Get(connection);
+
+   if (Socket_Vars::MAX_BROADCAST_GROUPS <= group
+       ||
+       !Is_Current(connection)
+       ||
+       !state.is_connected.load(std::memory_order_acquire))
+   {
+      result &= false;
+      return result;
+   }
+
+   if (is_subscribed)
+   {
+      state.groups.fetch_or(uint64_t{ 1 } << group, std::memory_order_relaxed);
+   }
+   else
+   {
+      state.groups.fetch_and(~(uint64_t{ 1 } << group), std::memory_order_relaxed);
+   }
+
+   return result;
+}  // END Set_Subscribed()
+
+//+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+
+/// Adds a connection to its loop's pending send list
+//+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+
+void Connection_Table::Schedule_Send(uint32_t connection)
+{
+   Connection& state = Get(connection);
+
+   // A stale id is ignored, only the thread that flips the flag lists the connection
+   if (!Is_Current(connection))
+   {
+      return;
+   }
+   if (false == state.is_send_scheduled.exchange(true, std::memory_order_acq_rel))
+   {
+      _loops[state.loop.load(std::memory_order_acquire)].pending_sends.Push(connection);
+   }
+}  // END Schedule_Send()
+
+//+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+
+/// Pops connections with queued messages
+//+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+
+size_t Connection_Table::Take_Pending_Sends(uint16_t loop, uint32_t* connections, size_t max_count)
+{
+   size_t count = _loops[loop].pending_sends.Pop_Batch(connections, max_count);
+
+   // Clear the flags before the queues are drained so a message
+   // pushed during the drain lists the connection again
+   for (size_t i = 0; i < count; i++)
+   {
+      Get(connections[i]).is_send_scheduled.store(false, std::memory_order_release);
+   }
+
+   return count;
+}  // END Take_Pending_Sends()
+
+//+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+
+/// Checks no connection's strand has a message pending
+//+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+
+bool Connection_Table::Is_Idle()
+{
+   for (uint32_t connection = 0; connection < Get_Capacity(); connection++)
+   {
+      if (!Get_Queues(connection).strand.Is_Idle())
+      {
+         return false;
+      }
+   }
+   return true;
+}  // END Is_Idle()
@@ -0,0 +1,586 @@
+//+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+
+// 
+//  ___________ __  .__                       ___________
+//  \_   _____//  |_|  |__ _____    ____      \_   _____/
+//   |    __)_\   __\  |  \\__  \  /    \      |    __)_ 
+//   |        \|  | |   Y  \/ __ \|   |  \     |        \
+//  /_______  /|__| |___|  (____  /___|  / /\ /_______  /
+//          \/           \/     \/     \/  \/         \/ 
+// 
+// Connection Table Header File
+//
+//  Author   Date         Description
+// --------------------------------------------------------
+//  ECE      10-17-2026   Initial Implementation
+//  ECE      10-17-2026   Received messages go on the server's receive queue
+//  ECE      10-17-2026   Connections are spread across event loops
+//  ECE      10-17-2026   Each connection's messages are handled on its own strand
+//  ECE      10-17-2026   Each connection has a channel coroutines receive from
+//  ECE      10-17-2026   Added Is_Idle so a destroyed server waits for its handlers
+//  ECE      10-17-2026   Unsent bytes wait in a backlog until the socket is writable
+//  ECE      10-17-2026   Received messages carry when they were queued
+//  ECE      10-17-2026   Zero-copy sends wait in the backlog until the kernel is done
+//  ECE      10-17-2026   File transfers are sent from the backlog a chunk at a time
+//  ECE      10-17-2026   Connections carry their idle and heartbeat timers
+//  ECE      10-17-2026   Broadcast groups and a queue of shared broadcast buffers
+//  ECE      10-17-2026   Received messages carry the multicast group they arrived on
+//  ECE      10-17-2026   Connection ids carry their slot's generation
+//  ECE      10-17-2026   Backlogs name the shared memory channel generation they wait for
+//  ECE      10-17-2026   Queued messages are held in pooled buffers
+//  ECE      10-17-2026   Active lists may be walked from any thread with For_Each_Active
+//  ECE      10-17-2026   Received datagrams carry their own sender
+//  ECE      10-17-2026   A zero-copy send gathers several short messages
+//  ECE      10-17-2026   Async sends park on a full queue, strands keep cells for open and close
+//  ECE      10-17-2026   Socket send queues hold Queued_Send, datagrams keep their destination
+//+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+
+
+#pragma once
+
+#include "Async_Task.h"
+#include "Buffer_Pool.h"
+#include "Lock_Free_Queue.h"
+#include "Message_Framing.h"
+#include "Timer_Wheel.h"
+#include "Work_Pool.h"
+
+#include <WinSock2.h>
+#include <WS2tcpip.h>
+#include <atomic>
+#include <chrono>
+#include <memory>
+#include <mutex>
+#include <string>
+#include <vector>
+
+namespace Socket_Vars
+{
+   // Most messages waiting on each accepted connection's send queue
+   constexpr size_t CONNECTION_QUEUE_CAPACITY{ 64 };
+
+   // Most broadcasts waiting on each accepted connection, a subscriber
+   // this far behind is handled by its server's Slow_Policy
+   constexpr size_t BROADCAST_QUEUE_CAPACITY{ 256 };
+
+   // Groups a connection may subscribe to, a bit each
+   constexpr uint32_t MAX_BROADCAST_GROUPS{ 64 };
+
+   // Group that reaches every connection, subscribed or not
+   constexpr uint32_t BROADCAST_ALL{ 0xFFFFFFFF };
+
+   // Messages under the zero-copy threshold gathered into one overlapped send
+   constexpr size_t ZERO_COPY_GATHER{ 16 };
+
+   // Most received messages waiting on each accepted connection's handler
+   constexpr size_t CONNECTION_RECEIVE_CAPACITY{ 128 };
+
+   // Strand cells kept back from messages for a connection's open and close
+   // events, so the event loop never waits on a slow handler to post them
+   constexpr size_t CONNECTION_EVENT_CELLS{ 2 };
+
+   // Connection slots are allocated a slab at a time, slabs never move
+   constexpr uint32_t CONNECTIONS_PER_SLAB{ 256 };
+   constexpr uint32_t MAX_CONNECTION_SLABS{ 256 };
+   constexpr uint32_t MAX_CONNECTIONS{ CONNECTIONS_PER_SLAB * MAX_CONNECTION_SLABS };
+
+   // A connection id is its slot in the low bits and the slot's generation
+   // above them, the generation moves on every time the slot is released so
+   // an id held past its connection's close never reaches the next client
+   constexpr uint32_t CONNECTION_SLOT_BITS{ 16 };
+   constexpr uint32_t CONNECTION_SLOT_MASK{ (uint32_t{ 1 } << CONNECTION_SLOT_BITS) - 1 };
+   constexpr uint32_t CONNECTION_GENERATION_MASK{ 0x7FFF };   // Keeps every id under NO_CONNECTION
+   static_assert(MAX_CONNECTIONS == CONNECTION_SLOT_MASK + 1, "Connection slots must fill the id's slot bits");
+
+   // Connection id used when an event or message is not for a connection
+   constexpr uint32_t NO_CONNECTION{ 0xFFFFFFFF };
+
+   // Group id used when a datagram did not arrive on a joined multicast group
+   constexpr uint32_t NO_GROUP{ 0xFFFFFFFF };
+
+   enum Slow_Policy : uint8_t
+   {
+      SLOW_DROP         = 1,  // A full broadcast queue loses the message
+      SLOW_DISCONNECT   = 2   // A full broadcast queue drops the connection
+   };
+
+   // What a Received_Message carries, the connection events are only
+   // posted for sockets set to async
+   enum Receive_Event : uint8_t
+   {
+      MESSAGE_RECEIVED    = 0,
+      CONNECTION_OPENED   = 1,   // Accepted, before any of its messages
+      CONNECTION_CLOSED   = 2    // Disconnected, after all of its messages
+   };
+
+   // A received message, a view into the pooled buffer the socket read it into,
+   // the buffer goes back to the pool once every view of it is released
+   struct Received_Message
+   {
+      Buffers::Buffer_View message;
+      uint32_t connection;             // Accepted connection it arrived on, or NO_CONNECTION
+      Receive_Event event = MESSAGE_RECEIVED;
+      std::chrono::steady_clock::time_point queued_at{};   // Posted to its strand, for the dwell histogram
+      uint32_t group = NO_GROUP;       // Multicast group a datagram arrived on, from Join_Group()
+      SOCKADDR_INET sender{};          // Sender a datagram reply goes back to, si_family 0 if none
+   };
+
+   // Received messages waiting on the handler pool, handled one at a time in order
+   typedef Work_Pool::Strand<Received_Message> Message_Strand;
+
+   // One long message, or several short ones, sent straight from their own
+   // memory, with no send buffer Winsock locks the pages and sends from them
+   // so they must stay put until the completion routine runs on the sending
+   // thread, which holds the send through self until then
+   struct Zero_Copy_Send
+   {
+      WSAOVERLAPPED overlapped;              // hEvent points back here
+      Buffers::Buffer_View messages[ZERO_COPY_GATHER];
+      size_t message_count = 0;
+      char headers[ZERO_COPY_GATHER][Framing::MAX_HEADER_SIZE];
+      WSABUF buffers[2 * ZERO_COPY_GATHER];
+      uint32_t socket_index = 0;             // Scheduled again on completion
+      uint16_t loop = 0;
+      bool is_complete = false;              // Set by the completion routine
+      DWORD error = 0;
+      DWORD bytes_sent = 0;
+      std::shared_ptr<Zero_Copy_Send> self;  // Released by the completion routine
+   };
+
+   // Told how far a file transfer has got after every chunk, on the sending
+   // thread so it must not block, error is 0 until the transfer fails
+   typedef void (*File_Progress_Handler)(uint32_t socket_index, uint64_t bytes_sent, uint64_t total_bytes, DWORD error);
+
+   // A file sent by TransmitFile() a chunk at a time, the kernel reads it
+   // straight into the socket, the overlapped event is registered with a
+   // thread pool wait that schedules the socket again once a chunk is done
+   struct File_Send
+   {
+      OVERLAPPED overlapped{};               // Offset is where the chunk in flight starts
+      HANDLE file = INVALID_HANDLE_VALUE;
+      HANDLE wait = nullptr;                 // Registered wait on overlapped.hEvent
+      SOCKET socket = INVALID_SOCKET;        // Socket the chunk in flight is on
+      char header[Framing::MAX_HEADER_SIZE];
+      DWORD header_size = 0;                 // Frame prefix, sent ahead of the first chunk
+      uint64_t offset = 0;                   // Next byte of the file to send
+      uint64_t end = 0;                      // One past the last byte to send
+      uint64_t total_bytes = 0;
+      uint64_t bytes_sent = 0;
+      DWORD chunk_size = 0;                  // File bytes of the chunk in flight
+      bool is_pending = false;               // A chunk is in flight
+      uint32_t socket_index = 0;             // Scheduled again on every chunk
+      uint16_t loop = 0;
+      File_Progress_Handler handler = nullptr;
+
+      File_Send() = default;
+      File_Send(const File_Send&) = delete;
+      File_Send& operator=(const File_Send&) = delete;
+
+      // The wait is unregistered first so nothing else takes the event,
+      // then a chunk still in flight is cancelled and waited out
+      ~File_Send()
+      {
+         DWORD bytes;
+
+         if (nullptr != wait)
+         {
+            UnregisterWaitEx(wait, INVALID_HANDLE_VALUE);
+         }
+         if (is_pending)
+         {
+            CancelIoEx(reinterpret_cast<HANDLE>(socket), &overlapped);
+            GetOverlappedResult(reinterpret_cast<HANDLE>(socket), &overlapped, &bytes, TRUE);
+         }
+         if (nullptr != overlapped.hEvent)
+         {
+            CloseHandle(overlapped.hEvent);
+         }
+         if (INVALID_HANDLE_VALUE != file)
+         {
+            CloseHandle(file);
+         }
+      }
+   };
+
+   // A message on a socket's send queue, a datagram reply names the sender
+   // it answers, anything else has si_family 0 and goes where the socket
+   // sends, see Universal_Socket::Get_Send_Address()
+   struct Queued_Send
+   {
+      Buffers::Buffer_View message;
+      SOCKADDR_INET destination{};
+   };
+
+   // What a write left unsent because the socket buffer was full, it goes
+   // before anything else once the socket is writable again, nothing more
+   // is popped from the send queue meanwhile, the sending thread only
+   struct Send_Backlog
+   {
+      SOCKET socket = INVALID_SOCKET;        // Socket the bytes were meant for
+      uint64_t generation = 0;               // Shared memory peer the messages were meant for
+      std::string stream;                    // TCP bytes not yet written, from offset
+      size_t offset = 0;
+      std::vector<std::shared_ptr<Zero_Copy_Send>> zero_copy;   // In flight, in the order sent
+      std::vector<Buffers::Buffer_View> messages;   // Shared memory records, or TCP messages behind
+                                                   // a zero-copy send, not yet sent, in order
+      std::vector<Queued_Send> datagrams;    // UDP datagrams not yet sent, in order, each with its destination
+      std::unique_ptr<File_Send> file;       // File transfer under way, ahead of messages
+
+      inline bool Is_Empty() const { return stream.size() == offset && zero_copy.empty() && messages.empty() && datagrams.empty() && nullptr == file; }
+
+      // Only a zero-copy send or a file chunk holds the backlog up, its
+      // completion schedules the socket again so there is no need to poll
+      // it for writable
+      inline bool Is_Waiting_Completion() const { return stream.size() == offset && (!zero_copy.empty() || nullptr != file); }
+
+      inline void Clear()
+      {
+         stream.clear();
+         offset = 0;
+         zero_copy.clear();
+         messages.clear();
+         datagrams.clear();
+         file.reset();
+      }
+   };
+
+   // Async sends parked on a full send queue, handed back to the handler
+   // pool once the sending thread makes room, the count lets the sending
+   // thread skip the lock while nothing waits
+   struct Send_Waiters
+   {
+      std::mutex mutex;
+      std::vector<Work_Pool::Task*> tasks;   // Under mutex
+      std::atomic<size_t> count{ 0 };        // Parked, or about to try once more
+
+      // Called after making room, a task counted in after the count was
+      // read here made its last try after the room was made
+      inline void Wake()
+      {
+         std::vector<Work_Pool::Task*> woken;
+
+         std::atomic_thread_fence(std::memory_order_seq_cst);
+         if (0 == count.load(std::memory_order_seq_cst))
+         {
+            return;
+         }
+         {
+            std::lock_guard<std::mutex> lock(mutex);
+            woken.swap(tasks);
+            count.fetch_sub(woken.size(), std::memory_order_seq_cst);
+         }
+         for (Work_Pool::Task* task : woken)
+         {
+            Work_Pool::Handler_Pool().Submit(task);
+         }
+      }
+   };
+
+}  // END namespace Socket_Vars
+
+//+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+
+/// @brief   State the event loop touches on every event for an
+/// @brief   accepted connection, kept apart from the queues so
+/// @brief   walking the connections stays within a few cache lines
+//+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+
+struct Connection
+{
+   SOCKET socket;
+   uint32_t active_position;              // Position in its event loop's active list
+   std::atomic<uint16_t> loop;            // Event loop polling and sending for it
+   std::atomic<bool> is_connected;
+   std::atomic<bool> is_send_scheduled;   // Already on the pending send list
+   std::atomic<bool> is_waiting_writable; // Backlog waits for the socket to drain
+   Timers::Timer_Id idle_timer;           // On its loop's timer wheel, 0 if none
+   Timers::Timer_Id heartbeat_timer;
+   uint64_t last_receive_tick;            // Wheel tick of the last read
+   std::atomic<uint64_t> groups;          // Broadcast groups subscribed to, a bit each
+   std::atomic<bool> is_too_slow;         // Fell behind on broadcasts, its loop drops it
+   std::atomic<uint32_t> generation;      // Moves on at every release, the high bits of its id
+   std::atomic<uint32_t> producers;       // Threads queueing to it, it is not released meanwhile
+};
+
+//+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+
+/// @brief   Send queue owned by one connection, the decoder
+/// @brief   splitting its stream into messages, the strand whole
+/// @brief   messages are handled on in the order they arrived, and
+/// @brief   the channel an async handler delivers them to
+//+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+
+struct Connection_Queues
+{
+   Lock_Free::MPSC_Queue<Buffers::Buffer_View> send_queue;
+   Lock_Free::MPSC_Queue<Buffers::Buffer_View> broadcast_queue;   // Framed, shared by every subscriber
+   Socket_Vars::Send_Backlog backlog;     // Its event loop's sending thread only
+   Framing::Frame_Decoder decoder;        // Its event loop's receiving thread only
+   Socket_Vars::Message_Strand strand;    // Posted by its event loop, run on the handler pool
+   Socket_Vars::Send_Waiters send_waiters;   // Async sends waiting on a full send_queue
+   Async::Channel<Socket_Vars::Received_Message> received;   // Filled by its strand when async
+};
+
+//+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+
+/// @brief   Connections one event loop polls and sends for,
+/// @brief   touched by that loop's threads and the accepting loop
+//+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+
+struct Loop_Connections
+{
+   std::vector<uint32_t> active;                    // Changed by the receiving thread of the loop only
+   std::mutex active_mutex;                         // Held to change active, and to walk it from elsewhere
+   Lock_Free::MPSC_Queue<uint32_t> handed_off;      // Accepted for the loop, not yet polled
+   Lock_Free::MPSC_Queue<uint32_t> pending_sends;   // Waiting on the loop's sending thread
+   Lock_Free::MPSC_Queue<uint32_t> closed;          // Removed, waiting to be released
+};
+
+class Connection_Table
+{
+public:
+
+   //+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+
+   /// @brief   Constructor
+   /// @param   uint16_t          Number of event loops connections go to
+   /// @param   Handler           Called on the handler pool for every message
+   /// @param   void*             Passed to the handler
+   //+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+
+   Connection_Table(uint16_t loop_count, Socket_Vars::Message_Strand::Handler handler, void* context);
+
+   //+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+
+   /// @brief   Destructor, closes any connection still open
+   //+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+
+   ~Connection_Table();
+
+   //+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+
+   /// @brief   Takes a free slot for an accepted socket, the
+   /// @brief   accepting event loop thread only
+   /// @param   SOCKET            Accepted socket
+   /// @param   uint16_t          Event loop the connection will belong to
+   /// @return  uint32_t          Connection id or NO_CONNECTION
+   //+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+
+   uint32_t Add(SOCKET socket, uint16_t loop);
+
+   //+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+
+   /// @brief   Hands a connection filled in after Add() to its
+   /// @brief   event loop, which polls it from its next pass
+   /// @param   uint32_t          Connection id
+   /// @return  None
+   //+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+
+   void Hand_Off(uint32_t connection);
+
+   //+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+
+   /// @brief   Moves connections handed to an event loop onto its
+   /// @brief   active list, that loop's receiving thread only
+   /// @param   uint16_t          Event loop
+   /// @return  uint32_t          Number adopted, the last of Get_Active()
+   //+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+
+   uint32_t Adopt(uint16_t loop);
+
+   //+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+
+   /// @brief   Marks a connection closed and lists it for its loop's
+   /// @brief   sending thread, which closes the socket and releases
+   /// @brief   the slot, the connection's receiving thread only
+   /// @param   uint32_t          Connection id
+   /// @return  None
+   //+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+
+   void Remove(uint32_t connection);
+
+   //+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+
+   /// @brief   Releases every connection removed on an event loop
+   /// @brief   that is no longer on its pending send list, the rest
+   /// @brief   wait for the next call, that loop's sending thread only
+   /// @param   uint16_t          Event loop
+   /// @return  None
+   //+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+
+   void Release_Closed(uint16_t loop);
+
+   //+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+
+   /// @brief   Places a message on a connection's send queue and
+   /// @brief   adds the connection to its loop's pending send list
+   /// @param   uint32_t          Connection id
+   /// @param   Buffer_View       Message to be sent, in a pooled buffer
+   /// @return  bool              False if the connection is closed, full or
+   /// @return                    the id is from before its slot was reused
+   //+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+
+   bool Queue_Message(uint32_t connection, Buffers::Buffer_View message);
+
+   //+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+
+   /// @brief   Places a reference to a framed broadcast on a
+   /// @brief   connection's broadcast queue and adds the connection
+   /// @brief   to its loop's pending send list, nothing is copied
+   /// @param   uint32_t          Connection id
+   /// @param   Buffer_View       Broadcast, shared with the other subscribers
+   /// @return  bool              False if the connection is closed, full or
+   /// @return                    the id is from before its slot was reused
+   //+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+
+   bool Queue_Broadcast(uint32_t connection, const Buffers::Buffer_View& broadcast);
+
+   //+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+
+   /// @brief   Subscribes a connection to, or unsubscribes it from,
+   /// @brief   a broadcast group, safe from any thread
+   /// @param   uint32_t          Connection id
+   /// @param   uint32_t          Group, under MAX_BROADCAST_GROUPS
+   /// @param   bool              True to subscribe, false to unsubscribe
+   /// @return  bool              False if the connection is closed or the
+   /// @return                    id is from before its slot was reused
+   //+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+
+   bool Set_Subscribed(uint32_t connection, uint32_t group, bool is_subscribed);
+
+   //+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+
+   /// @brief   Adds a connection to its loop's pending send list,
+   /// @brief   a connection already listed is not added twice and
+   /// @brief   an id from before its slot was reused is ignored
+   /// @param   uint32_t          Connection id
+   /// @return  None
+   //+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+
+   void Schedule_Send(uint32_t connection);
+
+   //+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+
+   /// @brief   Pops up to max_count of an event loop's connections
+   /// @brief   with queued messages, that loop's sending thread only
+   /// @param   uint16_t          Event loop
+   /// @param   uint32_t*         Returning connection ids
+   /// @param   size_t            Most connections to pop
+   /// @return  size_t            Number of connections popped
+   //+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+
+   size_t Take_Pending_Sends(uint16_t loop, uint32_t* connections, size_t max_count);
+
+   //+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+
+   /// @brief   Gets a connection's state, the slot stays valid
+   /// @brief   for the life of the table, a slot index works too
+   /// @param   uint32_t          Connection id
+   /// @return  Connection&       Connection state
+   //+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+
+   inline Connection& Get(uint32_t connection)
+   {
+      uint32_t slot = connection & Socket_Vars::CONNECTION_SLOT_MASK;
+
+      return _states[slot / Socket_Vars::CONNECTIONS_PER_SLAB].load(std::memory_order_acquire)
+         [slot % Socket_Vars::CONNECTIONS_PER_SLAB];
+   }
+
+   //+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+
+   /// @brief   Gets a connection's queues
+   /// @param   uint32_t          Connection id
+   /// @return  Connection_Queues& Connection queues
+   //+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+
+   inline Connection_Queues& Get_Queues(uint32_t connection)
+   {
+      uint32_t slot = connection & Socket_Vars::CONNECTION_SLOT_MASK;
+
+      return _queues[slot / Socket_Vars::CONNECTIONS_PER_SLAB].load(std::memory_order_acquire)
+         [slot % Socket_Vars::CONNECTIONS_PER_SLAB];
+   }
+
+   //+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+
+   /// @brief   Gets the id of the connection now in a slot
+   /// @param   uint32_t          Slot index, below Get_Capacity()
+   /// @return  uint32_t          Connection id
+   //+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+
+   inline uint32_t Get_Id(uint32_t slot)
+   {
+      return (Get(slot).generation.load(std::memory_order_acquire) << Socket_Vars::CONNECTION_SLOT_BITS)
+         | (slot & Socket_Vars::CONNECTION_SLOT_MASK);
+   }
+
+   //+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+
+   /// @brief   Checks an id is still its slot's connection, one
+   /// @brief   kept past a close names a slot since reused
+   /// @param   uint32_t          Connection id
+   /// @return  bool              True if the slot has not been released since
+   //+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+
+   inline bool Is_Current(uint32_t connection)
+   {
+      return Get(connection).generation.load(std::memory_order_acquire)
+         == (connection >> Socket_Vars::CONNECTION_SLOT_BITS);
+   }
+
+   //+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+
+   /// @brief   Dense list of an event loop's open connections,
+   /// @brief   that loop's receiving thread only
+   /// @param   uint16_t          Event loop
+   /// @return  std::vector&      Ids of open connections
+   //+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+
+   inline const std::vector<uint32_t>& Get_Active(uint16_t loop) { return _loops[loop].active; }
+
+   //+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+
+   /// @brief   Calls visit with the id of every open connection on
+   /// @brief   an event loop, safe from any thread, the loop adopts
+   /// @brief   and removes nothing until the walk is done
+   /// @param   uint16_t          Event loop
+   /// @param   Visitor           Called with each connection id
+   /// @return  None
+   //+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+
+   template <typename Visitor>
+   void For_Each_Active(uint16_t loop, Visitor visit)
+   {
+      std::lock_guard<std::mutex> lock(_loops[loop].active_mutex);
+      for (uint32_t connection : _loops[loop].active)
+      {
+         visit(connection);
+      }
+   }
+
+   //+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+
+   /// @brief   Gets the number of event loops connections go to
+   /// @return  uint16_t          _loop_count
+   //+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+
+   inline uint16_t Get_Loop_Count() const { return _loop_count; }
+
+   //+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+
+   /// @brief   Number of open connections, safe from any thread
+   /// @return  uint32_t          _active_count
+   //+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+
+   inline uint32_t Get_Active_Count() { return _active_count.load(std::memory_order_relaxed); }
+
+   //+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+
+   /// @brief   Checks no connection's strand has a message
+   /// @brief   pending, the table may be deleted once it is idle
+   /// @brief   and no event loop polls it anymore
+   /// @return  bool              True if every strand is idle
+   //+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+
+   bool Is_Idle();
+
+   //+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+
+   /// @brief   Number of allocated slots, every index below it
+   /// @brief   may be passed to Get(), safe from any thread
+   /// @return  uint32_t          Slots in every allocated slab
+   //+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+
+   inline uint32_t Get_Capacity()
+   {
+      return _slab_count.load(std::memory_order_acquire) * Socket_Vars::CONNECTIONS_PER_SLAB;
+   }
+
+private:
+
+   // Slabs of connection state and queues, allocated on demand
+   std::atomic<Connection*> _states[Socket_Vars::MAX_CONNECTION_SLABS];
+   std::atomic<Connection_Queues*> _queues[Socket_Vars::MAX_CONNECTION_SLABS];
+   std::atomic<uint32_t> _slab_count;
+
+   // Every connection's strand hands its messages to this handler
+   Socket_Vars::Message_Strand::Handler _handler;
+   void* _handler_context;
+
+   // Free slots, reused most recently freed first while still warm
+   std::vector<uint32_t> _free;
+
+   // Slots released by the sending threads, moved to _free on the next Add
+   Lock_Free::MPSC_Queue<uint32_t> _released;
+
+   // Open connections of each event loop, removal swaps the last entry
+   // of the loop's active list into the hole
+   std::unique_ptr<Loop_Connections[]> _loops;
+   uint16_t _loop_count;
+   std::atomic<uint32_t> _active_count;
+
+   //+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+
+   /// @brief   Allocates the next slab and frees its slots
+   /// @return  bool              False if every slab is in use
+   //+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+
+   bool Add_Slab();
+
+   //+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+
+   /// @brief   Closes a removed connection's socket and returns its
+   /// @brief   slot for reuse once its send queue is drained, under
+   /// @brief   the next generation so its old id is refused
+   /// @param   uint32_t          Connection id
+   /// @return  None
+   //+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+
+   void Release(uint32_t connection);
+
+};  // END class Connection_Table
@@ -12,6 +12,11 @@
 //  Author   Date         Description
 // --------------------------------------------------------
 //  ECE      08-11-2024   Initial Implementation
+//  ECE      10-17-2026   Join the socket threads instead of spinning
+//  ECE      10-17-2026   Added the processing thread for received messages
+//  ECE      10-17-2026   Receiving and sending threads for every event loop
+//  ECE      10-17-2026   Received messages are handled on the handler pool
+//  ECE      10-17-2026   Messages go to the asynchronous log
 //+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+
 
 #include "Universal_Socket.h"
@@ -27,26 +32,42 @@
 int main()
 {
    bool result = true;
-   printf("This program will be the server!\n");
+   unsigned int hardware_threads = std::thread::hardware_concurrency();
+   uint16_t thread_count;
+   std::vector<std::thread> socket_threads;
+   Log::Write<Log::LEVEL_INFO>("This program will be the server!\n");
+
+   // One event loop per hardware thread, must be set before any socket
+   // is created, a single loop when the count is unknown
+   thread_count = static_cast<uint16_t>(
+      (0 == hardware_threads) ? 1 :
+      (Socket_Vars::MAX_EVENT_LOOPS < hardware_threads) ? Socket_Vars::MAX_EVENT_LOOPS : hardware_threads);
+   Socket_Vars::event_loop_count = thread_count;
+
+   // Every received message is handled on the handler pool, one worker per
+   // hardware thread, the event loops only move bytes
+   Work_Pool::Handler_Pool().Start(thread_count);
 
    // Setup_Comms() handles the creation of the sockets
    result &= Comms_Interface::Setup_Comms();
    if (!result)
    {
-      printf("Problem occurred setting up communication interfaces!\n");
+      Log::Write<Log::LEVEL_ERROR>("Problem occurred setting up communication interfaces!\n");
    }
 
    // Socket threads to handle main processing loop 
-   // for receiving and sending through all sockets
-   std::thread Socket_Receiving_Thread(Comms_Interface::Socket_Receiving_Thread);
-   std::thread Socket_Sending_Thread(Comms_Interface::Socket_Sending_Thread);
-
-   Socket_Sending_Thread.detach();
-   Socket_Receiving_Thread.detach();
+   // for receiving and sending through each event loop's sockets
+   for (uint16_t loop = 0; loop < Socket_Vars::event_loop_count; loop++)
+   {
+      socket_threads.emplace_back(Comms_Interface::Socket_Receiving_Thread, loop);
+      socket_threads.emplace_back(Comms_Interface::Socket_Sending_Thread, loop);
+   }
 
-   while (true)
+   // The threads run for the life of the program,
+   // block here instead of spinning until they exit
+   for (std::thread& socket_thread : socket_threads)
    {
-      // Loop forever
+      socket_thread.join();
    }
 
    return 0;
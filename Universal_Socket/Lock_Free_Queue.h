@@ -0,0 +1,442 @@
+//+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+
+// 
+//  ___________ __  .__                       ___________
+//  \_   _____//  |_|  |__ _____    ____      \_   _____/
+//   |    __)_\   __\  |  \\__  \  /    \      |    __)_ 
+//   |        \|  | |   Y  \/ __ \|   |  \     |        \
+//  /_______  /|__| |___|  (____  /___|  / /\ /_______  /
+//          \/           \/     \/     \/  \/         \/ 
+// 
+// Lock Free Queue Header File
+//
+//  Author   Date         Description
+// --------------------------------------------------------
+//  ECE      10-17-2026   Initial Implementation
+//  ECE      10-17-2026   Unbounded intrusive queue, moved from the work pool
+//+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+
+
+#pragma once
+
+#include <atomic>
+#include <cstddef>
+#include <cstdint>
+#include <memory>
+#include <utility>
+
+namespace Lock_Free
+{
+   // Producer and consumer positions live on separate cache lines
+   constexpr size_t CACHE_LINE_SIZE{ 64 };
+
+   //+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+
+   /// @brief   Bounded multi-producer, single-consumer ring,
+   /// @brief   any thread may push, only one thread may pop.
+   /// @brief   Every cell carries a sequence number, a cell is
+   /// @brief   free for position p when its sequence equals p
+   /// @brief   and holds a value when its sequence is p + 1
+   //+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+
+   template <typename T>
+   class MPSC_Queue
+   {
+   public:
+
+      //+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+
+      /// @brief   Allocates the ring, must be called before use
+      /// @param   size_t            Capacity, rounded up to a power of two
+      /// @return  None
+      //+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+
+      void Initialize(size_t capacity)
+      {
+         size_t size = 2;
+         while (size < capacity)
+         {
+            size <<= 1;
+         }
+
+         _cells.reset(new Cell[size]);
+         _mask = size - 1;
+         for (size_t i = 0; i < size; i++)
+         {
+            _cells[i].sequence.store(i, std::memory_order_relaxed);
+         }
+         _enqueue_position.store(0, std::memory_order_relaxed);
+         _dequeue_position = 0;
+      }
+
+      //+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+
+      /// @brief   Pushes one item, safe from any thread
+      /// @param   T                 Item, moved into the ring
+      /// @return  bool              False if the ring is full
+      //+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+
+      bool Push(T item)
+      {
+         return Push_Batch(&item, 1);
+      }
+
+      //+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+
+      /// @brief   Pushes a run of items with a single claim, the
+      /// @brief   items stay contiguous and in order in the ring
+      /// @param   T*                Items, moved into the ring
+      /// @param   size_t            Number of items
+      /// @return  bool              False if the run does not fit,
+      /// @return                    nothing is pushed in that case
+      //+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+
+      bool Push_Batch(T* items, size_t count)
+      {
+         size_t position = _enqueue_position.load(std::memory_order_relaxed);
+
+         if (0 == count || _mask < count - 1)
+         {
+            return 0 == count;
+         }
+
+         //
+         // 1. Claim count cells, the consumer frees cells in order so the
+         //    run is free once its last cell is free for this lap
+         while (true)
+         {
+            size_t last = position + count - 1;
+            size_t sequence = _cells[last & _mask].sequence.load(std::memory_order_acquire);
+            intptr_t difference = static_cast<intptr_t>(sequence) - static_cast<intptr_t>(last);
+
+            if (0 == difference)
+            {
+               if (_enqueue_position.compare_exchange_weak(position, position + count, std::memory_order_relaxed))
+               {
+                  break;
+               }
+            }
+            else if (0 > difference)
+            {
+               return false;    // Full
+            }
+            else
+            {
+               position = _enqueue_position.load(std::memory_order_relaxed);
+            }
+         }
+
+         //
+         // 2. Fill and publish each claimed cell
+         for (size_t i = 0; i < count; i++)
+         {
+            Cell& cell = _cells[(position + i) & _mask];
+            cell.value = std::move(items[i]);
+            cell.sequence.store(position + i + 1, std::memory_order_release);
+         }
+
+         return true;
+      }
+
+      //+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+
+      /// @brief   Pops one item, consumer thread only
+      /// @param   T&                Returning item
+      /// @return  bool              False if the ring is empty
+      //+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+
+      bool Pop(T& item)
+      {
+         return 1 == Pop_Batch(&item, 1);
+      }
+
+      //+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+
+      /// @brief   Pops up to max_count items, consumer thread only
+      /// @param   T*                Returning items
+      /// @param   size_t            Most items to pop
+      /// @return  size_t            Number of items popped
+      //+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+
+      size_t Pop_Batch(T* items, size_t max_count)
+      {
+         size_t popped = 0;
+
+         while (popped < max_count)
+         {
+            Cell& cell = _cells[_dequeue_position & _mask];
+            if (cell.sequence.load(std::memory_order_acquire) != _dequeue_position + 1)
+            {
+               break;   // Empty, or the next producer has not published yet
+            }
+
+            items[popped++] = std::move(cell.value);
+            cell.sequence.store(_dequeue_position + _mask + 1, std::memory_order_release);
+            _dequeue_position++;
+         }
+
+         return popped;
+      }
+
+      //+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+
+      /// @brief   Checks for a published item, consumer thread only
+      /// @return  bool              True if nothing can be popped
+      //+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+
+      bool Empty()
+      {
+         return _cells[_dequeue_position & _mask].sequence.load(std::memory_order_acquire) != _dequeue_position + 1;
+      }
+
+   private:
+
+      struct Cell
+      {
+         std::atomic<size_t> sequence;
+         T value;
+      };
+
+      std::unique_ptr<Cell[]> _cells;
+      size_t _mask = 0;
+      alignas(CACHE_LINE_SIZE) std::atomic<size_t> _enqueue_position{ 0 };
+      alignas(CACHE_LINE_SIZE) size_t _dequeue_position = 0;
+
+   };  // END class MPSC_Queue
+
+   //+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+
+   /// @brief   Bounded single-producer, single-consumer ring,
+   /// @brief   one thread pushes and one thread pops
+   //+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+
+   template <typename T>
+   class SPSC_Queue
+   {
+   public:
+
+      //+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+
+      /// @brief   Allocates the ring, must be called before use
+      /// @param   size_t            Capacity, rounded up to a power of two
+      /// @return  None
+      //+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+
+      void Initialize(size_t capacity)
+      {
+         size_t size = 2;
+         while (size < capacity)
+         {
+            size <<= 1;
+         }
+
+         _items.reset(new T[size]);
+         _mask = size - 1;
+         _head.store(0, std::memory_order_relaxed);
+         _tail.store(0, std::memory_order_relaxed);
+         _cached_head = 0;
+         _cached_tail = 0;
+      }
+
+      //+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+
+      /// @brief   Pushes one item, producer thread only
+      /// @param   T                 Item, moved into the ring
+      /// @return  bool              False if the ring is full
+      //+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+
+      bool Push(T item)
+      {
+         return 1 == Push_Batch(&item, 1);
+      }
+
+      //+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+
+      /// @brief   Pushes as many items as fit, producer thread only,
+      /// @brief   published to the consumer with a single store
+      /// @param   T*                Items, moved into the ring
+      /// @param   size_t            Number of items
+      /// @return  size_t            Number of items pushed
+      //+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+
+      size_t Push_Batch(T* items, size_t count)
+      {
+         size_t tail = _tail.load(std::memory_order_relaxed);
+
+         // Only reload the consumer's position when the cached one says full
+         if (_mask + 1 < tail - _cached_head + count)
+         {
+            _cached_head = _head.load(std::memory_order_acquire);
+         }
+
+         size_t space = _mask + 1 - (tail - _cached_head);
+         size_t pushed = (count < space) ? count : space;
+         for (size_t i = 0; i < pushed; i++)
+         {
+            _items[(tail + i) & _mask] = std::move(items[i]);
+         }
+
+         _tail.store(tail + pushed, std::memory_order_release);
+         return pushed;
+      }
+
+      //+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+
+      /// @brief   Pops one item, consumer thread only
+      /// @param   T&                Returning item
+      /// @return  bool              False if the ring is empty
+      //+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+
+      bool Pop(T& item)
+      {
+         return 1 == Pop_Batch(&item, 1);
+      }
+
+      //+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+
+      /// @brief   Pops up to max_count items, consumer thread only,
+      /// @brief   released to the producer with a single store
+      /// @param   T*                Returning items
+      /// @param   size_t            Most items to pop
+      /// @return  size_t            Number of items popped
+      //+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+
+      size_t Pop_Batch(T* items, size_t max_count)
+      {
+         size_t head = _head.load(std::memory_order_relaxed);
+
+         // Only reload the producer's position when the cached one says empty
+         if (_cached_tail - head < max_count)
+         {
+            _cached_tail = _tail.load(std::memory_order_acquire);
+         }
+
+         size_t available = _cached_tail - head;
+         size_t popped = (max_count < available) ? max_count : available;
+         for (size_t i = 0; i < popped; i++)
+         {
+            items[i] = std::move(_items[(head + i) & _mask]);
+         }
+
+         _head.store(head + popped, std::memory_order_release);
+         return popped;
+      }
+
+      //+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+
+      /// @brief   Checks for an item, consumer thread only
+      /// @return  bool              True if nothing can be popped
+      //+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+
+      bool Empty()
+      {
+         return _head.load(std::memory_order_relaxed) == _tail.load(std::memory_order_acquire);
+      }
+
+   private:
+
+      std::unique_ptr<T[]> _items;
+      size_t _mask = 0;
+      alignas(CACHE_LINE_SIZE) std::atomic<size_t> _tail{ 0 };    // Written by the producer
+      size_t _cached_head = 0;                                    // Producer's copy of _head
+      alignas(CACHE_LINE_SIZE) std::atomic<size_t> _head{ 0 };    // Written by the consumer
+      size_t _cached_tail = 0;                                    // Consumer's copy of _tail
+
+   };  // END class SPSC_Queue
+
+   //+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+
+   /// @brief   Link embedded in anything a Link_Queue holds, an
+   /// @brief   item is on at most one queue at a time
+   //+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+
+   class Queue_Link
+   {
+   public:
+
+      Queue_Link() { _next.store(nullptr, std::memory_order_relaxed); }
+
+   private:
+
+      template <typename T> friend class Link_Queue;
+
+      std::atomic<Queue_Link*> _next;   // Link while waiting on a queue
+
+   };  // END class Queue_Link
+
+   //+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+
+   /// @brief   Unbounded multi-producer, single-consumer list of
+   /// @brief   items linked through the items themselves, so a
+   /// @brief   push never fails and never allocates
+   //+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+
+   template <typename T>
+   class Link_Queue
+   {
+   public:
+
+      Link_Queue()
+      {
+         _head.store(&_stub, std::memory_order_relaxed);
+         _tail = &_stub;
+      }
+
+      //+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+
+      /// @brief   Pushes an item, safe from any thread
+      /// @param   T*                Item on no other queue
+      /// @return  None
+      //+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+
+      void Push(T* item)
+      {
+         Push_Link(item);
+      }
+
+      //+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+
+      /// @brief   Pops the oldest item, consumer thread only
+      /// @return  T*                Item, or nullptr if none is published
+      //+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+
+      T* Pop()
+      {
+         Queue_Link* tail = _tail;
+         Queue_Link* next = tail->_next.load(std::memory_order_acquire);
+
+         //
+         // 1. Step over the stub
+         if (&_stub == tail)
+         {
+            if (nullptr == next)
+            {
+               return nullptr;
+            }
+            _tail = next;
+            tail = next;
+            next = next->_next.load(std::memory_order_acquire);
+         }
+
+         //
+         // 2. Another item is linked behind this one
+         if (nullptr != next)
+         {
+            _tail = next;
+            return static_cast<T*>(tail);
+         }
+
+         //
+         // 3. A producer has swung the head but not linked yet, try again later
+         if (_head.load(std::memory_order_acquire) != tail)
+         {
+            return nullptr;
+         }
+
+         //
+         // 4. The last item, put the stub behind it so the list is never empty
+         Push_Link(&_stub);
+         next = tail->_next.load(std::memory_order_acquire);
+         if (nullptr != next)
+         {
+            _tail = next;
+            return static_cast<T*>(tail);
+         }
+
+         return nullptr;
+      }
+
+      //+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+
+      /// @brief   Checks for a published item, consumer thread only
+      /// @return  bool              True if nothing can be popped
+      //+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+
+      bool Empty()
+      {
+         return &_stub == _tail && nullptr == _stub._next.load(std::memory_order_seq_cst);
+      }
+
+   private:
+
+      Queue_Link _stub;                                                      // Placeholder the list is never left without
+      alignas(CACHE_LINE_SIZE) std::atomic<Queue_Link*> _head;               // Last pushed, moved by producers
+      alignas(CACHE_LINE_SIZE) Queue_Link* _tail;                            // Next to pop, consumer only
+
+      //+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+
+      /// @brief   Swings the head to the link, then links it behind
+      /// @brief   the old head, the consumer waits on the link until
+      /// @brief   it is made
+      /// @param   Queue_Link*       Link on no other queue
+      /// @return  None
+      //+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+
+      void Push_Link(Queue_Link* link)
+      {
+         link->_next.store(nullptr, std::memory_order_relaxed);
+         Queue_Link* previous = _head.exchange(link, std::memory_order_acq_rel);
+         previous->_next.store(link, std::memory_order_seq_cst);
+      }
+
+   };  // END class Link_Queue
+
+}  // END namespace Lock_Free
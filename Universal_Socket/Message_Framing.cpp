@@ -0,0 +1,245 @@
+//+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+
+// 
+//  ___________ __  .__                       ___________
+//  \_   _____//  |_|  |__ _____    ____      \_   _____/
+//   |    __)_\   __\  |  \\__  \  /    \      |    __)_ 
+//   |        \|  | |   Y  \/ __ \|   |  \     |        \
+//  /_______  /|__| |___|  (____  /___|  / /\ /_______  /
+//          \/           \/     \/     \/  \/         \/ 
+// 
+// Message Framing Implementation File
+//
+//  Author   Date         Description
+// --------------------------------------------------------
+//  ECE      10-17-2026   Initial Implementation
+//  ECE      10-17-2026   Streams read into pooled buffers, frames are views
+//+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+
+
+#include "Message_Framing.h"
+
+#include <cstring>
+#include <utility>
+
+namespace Framing
+{
+   //+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+
+   /// Writes the length prefix for a message
+   //+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+
+   uint32_t Encode_Header(Prefix prefix, uint32_t length, char* header)
+   {
+      uint32_t header_size = 0;
+
+      if (FIXED_32 == prefix)
+      {
+         header[0] = static_cast<char>(length >> 24);
+         header[1] = static_cast<char>(length >> 16);
+         header[2] = static_cast<char>(length >> 8);
+         header[3] = static_cast<char>(length);
+         header_size = 4;
+      }
+      else if (VARINT == prefix)
+      {
+         // Seven bits at a time, the high bit marks that another byte follows
+         while (0x80 <= length)
+         {
+            header[header_size++] = static_cast<char>((length & 0x7F) | 0x80);
+            length >>= 7;
+         }
+         header[header_size++] = static_cast<char>(length);
+      }
+
+      return header_size;
+   }  // END Encode_Header()
+
+   //+-+-+-+-+-+-+-+-+-+-+PRIVATE FUNCTIONS+-+-+-+-+-+-+-+-+-+-+-+-+-+
+
+   //+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+
+   /// Reads the length prefix at _read
+   //+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+
+   Frame_Decoder::Result Frame_Decoder::Decode_Header(uint32_t& header_size, uint32_t& length)
+   {
+      const uint8_t* header = reinterpret_cast<const uint8_t*>(_buffer.Get_Buffer() + _read);
+      size_t available = _write - _read;
+
+      //
+      // 1. Fixed width prefixes only need enough bytes
+      if (FIXED_32 == _prefix)
+      {
+         if (4 > available)
+         {
+            return NEED_MORE;
+         }
+         header_size = 4;
+         length = (static_cast<uint32_t>(header[0]) << 24) |
+                  (static_cast<uint32_t>(header[1]) << 16) |
+                  (static_cast<uint32_t>(header[2]) << 8) |
+                   static_cast<uint32_t>(header[3]);
+         return FRAME;
+      }
+
+      //
+      // 2. Varint prefixes end at the first byte without the high bit,
+      //    the fifth byte may only carry the top 4 bits of a 32 bit length
+      length = 0;
+      for (uint32_t i = 0; i < MAX_HEADER_SIZE; i++)
+      {
+         if (i >= available)
+         {
+            return NEED_MORE;
+         }
+         if ((MAX_HEADER_SIZE - 1) == i && 0x0F < header[i])
+         {
+            return FRAME_ERROR;
+         }
+
+         length |= static_cast<uint32_t>(header[i] & 0x7F) << (7 * i);
+         if (0 == (header[i] & 0x80))
+         {
+            header_size = i + 1;
+            return FRAME;
+         }
+      }
+
+      return FRAME_ERROR;
+   }  // END Decode_Header()
+
+   //-+-+-+-+-+-+-+-+-+-+-+PUBLIC FUNCTIONS+-+-+-+-+-+-+-+-+-+-+-+-+-+
+
+   //+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+
+   /// Constructor
+   //+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+
+   Frame_Decoder::Frame_Decoder()
+   {
+      Configure(NONE, DEFAULT_MAX_FRAME_SIZE);
+   }  // END Constructor
+
+   //+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+
+   /// Sets the framing and drops anything buffered
+   //+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+
+   void Frame_Decoder::Configure(Prefix prefix, uint32_t max_frame_size)
+   {
+      _prefix = prefix;
+      _max_frame_size = max_frame_size;
+      _read = 0;
+      _write = 0;
+      _needed = 0;
+      _buffer.Reset();
+   }  // END Configure()
+
+   //+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+
+   /// Gets free space to read the stream into
+   //+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+
+   char* Frame_Decoder::Get_Write_Buffer(size_t& space)
+   {
+      size_t unread = _write - _read;
+      size_t wanted = MIN_READ_SPACE;
+      size_t capacity = _buffer.Get_Capacity();
+
+      //
+      // 1. Nothing is left over and no message still views the buffer,
+      //    start again at the front for free
+      if (0 == unread && _buffer.Is_Unique())
+      {
+         _read = 0;
+         _write = 0;
+      }
+
+      //
+      // 2. Leave room for the rest of a partial frame in one read
+      if (_needed > unread && _needed - unread > wanted)
+      {
+         wanted = _needed - unread;
+      }
+
+      //
+      // 3. Move the partial frame to the front when the tail is too short,
+      //    only when no message handed out could be written over
+      if (capacity - _write < wanted && 0 < _read && capacity - unread >= wanted && _buffer.Is_Unique())
+      {
+         memmove(_buffer.Get_Buffer(), _buffer.Get_Buffer() + _read, unread);
+         _read = 0;
+         _write = unread;
+      }
+
+      //
+      // 4. Otherwise take a fresh buffer for the partial frame, messages
+      //    still viewing the old one keep it until they are released,
+      //    a frame never needs more than its header plus the max frame size
+      if (capacity - _write < wanted)
+      {
+         Buffers::Buffer_View next = Buffers::Receive_Pool().Acquire(unread + wanted);
+         if (0 < unread)
+         {
+            memcpy(next.Get_Buffer(), _buffer.Get_Buffer() + _read, unread);
+         }
+         _buffer = std::move(next);
+         _read = 0;
+         _write = unread;
+      }
+
+      space = _buffer.Get_Capacity() - _write;
+      return _buffer.Get_Buffer() + _write;
+   }  // END Get_Write_Buffer()
+
+   //+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+
+   /// Adds bytes read into the write buffer to the stream
+   //+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+
+   void Frame_Decoder::Commit(size_t bytes)
+   {
+      _write += bytes;
+   }  // END Commit()
+
+   //+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+
+   /// Takes the next whole message off the stream
+   //+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+
+   Frame_Decoder::Result Frame_Decoder::Next_Frame(Buffers::Buffer_View& frame)
+   {
+      Result result;
+      uint32_t header_size;
+      uint32_t length;
+      size_t available = _write - _read;
+
+      if (0 == available)
+      {
+         return NEED_MORE;
+      }
+
+      //
+      // 1. Without a prefix everything read so far is one message
+      if (NONE == _prefix)
+      {
+         frame = _buffer.Slice(_read, available);
+         _read = _write;
+         return FRAME;
+      }
+
+      //
+      // 2. Read the prefix, a length over the limit can never be resynchronized
+      result = Decode_Header(header_size, length);
+      if (FRAME != result)
+      {
+         return result;
+      }
+      if (_max_frame_size < length)
+      {
+         return FRAME_ERROR;
+      }
+
+      //
+      // 3. Remember the whole size so the next read makes room for it
+      if (available < header_size + static_cast<size_t>(length))
+      {
+         _needed = header_size + static_cast<size_t>(length);
+         return NEED_MORE;
+      }
+
+      //
+      // 4. Hand out a view of the message in place
+      frame = _buffer.Slice(_read + header_size, length);
+      _read += header_size + length;
+      _needed = 0;
+
+      return FRAME;
+   }  // END Next_Frame()
+
+}  // END namespace Framing
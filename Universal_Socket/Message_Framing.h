@@ -0,0 +1,125 @@
+//+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+
+// 
+//  ___________ __  .__                       ___________
+//  \_   _____//  |_|  |__ _____    ____      \_   _____/
+//   |    __)_\   __\  |  \\__  \  /    \      |    __)_ 
+//   |        \|  | |   Y  \/ __ \|   |  \     |        \
+//  /_______  /|__| |___|  (____  /___|  / /\ /_______  /
+//          \/           \/     \/     \/  \/         \/ 
+// 
+// Message Framing Header File
+//
+//  Author   Date         Description
+// --------------------------------------------------------
+//  ECE      10-17-2026   Initial Implementation
+//  ECE      10-17-2026   Streams read into pooled buffers, frames are views
+//+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+
+
+#pragma once
+
+#include "Buffer_Pool.h"
+
+#include <cstddef>
+#include <cstdint>
+
+namespace Framing
+{
+   enum Prefix : uint8_t
+   {
+      NONE     = 0,  // Every read is handed up as one message
+      FIXED_32 = 1,  // 4 byte big endian length before every message
+      VARINT   = 2   // 1 to 5 byte base 128 length, low 7 bits first
+   };
+
+   // Largest length prefix of any framing
+   constexpr uint32_t MAX_HEADER_SIZE{ 5 };
+
+   // Largest message accepted when no limit is given
+   constexpr uint32_t DEFAULT_MAX_FRAME_SIZE{ 1024 * 1024 };
+
+   // Least free space handed to every read of the stream
+   constexpr size_t MIN_READ_SPACE{ 4096 };
+
+   //+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+
+   /// @brief   Writes the length prefix for a message
+   /// @param   Prefix            Framing to encode with, not NONE
+   /// @param   uint32_t          Length of the message
+   /// @param   char*             Header of at least MAX_HEADER_SIZE bytes
+   /// @return  uint32_t          Number of header bytes written
+   //+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+
+   uint32_t Encode_Header(Prefix prefix, uint32_t length, char* header);
+
+   //+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+
+   /// @brief   Splits a byte stream back into whole messages.
+   /// @brief   Reads land directly in a pooled receive buffer and
+   /// @brief   every message is handed out as a view of it, the
+   /// @brief   only copy is moving a partial message forward
+   //+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+
+   class Frame_Decoder
+   {
+   public:
+
+      enum Result : uint8_t
+      {
+         FRAME       = 1,  // A whole message was returned
+         NEED_MORE   = 2,  // The rest of the message has not arrived
+         FRAME_ERROR = 3   // Bad or oversized prefix, the stream is lost
+      };
+
+      //+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+
+      /// @brief   Constructor, no buffer is taken until the first read
+      //+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+
+      Frame_Decoder();
+
+      //+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+
+      /// @brief   Sets the framing and drops anything buffered,
+      /// @brief   called whenever a new stream starts
+      /// @param   Prefix            Framing of the stream
+      /// @param   uint32_t          Largest message accepted
+      /// @return  None
+      //+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+
+      void Configure(Prefix prefix, uint32_t max_frame_size);
+
+      //+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+
+      /// @brief   Gets free space to read the stream into, a buffer
+      /// @brief   still viewed by returned messages is never reused
+      /// @param   size_t            Returning number of free bytes
+      /// @return  char*             Start of the free space
+      //+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+
+      char* Get_Write_Buffer(size_t& space);
+
+      //+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+
+      /// @brief   Adds bytes read into the write buffer to the stream
+      /// @param   size_t            Number of bytes read
+      /// @return  None
+      //+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+
+      void Commit(size_t bytes);
+
+      //+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+
+      /// @brief   Takes the next whole message off the stream as a
+      /// @brief   view sharing the decoder's buffer
+      /// @param   Buffer_View       Returning message
+      /// @return  Result            FRAME, NEED_MORE or FRAME_ERROR
+      //+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+
+      Result Next_Frame(Buffers::Buffer_View& frame);
+
+   private:
+
+      Buffers::Buffer_View _buffer;   // Whole buffer the stream is read into
+      size_t _read;              // Start of the first unreturned byte
+      size_t _write;             // End of the bytes read so far
+      size_t _needed;            // Whole size of the partial frame at _read, 0 if unknown
+      Prefix _prefix;
+      uint32_t _max_frame_size;
+
+      //+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+
+      /// @brief   Reads the length prefix at _read
+      /// @param   uint32_t          Returning header size
+      /// @param   uint32_t          Returning message length
+      /// @return  Result            FRAME if the prefix is complete
+      //+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+
+      Result Decode_Header(uint32_t& header_size, uint32_t& length);
+
+   };  // END class Frame_Decoder
+
+}  // END namespace Framing
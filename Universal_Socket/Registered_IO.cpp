@@ -0,0 +1,526 @@
+//+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+
+// 
+//  ___________ __  .__                       ___________
+//  \_   _____//  |_|  |__ _____    ____      \_   _____/
+//   |    __)_\   __\  |  \\__  \  /    \      |    __)_ 
+//   |        \|  | |   Y  \/ __ \|   |  \     |        \
+//  /_______  /|__| |___|  (____  /___|  / /\ /_______  /
+//          \/           \/     \/     \/  \/         \/ 
+// 
+// Registered I/O Engine Implementation File
+//
+//  Author   Date         Description
+// --------------------------------------------------------
+//  ECE      10-17-2026   Initial Implementation
+//  ECE      10-17-2026   Reschedule sends when a send slot frees up
+//  ECE      10-17-2026   Pops from the lock free send queue
+//  ECE      10-17-2026   Hands the message length to Handle_Message
+//  ECE      10-17-2026   Copies receives into a pooled buffer for the receive queue
+//  ECE      10-17-2026   Registrations are kept in the socket registry slots
+//  ECE      10-17-2026   Releases popped bytes from the send watermarks
+//  ECE      10-17-2026   Counts sends, commits and receive completions
+//  ECE      10-17-2026   Messages go to the asynchronous log
+//  ECE      10-17-2026   A message a failed send left is held and sent first next time
+//  ECE      10-17-2026   Queued messages are held in pooled buffers
+//  ECE      10-17-2026   Hands the whole SOCKADDR_INET sender to Handle_Message
+//  ECE      10-17-2026   UDP sends go to each queued datagram's destination
+//+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+
+
+#include "Registered_IO.h"
+#include "Socket_Registry.h"
+#include "Universal_Socket.h"
+
+#include <WS2tcpip.h>
+#include <string>
+#include <thread>
+#include <vector>
+
+namespace Registered_IO
+{
+   // Most sockets that can be registered, sizes the shared completion queue
+   constexpr uint32_t MAX_REGISTERED_SOCKETS{ 256 };
+
+   // Completion queue entries needed for every registered socket
+   constexpr uint32_t COMPLETION_QUEUE_SIZE{ MAX_REGISTERED_SOCKETS * (RECEIVE_SLOTS + SEND_SLOTS) };
+
+   // Registered buffer layout, receive slots, send slots, then one address per slot
+   constexpr uint32_t SEND_SLOT_OFFSET{ RECEIVE_SLOTS * SLOT_SIZE };
+   constexpr uint32_t ADDRESS_OFFSET{ (RECEIVE_SLOTS + SEND_SLOTS) * SLOT_SIZE };
+   constexpr uint32_t BUFFER_SIZE{ ADDRESS_OFFSET + (RECEIVE_SLOTS + SEND_SLOTS) * sizeof(SOCKADDR_INET) };
+
+   struct Registered_Socket
+   {
+      Universal_Socket* owner = nullptr;
+      SOCKET socket = INVALID_SOCKET;
+      RIO_RQ request_queue = RIO_INVALID_RQ;
+      RIO_BUFFERID buffer_id = RIO_INVALID_BUFFERID;
+      char* buffer = nullptr;
+      uint32_t socket_index = 0;
+      uint32_t generation = 0;            // Completions from an older registration are dropped
+      bool is_udp = false;
+      bool is_active = false;
+      std::mutex queue_mutex;             // Request queues are not thread safe
+      std::vector<uint32_t> free_send_slots;
+      Socket_Vars::Queued_Send unsent;    // Popped but refused by RIOSend(), sent first next time
+      bool has_unsent = false;
+   };
+
+   // RIO function table, loaded once when the engine starts
+   RIO_EXTENSION_FUNCTION_TABLE rio;
+
+   // Completion queue shared by every registered socket
+   RIO_CQ completion_queue = RIO_INVALID_CQ;
+   HANDLE completion_event = WSA_INVALID_EVENT;
+
+   // Registration state, each registration is kept in its socket's
+   // registry slot and reused by the next socket at the same index
+   std::mutex engine_mutex;
+   bool is_engine_started = false;
+   uint32_t registered_count = 0;
+
+   //+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+
+   /// Builds the request context, low 16 bits of the generation
+   /// then the slot number, fits a 32-bit pointer
+   //+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+
+   static PVOID Request_Context(uint32_t generation, uint32_t slot)
+   {
+      return reinterpret_cast<PVOID>(static_cast<ULONG_PTR>(((generation & 0xFFFF) << 16) | slot));
+   }  // END Request_Context()
+
+   //+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+
+   /// Posts a receive into a receive slot, queue_mutex must be held
+   //+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+
+   static bool Post_Receive(Registered_Socket& registered, uint32_t slot)
+   {
+      bool result = true;
+
+      // Leave room for the null-terminator added on completion
+      RIO_BUF data{ registered.buffer_id, slot * SLOT_SIZE, SLOT_SIZE - 1 };
+
+      if (registered.is_udp)
+      {
+         RIO_BUF remote_address{ registered.buffer_id, ADDRESS_OFFSET + slot * static_cast<uint32_t>(sizeof(SOCKADDR_INET)), sizeof(SOCKADDR_INET) };
+         result &= (FALSE != rio.RIOReceiveEx(registered.request_queue, &data, 1, nullptr, &remote_address,
+                                              nullptr, nullptr, 0, Request_Context(registered.generation, slot)));
+      }
+      else
+      {
+         result &= (FALSE != rio.RIOReceive(registered.request_queue, &data, 1, 0,
+                                            Request_Context(registered.generation, slot)));
+      }
+
+      if (!result)
+      {
+         Log::Write<Log::LEVEL_ERROR>("ERROR, RIOReceive() failed with: %u\n", WSAGetLastError());
+      }
+
+      return result;
+   }  // END Post_Receive()
+
+   //+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+
+   /// Handles one completion pulled off the completion queue
+   //+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+
+   static void Handle_Completion(const RIORESULT& completion)
+   {
+      Registered_Socket& registered = *reinterpret_cast<Registered_Socket*>(completion.SocketContext);
+      uint32_t generation = static_cast<uint32_t>((completion.RequestContext >> 16) & 0xFFFF);
+      uint32_t slot = static_cast<uint32_t>(completion.RequestContext & 0xFFFF);
+      std::unique_lock<std::mutex> lock(registered.queue_mutex);
+
+      //
+      // 1. Drop completions for a socket that was closed or registered again
+      if (!registered.is_active || generation != (registered.generation & 0xFFFF))
+      {
+         return;
+      }
+
+      //
+      // 2. A send completed, its slot can be reused, if every slot was busy
+      //    or a refused message is held the sending thread may have left
+      //    messages queued so wake it
+      if (RECEIVE_SLOTS <= slot)
+      {
+         bool was_full = registered.free_send_slots.empty() || registered.has_unsent;
+         registered.free_send_slots.push_back(slot - RECEIVE_SLOTS);
+         if (0 != completion.Status)
+         {
+            Log::Write<Log::LEVEL_ERROR>("RIOSend() completed with error: %d\n", completion.Status);
+         }
+         lock.unlock();
+         if (was_full)
+         {
+            Socket_Vars::Schedule_Send(registered.socket_index);
+         }
+         return;
+      }
+
+      //
+      // 3. A failed or empty TCP receive means the peer is gone, the owning
+      //    loop closes the socket, the loop and its sending thread may still
+      //    be using it
+      if (0 != completion.Status || (0 == completion.BytesTransferred && !registered.is_udp))
+      {
+         if (registered.is_udp)
+         {
+            Log::Write<Log::LEVEL_ERROR>("RIOReceive() completed with error: %d\n", completion.Status);
+            Post_Receive(registered, slot);
+            return;
+         }
+
+         registered.is_active = false;
+         lock.unlock();
+         registered.owner->Signal_Peer_Closed();
+         return;
+      }
+
+      //
+      // 4. Hand the message to the owning socket without holding the queue,
+      //    the registered slot is reposted, so the message is copied into a
+      //    pooled buffer that the receive queue can hold on to
+      SOCKADDR_INET* sender = reinterpret_cast<SOCKADDR_INET*>(
+         registered.buffer + ADDRESS_OFFSET + slot * sizeof(SOCKADDR_INET));
+      lock.unlock();
+
+      registered.owner->Get_Stats().Add(Stats::RECEIVE_CALLS);
+      registered.owner->Get_Stats().Add(Stats::BYTES_RECEIVED, completion.BytesTransferred);
+      Buffers::Buffer_View message = Buffers::Receive_Pool().Acquire(completion.BytesTransferred);
+      memcpy(message.Get_Buffer(), registered.buffer + slot * SLOT_SIZE, completion.BytesTransferred);
+      registered.owner->Handle_Message(
+         message.Slice(0, completion.BytesTransferred),
+         registered.is_udp ? sender : nullptr);
+
+      //
+      // 5. Repost the receive slot
+      lock.lock();
+      if (registered.is_active && generation == (registered.generation & 0xFFFF))
+      {
+         Post_Receive(registered, slot);
+      }
+   }  // END Handle_Completion()
+
+   //+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+
+   /// Waits on the completion queue and handles completions in batches
+   //+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+
+   static void Completion_Thread()
+   {
+      bool keep_engine_alive = true;
+      ULONG completion_count;
+      std::vector<RIORESULT> completions(MAX_COMPLETIONS);
+
+      while (keep_engine_alive)
+      {
+         //
+         // 1. Ask for the completion event, then sleep until it is signaled
+         rio.RIONotify(completion_queue);
+         WaitForSingleObject(completion_event, INFINITE);
+
+         //
+         // 2. Drain the completion queue, a batch at a time
+         do
+         {
+            completion_count = rio.RIODequeueCompletion(completion_queue, completions.data(), MAX_COMPLETIONS);
+            if (RIO_CORRUPT_CQ == completion_count)
+            {
+               Log::Write<Log::LEVEL_ERROR>("RIODequeueCompletion() completion queue is corrupt!\n");
+               keep_engine_alive = false;
+               break;
+            }
+
+            for (ULONG i = 0; i < completion_count; i++)
+            {
+               Handle_Completion(completions[i]);
+            }
+         } while (MAX_COMPLETIONS == completion_count);
+
+      }  // END while keep_engine_alive
+
+      Log::Write<Log::LEVEL_INFO>("Closing Registered_IO Completion_Thread()!\n");
+   }  // END Completion_Thread()
+
+   //+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+
+   /// Loads the RIO functions and creates the completion queue,
+   /// engine_mutex must be held
+   //+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+
+   static bool Start_Engine(SOCKET socket)
+   {
+      bool result = true;
+      int func_result;
+      DWORD bytes = 0;
+      GUID rio_id = WSAID_MULTIPLE_RIO;
+
+      //
+      // 1. Load the RIO function table through any registered I/O socket
+      func_result = WSAIoctl(
+         socket,
+         SIO_GET_MULTIPLE_EXTENSION_FUNCTION_POINTER,
+         &rio_id, sizeof(rio_id),
+         &rio, sizeof(rio),
+         &bytes, nullptr, nullptr);
+      if (SOCKET_ERROR == func_result)
+      {
+         Log::Write<Log::LEVEL_ERROR>("ERROR, RIO WSAIoctl() failed with: %u\n", WSAGetLastError());
+         result &= false;
+         return result;
+      }
+
+      //
+      // 2. Create the completion event and queue
+      completion_event = WSACreateEvent();
+      if (WSA_INVALID_EVENT == completion_event)
+      {
+         Log::Write<Log::LEVEL_ERROR>("ERROR, RIO WSACreateEvent() failed with: %u\n", WSAGetLastError());
+         result &= false;
+         return result;
+      }
+
+      RIO_NOTIFICATION_COMPLETION notification;
+      notification.Type = RIO_EVENT_COMPLETION;
+      notification.Event.EventHandle = completion_event;
+      notification.Event.NotifyReset = TRUE;
+      completion_queue = rio.RIOCreateCompletionQueue(COMPLETION_QUEUE_SIZE, &notification);
+      if (RIO_INVALID_CQ == completion_queue)
+      {
+         Log::Write<Log::LEVEL_ERROR>("ERROR, RIOCreateCompletionQueue() failed with: %u\n", WSAGetLastError());
+         result &= false;
+         return result;
+      }
+
+      //
+      // 3. Start the completion thread
+      std::thread completion_thread(Completion_Thread);
+      completion_thread.detach();
+      is_engine_started = true;
+
+      return result;
+   }  // END Start_Engine()
+
+   //+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+
+   /// Creates a request queue for a socket and posts its receives
+   //+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+
+   bool Register_Socket(Universal_Socket* owner, SOCKET socket, uint32_t socket_index, bool is_udp)
+   {
+      bool result = true;
+      std::lock_guard<std::mutex> engine_lock(engine_mutex);
+
+      //
+      // 1. Start the engine on the first registration
+      if (!is_engine_started)
+      {
+         result &= Start_Engine(socket);
+         if (!result)
+         {
+            return result;
+         }
+      }
+
+      //
+      // 2. First registration at this index, create and register its buffer,
+      //    the buffer is kept for any later registration at the same index
+      Socket_Vars::Socket_Slot& slot = Socket_Vars::Sockets().Get_Slot(socket_index);
+      Registered_Socket* registered = slot.registered.load(std::memory_order_acquire);
+      if (nullptr == registered)
+      {
+         if (MAX_REGISTERED_SOCKETS <= registered_count)
+         {
+            Log::Write<Log::LEVEL_ERROR>("ERROR, too many registered I/O sockets!\n");
+            result &= false;
+            return result;
+         }
+
+         registered = new Registered_Socket();
+         registered->buffer = static_cast<char*>(VirtualAlloc(nullptr, BUFFER_SIZE, MEM_COMMIT | MEM_RESERVE, PAGE_READWRITE));
+         if (nullptr == registered->buffer)
+         {
+            Log::Write<Log::LEVEL_ERROR>("ERROR, RIO VirtualAlloc() failed with: %u\n", GetLastError());
+            delete registered;
+            result &= false;
+            return result;
+         }
+
+         registered->buffer_id = rio.RIORegisterBuffer(registered->buffer, BUFFER_SIZE);
+         if (RIO_INVALID_BUFFERID == registered->buffer_id)
+         {
+            Log::Write<Log::LEVEL_ERROR>("ERROR, RIORegisterBuffer() failed with: %u\n", WSAGetLastError());
+            VirtualFree(registered->buffer, 0, MEM_RELEASE);
+            delete registered;
+            result &= false;
+            return result;
+         }
+
+         slot.registered.store(registered, std::memory_order_release);
+         registered_count++;
+      }
+
+      //
+      // 3. Create the request queue, both directions complete on the shared queue
+      std::lock_guard<std::mutex> queue_lock(registered->queue_mutex);
+      registered->generation++;
+      registered->owner = owner;
+      registered->socket = socket;
+      registered->socket_index = socket_index;
+      registered->is_udp = is_udp;
+      registered->request_queue = rio.RIOCreateRequestQueue(
+         socket,
+         RECEIVE_SLOTS, 1,    // Outstanding receives, buffers per receive
+         SEND_SLOTS, 1,       // Outstanding sends, buffers per send
+         completion_queue,
+         completion_queue,
+         registered);
+      if (RIO_INVALID_RQ == registered->request_queue)
+      {
+         Log::Write<Log::LEVEL_ERROR>("ERROR, RIOCreateRequestQueue() failed with: %u\n", WSAGetLastError());
+         result &= false;
+         return result;
+      }
+
+      registered->free_send_slots.clear();
+      registered->unsent.message.Reset();
+      registered->has_unsent = false;
+      for (uint32_t slot = 0; slot < SEND_SLOTS; slot++)
+      {
+         registered->free_send_slots.push_back(slot);
+      }
+      registered->is_active = true;
+
+      //
+      // 4. Post every receive slot up front
+      for (uint32_t slot = 0; slot < RECEIVE_SLOTS && result; slot++)
+      {
+         result &= Post_Receive(*registered, slot);
+      }
+
+      return result;
+   }  // END Register_Socket()
+
+   //+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+
+   /// Stops delivering completions for a socket
+   //+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+
+   void Unregister_Socket(uint32_t socket_index)
+   {
+      std::lock_guard<std::mutex> engine_lock(engine_mutex);
+      Registered_Socket* registered = Socket_Vars::Sockets().Get_Slot(socket_index).registered.load(std::memory_order_acquire);
+
+      if (nullptr != registered)
+      {
+         std::lock_guard<std::mutex> queue_lock(registered->queue_mutex);
+         registered->is_active = false;
+
+         // A held message will never be sent, its bytes leave the watermarks
+         if (registered->has_unsent)
+         {
+            Socket_Vars::Release_Send_Bytes(socket_index, registered->unsent.message.Size());
+            registered->unsent.message.Reset();
+            registered->has_unsent = false;
+         }
+      }
+   }  // END Unregister_Socket()
+
+   //+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+
+   /// Moves queued messages into deferred sends and commits them
+   //+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+
+   bool Send_Queued(uint32_t socket_index, const SOCKADDR_INET& address)
+   {
+      bool result = true;
+      uint32_t deferred_count = 0;
+      Socket_Vars::Socket_Slot& slot = Socket_Vars::Sockets().Get_Slot(socket_index);
+      Registered_Socket* registered = slot.registered.load(std::memory_order_acquire);
+      Lock_Free::MPSC_Queue<Socket_Vars::Queued_Send>& send_queue = slot.send_queue;
+      Stats::Socket_Stats& stats = slot.stats;
+      Socket_Vars::Queued_Send queued;
+      Buffers::Buffer_View& message = queued.message;
+
+      if (nullptr == registered)
+      {
+         result &= false;
+         return result;
+      }
+
+      std::lock_guard<std::mutex> queue_lock(registered->queue_mutex);
+      if (!registered->is_active)
+      {
+         result &= false;
+         return result;
+      }
+
+      //
+      // 1. Copy each message into a free send slot and defer the send, one
+      //    a failed send left goes first, messages wait on the queue while
+      //    every slot is in flight
+      while (false == registered->free_send_slots.empty())
+      {
+         if (registered->has_unsent)
+         {
+            queued = std::move(registered->unsent);
+            registered->has_unsent = false;
+         }
+         else if (!send_queue.Pop(queued))
+         {
+            break;
+         }
+
+         if (SLOT_SIZE < message.Size())
+         {
+            Log::Write<Log::LEVEL_ERROR>("RIO Send_Queued() message of %zu bytes is larger than a send slot, message dropped!\n", message.Size());
+            Socket_Vars::Release_Send_Bytes(socket_index, message.Size());
+            stats.Add(Stats::MESSAGES_DROPPED);
+            result &= false;
+            continue;
+         }
+
+         uint32_t slot = registered->free_send_slots.back();
+         uint32_t offset = SEND_SLOT_OFFSET + slot * SLOT_SIZE;
+         memcpy(registered->buffer + offset, message.Data(), message.Size());
+         RIO_BUF data{ registered->buffer_id, offset, static_cast<ULONG>(message.Size()) };
+         BOOL send_result;
+
+         // A reply carries the sender it answers, anything else goes to
+         // where the socket sends
+         if (registered->is_udp)
+         {
+            const SOCKADDR_INET& destination = (0 == queued.destination.si_family) ? address : queued.destination;
+            uint32_t address_offset = ADDRESS_OFFSET + (RECEIVE_SLOTS + slot) * static_cast<uint32_t>(sizeof(SOCKADDR_INET));
+            memcpy(registered->buffer + address_offset, &destination, sizeof(SOCKADDR_INET));
+            RIO_BUF remote_address{ registered->buffer_id, address_offset, sizeof(SOCKADDR_INET) };
+            send_result = rio.RIOSendEx(registered->request_queue, &data, 1, nullptr, &remote_address, nullptr, nullptr,
+                                        RIO_MSG_DEFER, Request_Context(registered->generation, RECEIVE_SLOTS + slot));
+         }
+         else
+         {
+            send_result = rio.RIOSend(registered->request_queue, &data, 1,
+                                      RIO_MSG_DEFER, Request_Context(registered->generation, RECEIVE_SLOTS + slot));
+         }
+
+         // The slot stays free and the message is held, the next call or
+         // the next send completion tries it again
+         if (FALSE == send_result)
+         {
+            Log::Write<Log::LEVEL_ERROR>("RIOSend() failed with: %u\n", WSAGetLastError());
+            registered->unsent = std::move(queued);
+            registered->has_unsent = true;
+            result &= false;
+            break;
+         }
+
+         registered->free_send_slots.pop_back();
+         Socket_Vars::Release_Send_Bytes(socket_index, message.Size());
+         deferred_count++;
+         stats.Add(Stats::MESSAGES_SENT);
+         stats.Add(Stats::BYTES_SENT, message.Size());
+      }
+
+      //
+      // 2. Submit every deferred send with a single commit
+      if (0 < deferred_count)
+      {
+         stats.Add(Stats::SEND_CALLS);
+         if (FALSE == rio.RIOSend(registered->request_queue, nullptr, 0, RIO_MSG_COMMIT_ONLY, nullptr))
+         {
+            Log::Write<Log::LEVEL_ERROR>("RIOSend() commit failed with: %u\n", WSAGetLastError());
+            result &= false;
+         }
+      }
+
+      return result;
+   }  // END Send_Queued()
+
+}  // END namespace Registered_IO
@@ -0,0 +1,76 @@
+//+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+
+// 
+//  ___________ __  .__                       ___________
+//  \_   _____//  |_|  |__ _____    ____      \_   _____/
+//   |    __)_\   __\  |  \\__  \  /    \      |    __)_ 
+//   |        \|  | |   Y  \/ __ \|   |  \     |        \
+//  /_______  /|__| |___|  (____  /___|  / /\ /_______  /
+//          \/           \/     \/     \/  \/         \/ 
+// 
+// Registered I/O Engine Header File
+//
+//  Author   Date         Description
+// --------------------------------------------------------
+//  ECE      10-17-2026   Initial Implementation
+//  ECE      10-17-2026   Pops from the lock free send queue
+//  ECE      10-17-2026   Socket indexes are 32 bit registry slots
+//  ECE      10-17-2026   UDP sends go to each queued datagram's destination
+//+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+
+
+#pragma once
+
+#include <WinSock2.h>
+#include <MSWSock.h>
+#include <WS2tcpip.h>
+#include <cstdint>
+
+class Universal_Socket;
+
+namespace Registered_IO
+{
+   // Receives kept posted on every registered socket at all times
+   constexpr uint32_t RECEIVE_SLOTS{ 64 };
+
+   // Sends that may be in flight on every registered socket at once
+   constexpr uint32_t SEND_SLOTS{ 64 };
+
+   // Size of every receive and send slot in the registered buffer
+   constexpr uint32_t SLOT_SIZE{ 1024 };
+
+   // Most completions pulled off the completion queue per dequeue
+   constexpr uint32_t MAX_COMPLETIONS{ 256 };
+
+   //+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+
+   /// @brief   Creates a request queue for a connected or bound
+   /// @brief   socket and posts all of its receives, the engine
+   /// @brief   is started on the first registration
+   /// @param   Universal_Socket* Socket that owns the handle
+   /// @param   SOCKET            Handle created with WSA_FLAG_REGISTERED_IO
+   /// @param   uint32_t          Index of the socket's queues
+   /// @param   bool              True when the socket is UDP
+   /// @return  bool              Result of the registration
+   //+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+
+   bool Register_Socket(Universal_Socket* owner, SOCKET socket, uint32_t socket_index, bool is_udp);
+
+   //+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+
+   /// @brief   Stops delivering completions for a socket, any
+   /// @brief   completions still in flight are dropped
+   /// @param   uint32_t          Index of the socket's queues
+   /// @return  None
+   //+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+
+   void Unregister_Socket(uint32_t socket_index);
+
+   //+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+
+   /// @brief   Moves every queued message that fits in a free
+   /// @brief   send slot into deferred sends and commits them
+   /// @brief   with a single call, Socket_Sending_Thread only,
+   /// @brief   a message RIOSend() refuses is held and goes first
+   /// @brief   next time, one larger than a slot is dropped
+   /// @param   uint32_t          Index of the socket's queues
+   /// @param   SOCKADDR_INET&    Destination of UDP messages queued
+   /// @param   SOCKADDR_INET&    without one of their own
+   /// @return  bool              Result of the send
+   //+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+
+   bool Send_Queued(uint32_t socket_index, const SOCKADDR_INET& address);
+
+}  // END namespace Registered_IO
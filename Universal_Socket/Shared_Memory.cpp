@@ -0,0 +1,454 @@
+//+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+
+// 
+//  ___________ __  .__                       ___________
+//  \_   _____//  |_|  |__ _____    ____      \_   _____/
+//   |    __)_\   __\  |  \\__  \  /    \      |    __)_ 
+//   |        \|  | |   Y  \/ __ \|   |  \     |        \
+//  /_______  /|__| |___|  (____  /___|  / /\ /_______  /
+//          \/           \/     \/     \/  \/         \/ 
+// 
+// Shared Memory Transport Implementation File
+//
+//  Author   Date         Description
+// --------------------------------------------------------
+//  ECE      10-17-2026   Initial Implementation
+//  ECE      10-17-2026   A record that does not fit what the peer published drops it
+//+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+
+
+#include "Shared_Memory.h"
+#include "Universal_Socket.h"
+
+#include <cstring>
+
+namespace Shared_Memory
+{
+   // Marks a mapping laid out by this version
+   constexpr uint32_t MAPPING_MAGIC{ 0x55534D32 };
+
+   // Ring bytes are addressed by position modulo the ring
+   constexpr uint64_t RING_MASK{ RING_SIZE - 1 };
+
+   static_assert(0 == (RING_SIZE & RING_MASK), "RING_SIZE must be a power of two");
+
+   // Rings, each direction named by who receives it
+   constexpr int TO_CLIENT{ 0 };
+   constexpr int TO_SERVER{ 1 };
+
+   // Whole mapping, the header then both rings
+   constexpr uint64_t MAPPING_SIZE{ sizeof(Mapping_Header) + 2 * uint64_t{ RING_SIZE } };
+
+   //+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+
+   /// Makes or opens one of the link's named events
+   //+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+
+   static HANDLE Link_Event(const std::string& name, const char* what, int ring, bool is_create)
+   {
+      std::string event_name = "Local\\Universal_Socket_" + name + "_" + what + "_" + std::to_string(ring);
+
+      if (is_create)
+      {
+         return CreateEventA(nullptr, FALSE, FALSE, event_name.c_str());
+      }
+      return OpenEventA(EVENT_MODIFY_STATE | SYNCHRONIZE, FALSE, event_name.c_str());
+   }  // END Link_Event()
+
+   //+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+
+   /// Destructor, unmaps and closes everything
+   //+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+
+   Channel::~Channel()
+   {
+      //
+      // 1. No space callback may run past here
+      if (nullptr != _space_wait)
+      {
+         UnregisterWaitEx(_space_wait, INVALID_HANDLE_VALUE);
+      }
+
+      //
+      // 2. Tell the peer this end is gone
+      if (_is_attached)
+      {
+         if (_is_server)
+         {
+            _header->server_process.store(0);
+         }
+         else
+         {
+            _header->is_client_closed.store(1);
+         }
+         SetEvent(_send_data_event);
+      }
+      if (nullptr != _header)
+      {
+         UnmapViewOfFile(_header);
+      }
+
+      //
+      // 3. Close the handles
+      for (HANDLE handle : { _mapping, _receive_data_event, _send_data_event, _send_space_event, _receive_space_event, _peer_process })
+      {
+         if (nullptr != handle)
+         {
+            CloseHandle(handle);
+         }
+      }
+   }  // END Destructor
+
+   //+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+
+   /// Creates the mapping as its server, or opens it as its client
+   //+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+
+   bool Channel::Open(const std::string& name, bool is_server, uint32_t socket_index, uint16_t loop)
+   {
+      bool result = true;
+      std::string mapping_name = "Local\\Universal_Socket_" + name;
+      int send = is_server ? TO_CLIENT : TO_SERVER;
+      int receive = is_server ? TO_SERVER : TO_CLIENT;
+      char* rings;
+
+      _is_server = is_server;
+      _socket_index = socket_index;
+      _loop = loop;
+
+      //
+      // 1. The server makes a new mapping, the client opens it
+      if (is_server)
+      {
+         _mapping = CreateFileMappingA(INVALID_HANDLE_VALUE, nullptr, PAGE_READWRITE,
+            static_cast<DWORD>(MAPPING_SIZE >> 32), static_cast<DWORD>(MAPPING_SIZE), mapping_name.c_str());
+         if (nullptr != _mapping && ERROR_ALREADY_EXISTS == GetLastError())
+         {
+            Log::Write<Log::LEVEL_ERROR>("ERROR, shared memory %s is already in use\n", name);
+            result &= false;
+            return result;
+         }
+      }
+      else
+      {
+         _mapping = OpenFileMappingA(FILE_MAP_ALL_ACCESS, FALSE, mapping_name.c_str());
+      }
+      if (nullptr == _mapping)
+      {
+         result &= false;
+         return result;
+      }
+      _header = static_cast<Mapping_Header*>(MapViewOfFile(_mapping, FILE_MAP_ALL_ACCESS, 0, 0, 0));
+      if (nullptr == _header)
+      {
+         Log::Write<Log::LEVEL_ERROR>("ERROR, MapViewOfFile() failed with: %u\n", GetLastError());
+         result &= false;
+         return result;
+      }
+
+      //
+      // 2. The server sends to the client's ring, the client to the server's
+      rings = reinterpret_cast<char*>(_header + 1);
+      _send_ring = &_header->rings[send];
+      _receive_ring = &_header->rings[receive];
+      _send_data = rings + send * uint64_t{ RING_SIZE };
+      _receive_data = rings + receive * uint64_t{ RING_SIZE };
+
+      //
+      // 3. A client only uses a mapping the server finished
+      if (!is_server && (MAPPING_MAGIC != _header->magic.load() || RING_SIZE != _header->ring_size))
+      {
+         result &= false;
+         return result;
+      }
+      _receive_data_event = Link_Event(name, "data", receive, is_server);
+      _send_data_event = Link_Event(name, "data", send, is_server);
+      _send_space_event = Link_Event(name, "space", send, is_server);
+      _receive_space_event = Link_Event(name, "space", receive, is_server);
+      if (nullptr == _receive_data_event || nullptr == _send_data_event
+          ||
+          nullptr == _send_space_event || nullptr == _receive_space_event)
+      {
+         Log::Write<Log::LEVEL_ERROR>("ERROR, shared memory %s events failed with: %u\n", name, GetLastError());
+         result &= false;
+         return result;
+      }
+
+      //
+      // 4. The server publishes the mapping, the client claims it
+      if (is_server)
+      {
+         _header->ring_size = RING_SIZE;
+         _header->server_process.store(GetCurrentProcessId());
+         _header->magic.store(MAPPING_MAGIC);
+         _is_attached = true;
+      }
+      else
+      {
+         uint32_t server_process = _header->server_process.load();
+         uint32_t no_client = 0;
+
+         if (0 == server_process || !_header->client_process.compare_exchange_strong(no_client, GetCurrentProcessId()))
+         {
+            result &= false;
+            return result;
+         }
+         _is_attached = true;
+         _peer_process = OpenProcess(SYNCHRONIZE, FALSE, server_process);
+         SetEvent(_send_data_event);
+         if (nullptr == _peer_process)
+         {
+            result &= false;
+            return result;
+         }
+      }
+
+      //
+      // 5. Room in a full sending ring schedules the sending thread
+      if (FALSE == RegisterWaitForSingleObject(&_space_wait, _send_space_event, Space_Available, this, INFINITE, WT_EXECUTEDEFAULT))
+      {
+         _space_wait = nullptr;
+         Log::Write<Log::LEVEL_ERROR>("ERROR, RegisterWaitForSingleObject() failed with: %u\n", GetLastError());
+         result &= false;
+      }
+
+      return result;
+   }  // END Open()
+
+   //+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+
+   /// Takes on a client that attached, server only
+   //+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+
+   bool Channel::Accept_Peer()
+   {
+      uint32_t client_process = _header->client_process.load();
+
+      if (nullptr != _peer_process)
+      {
+         return true;
+      }
+      if (0 == client_process)
+      {
+         return false;
+      }
+
+      // A client gone before it was seen is let go of at once
+      _peer_process = OpenProcess(SYNCHRONIZE, FALSE, client_process);
+      if (nullptr == _peer_process)
+      {
+         Release_Peer();
+         return false;
+      }
+      return true;
+   }  // END Accept_Peer()
+
+   //+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+
+   /// Lets go of a client that left and empties both rings
+   //+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+
+   void Channel::Release_Peer()
+   {
+      //
+      // 1. Stop watching the client's process
+      if (nullptr != _peer_process)
+      {
+         CloseHandle(_peer_process);
+         _peer_process = nullptr;
+      }
+
+      //
+      // 2. Empty both rings for the next client
+      for (Ring_Header* ring : { _send_ring, _receive_ring })
+      {
+         ring->tail.store(0);
+         ring->head.store(0);
+         ring->is_consumer_sleeping.store(0);
+         ring->is_producer_waiting.store(0);
+      }
+      _cached_head = 0;
+      _cached_tail = 0;
+      _is_corrupt = false;
+
+      //
+      // 3. Last, the next client may claim it from here
+      _header->is_client_dropped.store(0);
+      _header->is_client_closed.store(0);
+      _header->client_process.store(0);
+   }  // END Release_Peer()
+
+   //+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+
+   /// Tells a client that wrote a broken record it is dropped
+   //+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+
+   void Channel::Drop_Peer()
+   {
+      _header->is_client_dropped.store(1);
+      SetEvent(_send_data_event);
+   }  // END Drop_Peer()
+
+   //+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+
+   /// Checks that the peer has not closed its end
+   //+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+
+   bool Channel::Is_Peer_Attached() const
+   {
+      if (_is_server)
+      {
+         return 0 != _header->client_process.load() && 0 == _header->is_client_closed.load();
+      }
+      return 0 != _header->server_process.load() && 0 == _header->is_client_dropped.load();
+   }  // END Is_Peer_Attached()
+
+   //+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+
+   /// Copies a message into the sending ring
+   //+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+
+   bool Channel::Write(const char* message, uint32_t length)
+   {
+      bool result = true;
+      uint64_t record = Record_Size(length);
+      uint64_t tail = _send_ring->tail.load(std::memory_order_relaxed);
+      uint64_t offset = tail & RING_MASK;
+      uint64_t skipped = (offset + record > RING_SIZE) ? (RING_SIZE - offset) : 0;
+
+      //
+      // 1. Only reload the peer's head when the cached one says full, then
+      //    ask for the space event and look once more in case the reader
+      //    made room before it could see the request
+      if ((tail + skipped + record) - _cached_head > RING_SIZE)
+      {
+         _cached_head = _send_ring->head.load(std::memory_order_acquire);
+         if ((tail + skipped + record) - _cached_head > RING_SIZE)
+         {
+            _send_ring->is_producer_waiting.store(1);
+            _cached_head = _send_ring->head.load();
+            if ((tail + skipped + record) - _cached_head > RING_SIZE)
+            {
+               result &= false;
+               return result;
+            }
+         }
+      }
+
+      //
+      // 2. A record never wraps, skip what is left of the ring
+      if (0 != skipped)
+      {
+         std::memcpy(_send_data + offset, &WRAP_MARKER, sizeof(WRAP_MARKER));
+         tail += skipped;
+         offset = 0;
+      }
+      std::memcpy(_send_data + offset, &length, sizeof(length));
+      std::memcpy(_send_data + offset + sizeof(length), message, length);
+
+      //
+      // 3. Publish, then wake the reader only if it went to sleep
+      _send_ring->tail.store(tail + record);
+      if (0 != _send_ring->is_consumer_sleeping.load())
+      {
+         SetEvent(_send_data_event);
+      }
+
+      return result;
+   }  // END Write()
+
+   //+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+
+   /// Copies the next message out of the receiving ring
+   //+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+
+   bool Channel::Read(Buffers::Buffer_View& message)
+   {
+      bool result = true;
+      uint64_t head = _receive_ring->head.load(std::memory_order_relaxed);
+      uint64_t offset = 0;
+      uint64_t available = 0;
+      uint64_t skipped = 0;
+      uint32_t length = 0;
+
+      //
+      // 1. Only reload the peer's tail when the cached one says empty,
+      //    nothing more is read from a peer that wrote a broken record
+      if (_is_corrupt)
+      {
+         result &= false;
+         return result;
+      }
+      if (head == _cached_tail)
+      {
+         _cached_tail = _receive_ring->tail.load(std::memory_order_acquire);
+         if (head == _cached_tail)
+         {
+            result &= false;
+            return result;
+         }
+      }
+
+      //
+      // 2. Follow a wrap to the record at the start of the ring
+      available = _cached_tail - head;
+      offset = head & RING_MASK;
+      std::memcpy(&length, _receive_data + offset, sizeof(length));
+      if (WRAP_MARKER == length)
+      {
+         skipped = RING_SIZE - offset;
+         offset = 0;
+         std::memcpy(&length, _receive_data, sizeof(length));
+      }
+
+      //
+      // 3. The peer wrote the ring, a record it did not publish or that runs
+      //    past the end of the ring is a broken peer, it is never read
+      if (RING_SIZE < available
+          ||
+          MAX_MESSAGE_SIZE < length
+          ||
+          offset + sizeof(length) + length > RING_SIZE
+          ||
+          skipped + Record_Size(length) > available)
+      {
+         Log::Write<Log::LEVEL_ERROR>("ERROR, shared memory record of %u bytes at %llu is past what the peer published\n",
+            length, static_cast<unsigned long long>(head));
+         _is_corrupt = true;
+         result &= false;
+         return result;
+      }
+      head += skipped;
+      message = Buffers::Receive_Pool().Acquire(length);
+      std::memcpy(message.Get_Buffer(), _receive_data + offset + sizeof(length), length);
+      message = message.Slice(0, length);
+
+      //
+      // 4. Free the record, then wake a writer waiting for room
+      _receive_ring->head.store(head + Record_Size(length));
+      if (0 != _receive_ring->is_producer_waiting.load() && 0 != _receive_ring->is_producer_waiting.exchange(0))
+      {
+         SetEvent(_receive_space_event);
+      }
+
+      return result;
+   }  // END Read()
+
+   //+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+
+   /// Tells the peer to set the data event from now on
+   //+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+
+   bool Channel::Begin_Sleep()
+   {
+      bool result = true;
+
+      // Pairs with the writer publishing its tail before it looks here
+      _receive_ring->is_consumer_sleeping.store(1);
+      _cached_tail = _receive_ring->tail.load();
+      if (_receive_ring->head.load(std::memory_order_relaxed) != _cached_tail)
+      {
+         End_Sleep();
+         result &= false;
+      }
+
+      return result;
+   }  // END Begin_Sleep()
+
+   //+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+
+   /// Tells the peer the reader is awake again
+   //+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+
+   void Channel::End_Sleep()
+   {
+      _receive_ring->is_consumer_sleeping.store(0, std::memory_order_relaxed);
+   }  // END End_Sleep()
+
+   //+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+
+   /// Has the socket's sending thread retry its backlog
+   //+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+
+   void CALLBACK Channel::Space_Available(PVOID context, BOOLEAN)
+   {
+      Channel* channel = static_cast<Channel*>(context);
+
+      Socket_Vars::Schedule_Send(channel->_socket_index, channel->_loop);
+   }  // END Space_Available()
+
+}  // END namespace Shared_Memory
@@ -0,0 +1,200 @@
+//+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+
+// 
+//  ___________ __  .__                       ___________
+//  \_   _____//  |_|  |__ _____    ____      \_   _____/
+//   |    __)_\   __\  |  \\__  \  /    \      |    __)_ 
+//   |        \|  | |   Y  \/ __ \|   |  \     |        \
+//  /_______  /|__| |___|  (____  /___|  / /\ /_______  /
+//          \/           \/     \/     \/  \/         \/ 
+// 
+// Shared Memory Transport Header File
+//
+//  Author   Date         Description
+// --------------------------------------------------------
+//  ECE      10-17-2026   Initial Implementation
+//  ECE      10-17-2026   A record that does not fit what the peer published drops it
+//+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+
+
+#pragma once
+
+#include "Buffer_Pool.h"
+#include "Lock_Free_Queue.h"
+
+#include <WinSock2.h>
+#include <atomic>
+#include <cstdint>
+#include <string>
+
+namespace Shared_Memory
+{
+   // Bytes of each direction's ring, a power of two, every record is a
+   // 4 byte length and the message padded to 8 bytes
+   constexpr uint32_t RING_SIZE{ 4 * 1024 * 1024 };
+
+   // Longest message a ring takes, a record never wraps so one that does
+   // not fit before the end of the ring skips to its start
+   constexpr uint32_t MAX_MESSAGE_SIZE{ RING_SIZE / 2 - 8 };
+
+   // Empty polls of a spinning reader before it sleeps on its event
+   constexpr uint32_t SPIN_COUNT{ 20000 };
+
+   // Length of a record that skips the rest of the ring
+   constexpr uint32_t WRAP_MARKER{ 0xFFFFFFFF };
+
+   // Positions of one direction, written in the mapping by both processes,
+   // each on its own cache line
+   struct Ring_Header
+   {
+      alignas(Lock_Free::CACHE_LINE_SIZE) std::atomic<uint64_t> tail;    // Written by the producer
+      alignas(Lock_Free::CACHE_LINE_SIZE) std::atomic<uint64_t> head;    // Written by the consumer
+      alignas(Lock_Free::CACHE_LINE_SIZE) std::atomic<uint32_t> is_consumer_sleeping;
+      std::atomic<uint32_t> is_producer_waiting;                         // Ring was full
+   };
+
+   // Start of the mapping, the rings' bytes follow it
+   struct Mapping_Header
+   {
+      std::atomic<uint32_t> magic;               // Set once the server is ready
+      uint32_t ring_size;
+      std::atomic<uint32_t> server_process;      // 0 once the server closed
+      std::atomic<uint32_t> client_process;      // 0 until a client attaches
+      std::atomic<uint32_t> is_client_closed;    // Cleared by the server for the next client
+      std::atomic<uint32_t> is_client_dropped;   // Set by the server for a broken client
+      Ring_Header rings[2];                      // To the client, to the server
+   };
+
+   //+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+
+   /// @brief   One end of a shared memory link, a mapping named
+   /// @brief   after the socket with a single-producer, single-
+   /// @brief   consumer ring per direction. Events are only set
+   /// @brief   for a peer that said it is sleeping, and a full
+   /// @brief   ring's space event schedules the socket's sending
+   /// @brief   thread through a thread pool wait
+   //+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+
+   class Channel
+   {
+   public:
+
+      Channel() = default;
+      Channel(const Channel&) = delete;
+      Channel& operator=(const Channel&) = delete;
+
+      //+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+
+      /// @brief   Destructor, unmaps and closes everything
+      //+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+
+      ~Channel();
+
+      //+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+
+      /// @brief   Creates the mapping as its server, or opens the
+      /// @brief   one a server created as its only client
+      /// @param   std::string       Name of the link
+      /// @param   bool              True for the server
+      /// @param   uint32_t          Index of the socket's queues
+      /// @param   uint16_t          Event loop sending for it
+      /// @return  bool              False if it could not be made or opened
+      //+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+
+      bool Open(const std::string& name, bool is_server, uint32_t socket_index, uint16_t loop);
+
+      //+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+
+      /// @brief   Server only, takes on a client that attached and
+      /// @brief   watches its process from then on
+      /// @return  bool              True once a client is attached
+      //+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+
+      bool Accept_Peer();
+
+      //+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+
+      /// @brief   Server only, lets go of a client that left and
+      /// @brief   empties both rings for the next one, nothing
+      /// @brief   may be writing meanwhile
+      /// @return  None
+      //+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+
+      void Release_Peer();
+
+      //+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+
+      /// @brief   Server only, tells a client that wrote a broken
+      /// @brief   record it is dropped, it lets go of the mapping
+      /// @return  None
+      //+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+
+      void Drop_Peer();
+
+      //+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+
+      /// @brief   Checks that the peer has not closed its end, a
+      /// @brief   peer that exits is seen through Get_Peer_Process()
+      /// @return  bool              True while the peer is attached
+      //+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+
+      bool Is_Peer_Attached() const;
+
+      //+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+
+      /// @brief   Copies a message into the sending ring, producer
+      /// @brief   thread only, wakes the peer if it sleeps
+      /// @param   char*             Message
+      /// @param   uint32_t          Length, up to MAX_MESSAGE_SIZE
+      /// @return  bool              False if the ring is full, the
+      /// @return  bool              socket is scheduled once it is not
+      //+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+
+      bool Write(const char* message, uint32_t length);
+
+      //+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+
+      /// @brief   Copies the next message out of the receiving ring
+      /// @brief   into a pooled buffer, consumer thread only, wakes
+      /// @brief   a peer waiting for room, a record past what the
+      /// @brief   peer published is never read, see Is_Corrupt()
+      /// @param   Buffer_View&      Returning message
+      /// @return  bool              False if the ring is empty or corrupt
+      //+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+
+      bool Read(Buffers::Buffer_View& message);
+
+      //+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+
+      /// @brief   Tells the peer to set the data event from now on,
+      /// @brief   consumer thread only, End_Sleep() once woken
+      /// @return  bool              False if a message came meanwhile
+      //+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+
+      bool Begin_Sleep();
+      void End_Sleep();
+
+      // Set when a message arrives for a sleeping reader
+      inline HANDLE Get_Data_Event() const { return _receive_data_event; }
+
+      // Set once the peer wrote a broken record, nothing more is read from it
+      inline bool Is_Corrupt() const { return _is_corrupt; }
+
+      // Signaled when the peer's process exits, nullptr until there is a peer
+      inline HANDLE Get_Peer_Process() const { return _peer_process; }
+
+   private:
+
+      //+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+
+      /// @brief   Thread pool callback for the space event, has the
+      /// @brief   socket's sending thread retry its backlog
+      /// @param   PVOID             Channel
+      /// @param   BOOLEAN           Unused, the wait has no timeout
+      /// @return  None
+      //+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+
+      static void CALLBACK Space_Available(PVOID context, BOOLEAN is_timeout);
+
+      // Rounds a record of length bytes up to the next 8
+      static inline uint64_t Record_Size(uint32_t length) { return (sizeof(uint32_t) + length + 7) & ~uint64_t{ 7 }; }
+
+      HANDLE _mapping = nullptr;
+      Mapping_Header* _header = nullptr;
+      Ring_Header* _send_ring = nullptr;
+      Ring_Header* _receive_ring = nullptr;
+      char* _send_data = nullptr;
+      char* _receive_data = nullptr;
+      uint64_t _cached_head = 0;                 // Producer's copy of the peer's head
+      uint64_t _cached_tail = 0;                 // Consumer's copy of the peer's tail
+      HANDLE _receive_data_event = nullptr;      // Waited on by this end
+      HANDLE _send_data_event = nullptr;         // Set for the peer
+      HANDLE _send_space_event = nullptr;        // Waited on by the thread pool
+      HANDLE _receive_space_event = nullptr;     // Set for the peer
+      HANDLE _space_wait = nullptr;
+      HANDLE _peer_process = nullptr;
+      uint32_t _socket_index = 0;
+      uint16_t _loop = 0;
+      bool _is_server = false;
+      bool _is_attached = false;                 // Claimed its side of the mapping
+      bool _is_corrupt = false;                  // Consumer thread only, see Read()
+
+   };  // END class Channel
+
+}  // END namespace Shared_Memory
@@ -0,0 +1,398 @@
+//+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+
+// 
+//  ___________ __  .__                       ___________
+//  \_   _____//  |_|  |__ _____    ____      \_   _____/
+//   |    __)_\   __\  |  \\__  \  /    \      |    __)_ 
+//   |        \|  | |   Y  \/ __ \|   |  \     |        \
+//  /_______  /|__| |___|  (____  /___|  / /\ /_______  /
+//          \/           \/     \/     \/  \/         \/ 
+// 
+// Asynchronous Logging Implementation File
+//
+//  Author   Date         Description
+// --------------------------------------------------------
+//  ECE      10-17-2026   Initial Implementation
+//  ECE      10-17-2026   Rings of exited threads are freed once drained
+//+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+
+
+#include "Socket_Log.h"
+
+#include <WinSock2.h>
+#include <atomic>
+#include <mutex>
+#include <string>
+#include <thread>
+#include <vector>
+
+namespace Log
+{
+   // Records the drain thread formats per ring before moving to the next
+   constexpr size_t DRAIN_BATCH{ 64 };
+
+   // One per thread that has logged, a thread that exits retires its ring
+   // and the drainer frees it once everything on it has been written
+   struct Thread_Ring
+   {
+      Lock_Free::SPSC_Queue<Record> records;
+      std::atomic<uint64_t> dropped{ 0 };
+      std::atomic<bool> is_retired{ false };
+      uint64_t reported_dropped = 0;      // Drainer only
+      uint32_t thread_number = 0;
+   };
+
+   // Every live ring, and the right to drain them, one drainer at a time,
+   // never destroyed so the drain thread can outlive static destruction
+   std::mutex ring_mutex;
+   std::vector<Thread_Ring*>& rings = *new std::vector<Thread_Ring*>;
+   uint32_t next_thread_number = 0;       // ring_mutex
+
+   // Dropped counts of freed rings, and records logged by a thread after
+   // its ring was retired, so Get_Dropped() still counts them
+   std::atomic<uint64_t> retired_dropped{ 0 };
+
+   // Drain thread, started by the first record
+   std::once_flag drain_started;
+   HANDLE drain_event = nullptr;
+
+   // The calling thread's ring, nullptr until it first logs, retired when
+   // the thread exits, records logged later in its exit are dropped
+   struct Ring_Owner
+   {
+      Thread_Ring* ring = nullptr;
+      bool is_exited = false;
+
+      ~Ring_Owner()
+      {
+         if (nullptr != ring)
+         {
+            ring->is_retired.store(true, std::memory_order_release);
+            SetEvent(drain_event);
+         }
+         ring = nullptr;
+         is_exited = true;
+      }
+   };
+   thread_local Ring_Owner thread_ring;
+   std::atomic<FILE*> output{ nullptr };
+
+   // Timestamps are printed as seconds since the program started logging
+   const int64_t log_start = std::chrono::duration_cast<std::chrono::nanoseconds>(
+      std::chrono::steady_clock::now().time_since_epoch()).count();
+
+   //+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+
+   /// Name printed ahead of every record of a level
+   //+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+
+   static const char* Level_Name(Level level)
+   {
+      static const char* names[LEVEL_OFF] = { "DEBUG", "INFO", "WARNING", "ERROR" };
+
+      return (LEVEL_OFF > level) ? names[level] : "";
+   }  // END Level_Name()
+
+   //+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+
+   /// Takes the next argument off a record, false once none are left
+   //+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+
+   static bool Next_Argument(const Record& record, size_t& offset, Argument_Type& type, uint64_t& value, std::string& text)
+   {
+      uint16_t length;
+
+      if (offset >= record.size)
+      {
+         return false;
+      }
+      type = static_cast<Argument_Type>(record.arguments[offset]);
+      offset++;
+      if (TEXT == type)
+      {
+         memcpy(&length, record.arguments + offset, sizeof(length));
+         text.assign(record.arguments + offset + sizeof(length), length);
+         offset += sizeof(length) + length;
+      }
+      else
+      {
+         memcpy(&value, record.arguments + offset, sizeof(value));
+         offset += sizeof(value);
+      }
+      return true;
+   }  // END Next_Argument()
+
+   //+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+
+   /// Formats a record onto the end of a line, each conversion is
+   /// given to snprintf on its own with the length modifier that
+   /// matches how its argument was stored
+   //+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+
+   static void Format_Record(const Record& record, std::string& line)
+   {
+      const char* format = record.format;
+      size_t offset = 0;
+      Argument_Type type = SIGNED;
+      uint64_t value = 0;
+      std::string text;
+      std::string spec;
+      char buffer[512];
+      int length;
+
+      while ('\0' != *format)
+      {
+         //
+         // 1. Plain characters and %% go straight onto the line
+         if ('%' != *format)
+         {
+            line += *format++;
+            continue;
+         }
+         if ('%' == format[1])
+         {
+            line += '%';
+            format += 2;
+            continue;
+         }
+
+         //
+         // 2. Keep the flags, width and precision, drop the length
+         //    modifier, the stored argument decides it
+         spec = "%";
+         format++;
+         while ('\0' != *format && nullptr != strchr("-+ #0123456789.", *format))
+         {
+            spec += *format++;
+         }
+         while ('\0' != *format && nullptr != strchr("hljztLI", *format))
+         {
+            format++;
+         }
+         if ('\0' == *format)
+         {
+            break;
+         }
+
+         //
+         // 3. One argument per conversion, missing ones leave the
+         //    conversion in the line as written
+         if (!Next_Argument(record, offset, type, value, text))
+         {
+            line += spec;
+            line += *format++;
+            continue;
+         }
+         switch (type)
+         {
+         case TEXT:
+            spec += 's';
+            length = snprintf(buffer, sizeof(buffer), spec.c_str(), text.c_str());
+            break;
+         case FLOATING:
+         {
+            double floating;
+            memcpy(&floating, &value, sizeof(floating));
+            spec += (nullptr != strchr("eEfFgGaA", *format)) ? *format : 'f';
+            length = snprintf(buffer, sizeof(buffer), spec.c_str(), floating);
+            break;
+         }
+         case POINTER:
+            spec += 'p';
+            length = snprintf(buffer, sizeof(buffer), spec.c_str(), reinterpret_cast<void*>(static_cast<uintptr_t>(value)));
+            break;
+         default:
+            if ('c' == *format)
+            {
+               spec += 'c';
+               length = snprintf(buffer, sizeof(buffer), spec.c_str(), static_cast<int>(value));
+            }
+            else
+            {
+               spec += "ll";
+               spec += (nullptr != strchr("diouxX", *format)) ? *format : ((SIGNED == type) ? 'd' : 'u');
+               length = snprintf(buffer, sizeof(buffer), spec.c_str(), static_cast<long long>(value));
+            }
+            break;
+         }
+         if (0 < length)
+         {
+            line.append(buffer, (sizeof(buffer) <= static_cast<size_t>(length)) ? sizeof(buffer) - 1 : length);
+         }
+         format++;
+      }
+   }  // END Format_Record()
+
+   //+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+
+   /// Formats and writes everything on every ring, ring_mutex
+   /// must be held, rings are taken in turn so lines of different
+   /// threads may be out of time order by up to one pass, rings
+   /// retired before they were drained are freed
+   //+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+
+   static void Drain_Rings()
+   {
+      static Record records[DRAIN_BATCH];
+      static std::string line;
+      FILE* file = output.load(std::memory_order_relaxed);
+      size_t popped;
+      uint64_t dropped;
+      bool is_retired;
+      bool is_written = false;
+
+      if (nullptr == file)
+      {
+         file = stdout;
+      }
+      for (auto next = rings.begin(); next != rings.end();)
+      {
+         Thread_Ring* ring = *next;
+
+         //
+         // 0. Its thread pushes nothing more once it is retired, so this
+         //    pass takes the last of its records
+         is_retired = ring->is_retired.load(std::memory_order_acquire);
+
+         //
+         // 1. Say how many records the ring could not take since last time
+         dropped = ring->dropped.load(std::memory_order_relaxed);
+         if (dropped != ring->reported_dropped)
+         {
+            fprintf(file, "WARNING [T%u] %llu log records dropped, ring full\n",
+                    ring->thread_number, static_cast<unsigned long long>(dropped - ring->reported_dropped));
+            ring->reported_dropped = dropped;
+            is_written = true;
+         }
+
+         //
+         // 2. Then every record, a batch at a time
+         do
+         {
+            popped = ring->records.Pop_Batch(records, DRAIN_BATCH);
+            for (size_t i = 0; i < popped; i++)
+            {
+               char prefix[64];
+               snprintf(prefix, sizeof(prefix), "[%12.6f] %-7s [T%u] ",
+                        (records[i].timestamp - log_start) / 1e9, Level_Name(records[i].level), ring->thread_number);
+               line = prefix;
+               Format_Record(records[i], line);
+               if (line.empty() || '\n' != line.back())
+               {
+                  line += '\n';
+               }
+               fwrite(line.data(), 1, line.size(), file);
+               is_written = true;
+            }
+         } while (DRAIN_BATCH == popped);
+
+         //
+         // 3. A drained retired ring is unlinked and freed
+         if (is_retired)
+         {
+            retired_dropped.fetch_add(ring->dropped.load(std::memory_order_relaxed), std::memory_order_relaxed);
+            delete ring;
+            next = rings.erase(next);
+         }
+         else
+         {
+            ++next;
+         }
+      }
+      if (is_written)
+      {
+         fflush(file);
+      }
+   }  // END Drain_Rings()
+
+   //+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+
+   /// Drains the rings every DRAIN_INTERVAL_MS, or sooner when a
+   /// warning or error wakes it, for the life of the program
+   //+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+
+   static void Drain_Thread()
+   {
+      while (true)
+      {
+         WaitForSingleObject(drain_event, DRAIN_INTERVAL_MS);
+         std::lock_guard<std::mutex> lock(ring_mutex);
+         Drain_Rings();
+      }
+   }  // END Drain_Thread()
+
+   //+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+
+   /// Starts the drain thread once
+   //+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+
+   static void Start_Drain()
+   {
+      std::call_once(drain_started, []()
+      {
+         drain_event = CreateEvent(nullptr, FALSE, FALSE, nullptr);
+         std::thread(Drain_Thread).detach();
+      });
+   }  // END Start_Drain()
+
+   //+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+
+   /// Puts a record on the calling thread's ring
+   //+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+
+   void Submit(const Record& record)
+   {
+      Thread_Ring* ring = thread_ring.ring;
+
+      //
+      // 1. First record from this thread, make and register its ring, a
+      //    thread already past retiring its ring has nowhere to put it
+      if (nullptr == ring)
+      {
+         if (thread_ring.is_exited)
+         {
+            retired_dropped.fetch_add(1, std::memory_order_relaxed);
+            return;
+         }
+         Start_Drain();
+         ring = new Thread_Ring;
+         ring->records.Initialize(RING_CAPACITY);
+         std::lock_guard<std::mutex> lock(ring_mutex);
+         ring->thread_number = next_thread_number++;
+         rings.push_back(ring);
+         thread_ring.ring = ring;
+      }
+
+      //
+      // 2. Never wait on the drain thread, a full ring loses the record
+      //    and hurries the drain thread along
+      if (!ring->records.Push(record))
+      {
+         ring->dropped.fetch_add(1, std::memory_order_relaxed);
+         SetEvent(drain_event);
+      }
+      else if (LEVEL_WARNING <= record.level)
+      {
+         SetEvent(drain_event);
+      }
+   }  // END Submit()
+
+   //+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+
+   /// Drains every ring from the calling thread
+   //+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+
+   void Flush()
+   {
+      std::lock_guard<std::mutex> lock(ring_mutex);
+      Drain_Rings();
+   }  // END Flush()
+
+   //+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+
+   /// Sends formatted lines to another file
+   //+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+
+   void Set_Output(FILE* file)
+   {
+      Flush();
+      output.store(file, std::memory_order_relaxed);
+   }  // END Set_Output()
+
+   //+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+
+   /// Records lost on full rings
+   //+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+
+   uint64_t Get_Dropped()
+   {
+      uint64_t dropped = 0;
+      std::lock_guard<std::mutex> lock(ring_mutex);
+
+      dropped += retired_dropped.load(std::memory_order_relaxed);
+      for (Thread_Ring* ring : rings)
+      {
+         dropped += ring->dropped.load(std::memory_order_relaxed);
+      }
+      return dropped;
+   }  // END Get_Dropped()
+
+}  // END namespace Log
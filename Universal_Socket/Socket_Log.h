@@ -0,0 +1,221 @@
+//+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+
+// 
+//  ___________ __  .__                       ___________
+//  \_   _____//  |_|  |__ _____    ____      \_   _____/
+//   |    __)_\   __\  |  \\__  \  /    \      |    __)_ 
+//   |        \|  | |   Y  \/ __ \|   |  \     |        \
+//  /_______  /|__| |___|  (____  /___|  / /\ /_______  /
+//          \/           \/     \/     \/  \/         \/ 
+// 
+// Asynchronous Logging Header File
+//
+//  Author   Date         Description
+// --------------------------------------------------------
+//  ECE      10-17-2026   Initial Implementation
+//+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+
+
+#pragma once
+
+#include "Lock_Free_Queue.h"
+
+#include <chrono>
+#include <cstddef>
+#include <cstdint>
+#include <cstdio>
+#include <cstring>
+#include <string_view>
+#include <type_traits>
+
+// Least severe level compiled in, anything under it costs nothing, debug
+// builds keep every level, release builds drop LEVEL_DEBUG
+#ifndef UNIVERSAL_SOCKET_LOG_LEVEL
+#ifdef _DEBUG
+#define UNIVERSAL_SOCKET_LOG_LEVEL 0
+#else
+#define UNIVERSAL_SOCKET_LOG_LEVEL 1
+#endif
+#endif
+
+namespace Log
+{
+   enum Level
+   {
+      LEVEL_DEBUG = 0,     // Every message received
+      LEVEL_INFO = 1,      // Sockets and threads starting, stopping and connecting
+      LEVEL_WARNING = 2,   // Something was dropped or worked around
+      LEVEL_ERROR = 3,     // A call failed
+      LEVEL_OFF = 4
+   };
+
+   constexpr Level COMPILED_LEVEL{ static_cast<Level>(UNIVERSAL_SOCKET_LOG_LEVEL) };
+
+   // Records each thread's ring holds before further records are dropped
+   constexpr size_t RING_CAPACITY{ 1024 };
+
+   // Bytes of arguments a record carries, a text argument is cut short
+   // when the rest of the record cannot hold it
+   constexpr size_t MAX_ARGUMENT_BYTES{ 224 };
+
+   // Longest the drain thread sleeps between looks at the rings, warnings
+   // and errors wake it at once
+   constexpr uint32_t DRAIN_INTERVAL_MS{ 10 };
+
+   // How each argument was stored, the drain thread formats from these
+   enum Argument_Type : uint8_t
+   {
+      SIGNED = 0,       // Any signed integer, widened to 64 bits
+      UNSIGNED = 1,     // Any unsigned integer, bool or enum, widened to 64 bits
+      FLOATING = 2,     // float or double, stored as double
+      TEXT = 3,         // Characters copied in, a 16 bit length first
+      POINTER = 4
+   };
+
+   // One call to Write(), formatted later on the drain thread, so the
+   // format must be a string literal that outlives the program's logging
+   struct Record
+   {
+      const char* format = nullptr;
+      int64_t timestamp = 0;           // Nanoseconds, steady clock
+      Level level = LEVEL_INFO;
+      uint16_t size = 0;               // Bytes of arguments used
+      char arguments[MAX_ARGUMENT_BYTES];
+   };
+
+   //+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+
+   /// @brief   Stores one fixed size argument in a record
+   /// @param   Record            Record being built
+   /// @param   Argument_Type     Type tag
+   /// @param   void*             Value, 8 bytes
+   /// @return  None
+   //+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+
+   inline void Store(Record& record, Argument_Type type, const void* value)
+   {
+      if (MAX_ARGUMENT_BYTES - record.size >= 1 + sizeof(uint64_t))
+      {
+         record.arguments[record.size] = static_cast<char>(type);
+         memcpy(record.arguments + record.size + 1, value, sizeof(uint64_t));
+         record.size = static_cast<uint16_t>(record.size + 1 + sizeof(uint64_t));
+      }
+   }
+
+   //+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+
+   /// @brief   Copies text into a record, as much as still fits
+   /// @param   Record            Record being built
+   /// @param   string_view       Text, need not be null terminated
+   /// @return  None
+   //+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+
+   inline void Store_Text(Record& record, std::string_view text)
+   {
+      size_t space = MAX_ARGUMENT_BYTES - record.size;
+      uint16_t length;
+
+      if (space < 1 + sizeof(length))
+      {
+         return;
+      }
+      space -= 1 + sizeof(length);
+      length = static_cast<uint16_t>((text.size() < space) ? text.size() : space);
+      record.arguments[record.size] = static_cast<char>(TEXT);
+      memcpy(record.arguments + record.size + 1, &length, sizeof(length));
+      memcpy(record.arguments + record.size + 1 + sizeof(length), text.data(), length);
+      record.size = static_cast<uint16_t>(record.size + 1 + sizeof(length) + length);
+   }
+
+   //+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+
+   /// @brief   Stores an argument as its binary value, nothing is
+   /// @brief   formatted until the drain thread prints it
+   /// @param   Record            Record being built
+   /// @param   T                 Integer, enum, floating point,
+   /// @param   T                 pointer or anything that is text
+   /// @return  None
+   //+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+
+   template <typename T>
+   inline void Store_Argument(Record& record, const T& argument)
+   {
+      if constexpr (std::is_same_v<T, const char*> || std::is_same_v<T, char*>)
+      {
+         Store_Text(record, (nullptr != argument) ? std::string_view(argument) : std::string_view("(null)"));
+      }
+      else if constexpr (std::is_convertible_v<const T&, std::string_view>)
+      {
+         Store_Text(record, std::string_view(argument));
+      }
+      else if constexpr (std::is_floating_point_v<T>)
+      {
+         double value = static_cast<double>(argument);
+         Store(record, FLOATING, &value);
+      }
+      else if constexpr (std::is_integral_v<T> && std::is_signed_v<T>)
+      {
+         int64_t value = static_cast<int64_t>(argument);
+         Store(record, SIGNED, &value);
+      }
+      else if constexpr (std::is_integral_v<T> || std::is_enum_v<T>)
+      {
+         uint64_t value = static_cast<uint64_t>(argument);
+         Store(record, UNSIGNED, &value);
+      }
+      else
+      {
+         static_assert(std::is_pointer_v<T>, "Log arguments are numbers, pointers or text");
+         uint64_t value = reinterpret_cast<uintptr_t>(argument);
+         Store(record, POINTER, &value);
+      }
+   }
+
+   //+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+
+   /// @brief   Puts a record on the calling thread's ring, its
+   /// @brief   ring is made the first time it logs, dropped and
+   /// @brief   counted when the ring is full, never blocks
+   /// @param   Record            Finished record
+   /// @return  None
+   //+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+
+   void Submit(const Record& record);
+
+   //+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+
+   /// @brief   Logs a printf style message, removed at compile
+   /// @brief   time under COMPILED_LEVEL, otherwise only the
+   /// @brief   arguments' bytes are copied on the calling thread.
+   /// @brief   %.*s is not supported, pass a string_view instead
+   /// @param   char*             Format, a string literal
+   /// @param   Args              Arguments for the format
+   /// @return  None
+   //+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+
+   template <Level level, typename... Args>
+   inline void Write(const char* format, const Args&... arguments)
+   {
+      if constexpr (level >= COMPILED_LEVEL && LEVEL_OFF > level)
+      {
+         Record record;
+         record.format = format;
+         record.level = level;
+         record.timestamp = std::chrono::duration_cast<std::chrono::nanoseconds>(
+            std::chrono::steady_clock::now().time_since_epoch()).count();
+         (Store_Argument(record, arguments), ...);
+         Submit(record);
+      }
+   }
+
+   //+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+
+   /// @brief   Formats and writes everything waiting on every
+   /// @brief   ring from the calling thread, before exiting or
+   /// @brief   to read the log in step with other output
+   /// @return  None
+   //+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+
+   void Flush();
+
+   //+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+
+   /// @brief   Sends formatted lines somewhere other than stdout,
+   /// @brief   what is already waiting goes to the old output
+   /// @param   FILE*             Open file, nullptr for stdout
+   /// @return  None
+   //+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+
+   void Set_Output(FILE* file);
+
+   //+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+
+   /// @brief   Records dropped on full rings since the start
+   /// @return  uint64_t          Dropped records
+   //+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+
+   uint64_t Get_Dropped();
+
+}  // END namespace Log
@@ -0,0 +1,557 @@
+//+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+
+// 
+//  ___________ __  .__                       ___________
+//  \_   _____//  |_|  |__ _____    ____      \_   _____/
+//   |    __)_\   __\  |  \\__  \  /    \      |    __)_ 
+//   |        \|  | |   Y  \/ __ \|   |  \     |        \
+//  /_______  /|__| |___|  (____  /___|  / /\ /_______  /
+//          \/           \/     \/     \/  \/         \/ 
+// 
+// Socket Registry Implementation File
+//
+//  Author   Date         Description
+// --------------------------------------------------------
+//  ECE      10-17-2026   Initial Implementation
+//  ECE      10-17-2026   Send watermarks reset with the slot
+//  ECE      10-17-2026   Added Get_Snapshot and Get_Snapshots
+//  ECE      10-17-2026   Messages go to the asynchronous log
+//  ECE      10-17-2026   A socket leaving a loop cancels its timers there
+//  ECE      10-17-2026   Queued messages are held in pooled buffers
+//  ECE      10-17-2026   Recycling drops queued sends with their destinations
+//+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+
+
+#include "Socket_Registry.h"
+#include "Socket_Log.h"
+
+#include <thread>
+
+namespace Socket_Vars
+{
+   //+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+
+   /// Registry every socket is created in
+   //+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+
+   Socket_Registry& Sockets()
+   {
+      static Socket_Registry registry;
+      return registry;
+   }  // END Sockets()
+
+   //-+-+-+-+-+-+-+-+-+-+-+Retire_Task FUNCTIONS+-+-+-+-+-+-+-+-+-+-+-+-+
+
+   //+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+
+   /// Closes the socket once its handlers are done, frees the slot
+   //+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+
+   void Retire_Task::Run()
+   {
+      Socket_Slot& slot = registry->Get_Slot(socket_index);
+      Universal_Socket* socket = slot.socket.load(std::memory_order_acquire);
+
+      //
+      // 1. No event loop reaches the socket anymore, but messages it posted
+      //    may still be waiting on its strands and Start() may still be
+      //    running, look again once the pool has run them
+      if (slot.is_starting.load(std::memory_order_acquire) || !socket->Is_Idle())
+      {
+         std::this_thread::yield();
+         Work_Pool::Handler_Pool().Defer(this);
+         return;
+      }
+
+      //
+      // 2. Close and delete the socket, then free the slot
+      socket->Stop();
+      delete socket;
+      registry->Recycle(socket_index);
+   }  // END Run()
+
+}  // END namespace Socket_Vars
+
+//+-+-+-+-+-+-+-+-+-+-+PRIVATE FUNCTIONS+-+-+-+-+-+-+-+-+-+-+-+-+-+
+
+//+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+
+/// Allocates the next slab and frees its slots
+//+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+
+bool Socket_Registry::Add_Slab()
+{
+   bool result = true;
+
+   uint32_t slab = _slab_count;
+
+   //
+   // 1. Check there is a slab left
+   if (Socket_Vars::MAX_SOCKET_SLABS <= slab)
+   {
+      Log::Write<Log::LEVEL_WARNING>("Too many sockets!\n");
+      result &= false;
+      return result;
+   }
+
+   //
+   // 2. Give every slot one link of each kind per event loop, the send
+   //    queue is only allocated once a socket takes the slot
+   Socket_Vars::Socket_Slot* slots = new Socket_Vars::Socket_Slot[Socket_Vars::SOCKETS_PER_SLAB];
+   for (uint32_t i = 0; i < Socket_Vars::SOCKETS_PER_SLAB; i++)
+   {
+      uint32_t socket_index = slab * Socket_Vars::SOCKETS_PER_SLAB + i;
+
+      slots[i].scheduled.reset(new Socket_Vars::Socket_Link[Socket_Vars::event_loop_count]);
+      slots[i].joined.reset(new Socket_Vars::Socket_Link[Socket_Vars::event_loop_count]);
+      slots[i].loop_position.reset(new uint32_t[Socket_Vars::event_loop_count]);
+      for (uint16_t loop = 0; loop < Socket_Vars::event_loop_count; loop++)
+      {
+         slots[i].scheduled[loop].socket_index = socket_index;
+         slots[i].scheduled[loop].kind = Socket_Vars::SEND_SCHEDULED;
+         slots[i].joined[loop].socket_index = socket_index;
+         slots[i].joined[loop].kind = Socket_Vars::LOOP_JOIN;
+      }
+      slots[i].retired.socket_index = socket_index;
+      slots[i].retired.kind = Socket_Vars::LOOP_LEAVE;
+      slots[i].retire_task.registry = this;
+      slots[i].retire_task.socket_index = socket_index;
+      slots[i].retire_task.Set_Home_Worker(static_cast<uint16_t>(socket_index));
+   }
+
+   //
+   // 3. Publish the slab, then free its slots lowest index last so it is used first
+   _slabs[slab].store(slots, std::memory_order_release);
+   _slab_count = slab + 1;
+   for (uint32_t i = Socket_Vars::SOCKETS_PER_SLAB; i > 0; i--)
+   {
+      _free.push_back(slab * Socket_Vars::SOCKETS_PER_SLAB + i - 1);
+   }
+
+   return result;
+}  // END Add_Slab()
+
+//+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+
+/// Checks a handle still names a live socket
+//+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+
+bool Socket_Registry::Is_Live(Socket_Vars::Socket_Handle handle)
+{
+   if (_slab_count * Socket_Vars::SOCKETS_PER_SLAB <= handle.index)
+   {
+      return false;
+   }
+
+   Socket_Vars::Socket_Slot& slot = Get_Slot(handle.index);
+   return nullptr != slot.socket.load(std::memory_order_relaxed)
+      && handle.generation == slot.generation.load(std::memory_order_relaxed);
+}  // END Is_Live()
+
+//+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+
+/// Hands a leaving socket to the next event loop
+//+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+
+void Socket_Registry::Pass_On(Socket_Vars::Socket_Link* link, uint16_t loop)
+{
+   Socket_Vars::Socket_Slot& slot = Get_Slot(link->socket_index);
+
+   //
+   // 1. The next loop lets go of it the same way, in order behind anything
+   //    already queued for it
+   if (loop < Socket_Vars::event_loop_count)
+   {
+      _loops[loop].changes.Push(link);
+      Socket_Vars::Wake_Event_Loop(loop);
+      return;
+   }
+
+   //
+   // 2. Every loop has let go, the handler pool finishes it off
+   Work_Pool::Handler_Pool().Submit(&slot.retire_task);
+}  // END Pass_On()
+
+//-+-+-+-+-+-+-+-+-+-+-+PUBLIC FUNCTIONS+-+-+-+-+-+-+-+-+-+-+-+-+-+
+
+//+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+
+/// Constructor
+//+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+
+Socket_Registry::Socket_Registry()
+{
+   for (uint32_t i = 0; i < Socket_Vars::MAX_SOCKET_SLABS; i++)
+   {
+      _slabs[i].store(nullptr, std::memory_order_relaxed);
+   }
+   _slab_count = 0;
+   _live_count.store(0, std::memory_order_relaxed);
+}  // END Constructor
+
+//+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+
+/// Creates a socket
+//+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+
+Socket_Vars::Socket_Handle Socket_Registry::Create(
+   Socket_Vars::Protocol protocol_type,
+   Socket_Vars::Connection_Type connection_type,
+   std::string ip_address,
+   uint16_t port,
+   std::string name)
+{
+   Socket_Vars::Socket_Handle handle;
+
+   //
+   // 1. The socket takes its slot while it is constructed, outside the lock
+   Universal_Socket* socket = new Universal_Socket(protocol_type, connection_type, ip_address, port, name);
+   if (Socket_Vars::NO_SOCKET == socket->Get_Queue_Index())
+   {
+      delete socket;
+      return handle;
+   }
+
+   //
+   // 2. Publish it and add it to the dense list
+   std::lock_guard<std::mutex> lock(_mutex);
+   Socket_Vars::Socket_Slot& slot = Get_Slot(socket->Get_Queue_Index());
+   slot.dense_position = static_cast<uint32_t>(_dense.size());
+   slot.name = name;
+   _dense.push_back(socket->Get_Queue_Index());
+   slot.socket.store(socket, std::memory_order_release);
+   _live_count.fetch_add(1, std::memory_order_relaxed);
+
+   handle.index = socket->Get_Queue_Index();
+   handle.generation = slot.generation.load(std::memory_order_relaxed);
+   return handle;
+}  // END Create()
+
+//+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+
+/// Opens a created socket and hands it to its event loops
+//+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+
+bool Socket_Registry::Start(Socket_Vars::Socket_Handle handle)
+{
+   bool result = true;
+   Universal_Socket* socket;
+
+   //
+   // 1. Claim the start, a Destroy() meanwhile leaves the socket alone
+   //    until the start is done
+   {
+      std::lock_guard<std::mutex> lock(_mutex);
+      if (!Is_Live(handle) || Get_Slot(handle.index).is_started)
+      {
+         result &= false;
+         return result;
+      }
+      Get_Slot(handle.index).is_started = true;
+      Get_Slot(handle.index).is_starting.store(true, std::memory_order_release);
+   }
+   Socket_Vars::Socket_Slot& slot = Get_Slot(handle.index);
+   socket = slot.socket.load(std::memory_order_acquire);
+
+   //
+   // 2. Open it without the lock held, a TCP client connects here
+   result &= socket->Start();
+
+   //
+   // 3. Hand it to its loops unless it was destroyed while opening, the
+   //    joins are queued under the lock so they are ahead of the leave
+   {
+      std::lock_guard<std::mutex> lock(_mutex);
+      if (result && Is_Live(handle))
+      {
+         uint16_t owner = Socket_Vars::Get_Event_Loop(handle.index);
+         for (uint16_t loop = 0; loop < Socket_Vars::event_loop_count; loop++)
+         {
+            if (loop == owner || socket->Has_Connections())
+            {
+               _loops[loop].changes.Push(&slot.joined[loop]);
+               Socket_Vars::Wake_Event_Loop(loop);
+            }
+         }
+      }
+      slot.is_starting.store(false, std::memory_order_release);
+   }
+
+   return result;
+}  // END Start()
+
+//+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+
+/// Destroys a socket
+//+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+
+bool Socket_Registry::Destroy(Socket_Vars::Socket_Handle handle)
+{
+   bool result = true;
+
+   //
+   // 1. Stale the handle and swap the last live socket into its dense position
+   {
+      std::lock_guard<std::mutex> lock(_mutex);
+      if (!Is_Live(handle))
+      {
+         result &= false;
+         return result;
+      }
+
+      Socket_Vars::Socket_Slot& slot = Get_Slot(handle.index);
+      uint32_t moved = _dense.back();
+      _dense[slot.dense_position] = moved;
+      Get_Slot(moved).dense_position = slot.dense_position;
+      _dense.pop_back();
+      slot.dense_position = Socket_Vars::NOT_LISTED;
+      slot.generation.fetch_add(1, std::memory_order_relaxed);
+      _live_count.fetch_sub(1, std::memory_order_relaxed);
+   }
+
+   //
+   // 2. No reconnect is started from here on, the socket is closed later
+   Socket_Vars::Socket_Slot& slot = Get_Slot(handle.index);
+   slot.socket.load(std::memory_order_acquire)->Cancel_Reconnect();
+
+   //
+   // 3. Each event loop lets go in turn, the receiving thread then the
+   //    sending thread, starting with the first loop
+   Pass_On(&slot.retired, 0);
+
+   return result;
+}  // END Destroy()
+
+//+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+
+/// Gets a socket by handle
+//+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+
+Universal_Socket* Socket_Registry::Get(Socket_Vars::Socket_Handle handle)
+{
+   Socket_Vars::Socket_Slot* slots;
+
+   if (Socket_Vars::NO_SOCKET == handle.index)
+   {
+      return nullptr;
+   }
+   slots = _slabs[handle.index / Socket_Vars::SOCKETS_PER_SLAB].load(std::memory_order_acquire);
+   if (nullptr == slots)
+   {
+      return nullptr;
+   }
+
+   Socket_Vars::Socket_Slot& slot = slots[handle.index % Socket_Vars::SOCKETS_PER_SLAB];
+   if (handle.generation != slot.generation.load(std::memory_order_acquire))
+   {
+      return nullptr;
+   }
+   return slot.socket.load(std::memory_order_acquire);
+}  // END Get()
+
+//+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+
+/// Takes a free slot for a socket being constructed
+//+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+
+uint32_t Socket_Registry::Add_Slot(HANDLE event)
+{
+   uint32_t socket_index;
+   std::lock_guard<std::mutex> lock(_mutex);
+
+   //
+   // 1. Take a free slot, adding a slab when none are left
+   if (_free.empty() && !Add_Slab())
+   {
+      return Socket_Vars::NO_SOCKET;
+   }
+   socket_index = _free.back();
+   _free.pop_back();
+
+   //
+   // 2. Reset what the last socket left behind, the links it claimed while
+   //    leaving are released here, the send queue was drained by Recycle()
+   Socket_Vars::Socket_Slot& slot = Get_Slot(socket_index);
+   if (!slot.is_used)
+   {
+      slot.send_queue.Initialize(Socket_Vars::SEND_QUEUE_CAPACITY);
+      slot.is_used = true;
+   }
+   slot.event = event;
+   slot.is_started = false;
+   slot.queued_bytes.store(0, std::memory_order_relaxed);
+   slot.is_throttled.store(false, std::memory_order_relaxed);
+   slot.low_watermark = Socket_Vars::SEND_LOW_WATERMARK;
+   slot.high_watermark = Socket_Vars::SEND_HIGH_WATERMARK;
+   slot.send_buffer_limit = Socket_Vars::SEND_BUFFER_LIMIT;
+   slot.watermark_handler = nullptr;
+   slot.stats.Reset();
+   for (uint16_t loop = 0; loop < Socket_Vars::event_loop_count; loop++)
+   {
+      slot.scheduled[loop].is_listed.store(false, std::memory_order_relaxed);
+      slot.loop_position[loop] = Socket_Vars::NOT_LISTED;
+   }
+
+   return socket_index;
+}  // END Add_Slot()
+
+//+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+
+/// Copies the handle of every live socket
+//+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+
+void Socket_Registry::Get_Handles(std::vector<Socket_Vars::Socket_Handle>& handles)
+{
+   Socket_Vars::Socket_Handle handle;
+   std::lock_guard<std::mutex> lock(_mutex);
+
+   handles.clear();
+   for (uint32_t socket_index : _dense)
+   {
+      handle.index = socket_index;
+      handle.generation = Get_Slot(socket_index).generation.load(std::memory_order_relaxed);
+      handles.push_back(handle);
+   }
+}  // END Get_Handles()
+
+//+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+
+/// Copies one socket's counters, queue depth and histograms
+//+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+
+bool Socket_Registry::Get_Snapshot(Socket_Vars::Socket_Handle handle, Stats::Socket_Snapshot& snapshot)
+{
+   bool result = true;
+
+   //
+   // 1. Only the name needs the lock, a live handle keeps the slot's socket
+   {
+      std::lock_guard<std::mutex> lock(_mutex);
+      if (nullptr == Get(handle))
+      {
+         result &= false;
+         return result;
+      }
+      snapshot.socket_index = handle.index;
+      snapshot.socket_name = Get_Slot(handle.index).name;
+   }
+
+   //
+   // 2. The counters are read without it, each is exact but they are not
+   //    all from the same instant
+   Copy_Stats(Get_Slot(handle.index), snapshot);
+
+   return result;
+}  // END Get_Snapshot()
+
+//+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+
+/// Copies every live socket's snapshot
+//+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+
+void Socket_Registry::Get_Snapshots(std::vector<Stats::Socket_Snapshot>& snapshots)
+{
+   //
+   // 1. List the live sockets under the lock, copying nothing else
+   {
+      std::lock_guard<std::mutex> lock(_mutex);
+      snapshots.resize(_dense.size());
+      for (size_t i = 0; i < _dense.size(); i++)
+      {
+         snapshots[i].socket_index = _dense[i];
+         snapshots[i].socket_name = Get_Slot(_dense[i]).name;
+      }
+   }
+
+   //
+   // 2. Copy each socket's stats outside the lock so Create() and Destroy()
+   //    never wait on a reader, a socket destroyed meanwhile reads as it
+   //    was or as zeroes
+   for (Stats::Socket_Snapshot& snapshot : snapshots)
+   {
+      Copy_Stats(Get_Slot(snapshot.socket_index), snapshot);
+   }
+}  // END Get_Snapshots()
+
+//+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+
+/// Copies a slot's stats into a snapshot
+//+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+
+void Socket_Registry::Copy_Stats(Socket_Vars::Socket_Slot& slot, Stats::Socket_Snapshot& snapshot)
+{
+   for (uint32_t counter = 0; counter < Stats::COUNTER_COUNT; counter++)
+   {
+      snapshot.counters[counter] = slot.stats.counters[counter].load(std::memory_order_relaxed);
+   }
+   snapshot.queued_bytes = slot.queued_bytes.load(std::memory_order_relaxed);
+   snapshot.peak_queued_bytes = slot.stats.peak_queued_bytes.load(std::memory_order_relaxed);
+   snapshot.is_throttled = slot.is_throttled.load(std::memory_order_relaxed);
+   slot.stats.queue_dwell.Copy_To(snapshot.queue_dwell);
+   slot.stats.handle_event.Copy_To(snapshot.handle_event);
+}  // END Copy_Stats()
+
+//+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+
+/// Applies the sockets joining and leaving an event loop
+//+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+
+void Socket_Registry::Adopt(uint16_t loop)
+{
+   Socket_Vars::Socket_Link* link;
+   std::vector<Universal_Socket*>& sockets = _loops[loop].sockets;
+
+   while (nullptr != (link = _loops[loop].changes.Pop()))
+   {
+      Socket_Vars::Socket_Slot& slot = Get_Slot(link->socket_index);
+
+      //
+      // 1. A started socket goes on the end of the list
+      if (Socket_Vars::LOOP_JOIN == link->kind)
+      {
+         slot.loop_position[loop] = static_cast<uint32_t>(sockets.size());
+         sockets.push_back(slot.socket.load(std::memory_order_acquire));
+         continue;
+      }
+
+      //
+      // 2. A destroyed socket cancels its timers on this loop's wheel and
+      //    swaps the last socket of the list into its position, a socket
+      //    never started on this loop is not listed
+      uint32_t position = slot.loop_position[loop];
+      if (Socket_Vars::NOT_LISTED != position)
+      {
+         sockets[position]->Cancel_Timers(loop);
+         Universal_Socket* moved = sockets.back();
+         sockets[position] = moved;
+         Get_Slot(moved->Get_Queue_Index()).loop_position[loop] = position;
+         sockets.pop_back();
+         slot.loop_position[loop] = Socket_Vars::NOT_LISTED;
+      }
+
+      //
+      // 3. The receiving thread is done with it, the sending thread next
+      _loops[loop].retired.Push(link);
+      SetEvent(Socket_Vars::send_wake_events[loop]);
+   }
+}  // END Adopt()
+
+//+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+
+/// Passes sockets that left an event loop on to the next loop
+//+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+
+void Socket_Registry::Release_Retired(uint16_t loop)
+{
+   Socket_Vars::Socket_Link* link;
+   std::vector<Socket_Vars::Socket_Link*> waiting;
+
+   while (nullptr != (link = _loops[loop].retired.Pop()))
+   {
+      //
+      // 1. Claiming the scheduled flag keeps the socket off this loop's
+      //    scheduled list for good, a listing already there is taken on a
+      //    later pass and the socket waits for it
+      if (Get_Slot(link->socket_index).scheduled[loop].is_listed.exchange(true, std::memory_order_acq_rel))
+      {
+         waiting.push_back(link);
+         continue;
+      }
+
+      //
+      // 2. Nothing on this loop can reach it now
+      Pass_On(link, static_cast<uint16_t>(loop + 1));
+   }
+
+   for (Socket_Vars::Socket_Link* waiting_link : waiting)
+   {
+      _loops[loop].retired.Push(waiting_link);
+   }
+}  // END Release_Retired()
+
+//+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+
+/// Frees the slot of a closed and deleted socket
+//+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+
+void Socket_Registry::Recycle(uint32_t socket_index)
+{
+   Socket_Vars::Socket_Slot& slot = Get_Slot(socket_index);
+   Socket_Vars::Queued_Send queued;
+
+   //
+   // 1. Drop anything still queued for the closed socket
+   while (slot.send_queue.Pop(queued))
+   {
+   }
+   queued.message.Reset();
+
+   //
+   // 2. Hand the slot back, the next Add_Slot() may reuse it
+   std::lock_guard<std::mutex> lock(_mutex);
+   slot.socket.store(nullptr, std::memory_order_relaxed);
+   slot.event = WSA_INVALID_EVENT;
+   _free.push_back(socket_index);
+}  // END Recycle()
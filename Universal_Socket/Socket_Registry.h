@@ -0,0 +1,378 @@
+//+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+
+// 
+//  ___________ __  .__                       ___________
+//  \_   _____//  |_|  |__ _____    ____      \_   _____/
+//   |    __)_\   __\  |  \\__  \  /    \      |    __)_ 
+//   |        \|  | |   Y  \/ __ \|   |  \     |        \
+//  /_______  /|__| |___|  (____  /___|  / /\ /_______  /
+//          \/           \/     \/     \/  \/         \/ 
+// 
+// Socket Registry Header File
+//
+//  Author   Date         Description
+// --------------------------------------------------------
+//  ECE      10-17-2026   Initial Implementation
+//  ECE      10-17-2026   Slots count queued send bytes against watermarks
+//  ECE      10-17-2026   Slots keep each socket's counters and histograms
+//  ECE      10-17-2026   Queued messages are held in pooled buffers
+//  ECE      10-17-2026   Slots keep the async sends parked on a full send queue
+//  ECE      10-17-2026   Send queues hold each message's destination
+//+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+
+
+#pragma once
+
+#include "Lock_Free_Queue.h"
+#include "Socket_Stats.h"
+#include "Universal_Socket.h"
+#include "Work_Pool.h"
+
+#include <WinSock2.h>
+#include <atomic>
+#include <cstdint>
+#include <memory>
+#include <mutex>
+#include <string>
+#include <vector>
+
+namespace Registered_IO
+{
+   struct Registered_Socket;
+}
+
+class Socket_Registry;
+
+namespace Socket_Vars
+{
+   // Socket slots are allocated a slab at a time, slabs never move so a
+   // slot's queues and its socket's address stay put for its whole life
+   constexpr uint32_t SOCKETS_PER_SLAB{ 64 };
+   constexpr uint32_t MAX_SOCKET_SLABS{ 65536 };
+
+   // Socket index of a handle that names no socket
+   constexpr uint32_t NO_SOCKET{ 0xFFFFFFFF };
+
+   // Position of a socket on an event loop that does not list it
+   constexpr uint32_t NOT_LISTED{ 0xFFFFFFFF };
+
+   // What a Socket_Link asks of the event loop it is queued on
+   enum Link_Kind : uint8_t
+   {
+      SEND_SCHEDULED  = 0,   // Waiting on the loop's sending thread
+      LOOP_JOIN       = 1,   // Started, the loop lists it from its next pass
+      LOOP_LEAVE      = 2    // Destroyed, passed loop to loop until none can reach it
+   };
+
+   //+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+
+   /// @brief   Link a socket queues itself on an event loop with,
+   /// @brief   embedded in the socket's slot so queuing never fails
+   //+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+
+   struct Socket_Link : public Lock_Free::Queue_Link
+   {
+      uint32_t socket_index = NO_SOCKET;
+      Link_Kind kind = SEND_SCHEDULED;
+      std::atomic<bool> is_listed{ false };   // Already on the loop's scheduled list
+   };
+
+   //+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+
+   /// @brief   Names one socket for as long as it lives, the
+   /// @brief   generation no longer matches once it is destroyed
+   /// @brief   so a stale handle never reaches the slot's next socket
+   //+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+
+   struct Socket_Handle
+   {
+      uint32_t index = NO_SOCKET;
+      uint32_t generation = 0;
+
+      inline bool operator==(const Socket_Handle& other) const
+      {
+         return index == other.index && generation == other.generation;
+      }
+   };
+
+   //+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+
+   /// @brief   Last step of destroying a socket, run on the handler
+   /// @brief   pool once no event loop can reach it, waits for its
+   /// @brief   handlers and Start() to finish then frees the slot
+   //+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+
+   class Retire_Task : public Work_Pool::Task
+   {
+   public:
+
+      void Run() override;
+
+      Socket_Registry* registry = nullptr;
+      uint32_t socket_index = NO_SOCKET;
+
+   };  // END class Retire_Task
+
+   //+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+
+   /// @brief   Everything kept per socket index, reused by the
+   /// @brief   next socket once the slot is freed
+   //+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+
+   struct Socket_Slot
+   {
+      std::atomic<Universal_Socket*> socket{ nullptr };     // nullptr while free or being created
+      std::atomic<uint32_t> generation{ 0 };                // Bumped by every Destroy()
+      std::atomic<bool> is_starting{ false };               // Start() has the socket
+      bool is_started = false;                              // Under the registry mutex
+      bool is_used = false;                                 // Send queue allocated
+      uint32_t dense_position = NOT_LISTED;                 // Position in the registry's dense list
+      std::string name;                                     // Under the registry mutex, for snapshots
+
+      // The socket's event HANDLE and send queue, any thread may send, only
+      // the Socket_Sending_Thread pops the send queue
+      HANDLE event = WSA_INVALID_EVENT;
+      Lock_Free::MPSC_Queue<Queued_Send> send_queue;
+
+      // Bytes waiting on the send queue, producers add before pushing and
+      // the sending thread takes off after popping, so a count may briefly
+      // run ahead of the queue but never behind it
+      std::atomic<size_t> queued_bytes{ 0 };
+      std::atomic<bool> is_throttled{ false };
+      size_t low_watermark = SEND_LOW_WATERMARK;
+      size_t high_watermark = SEND_HIGH_WATERMARK;
+      size_t send_buffer_limit = SEND_BUFFER_LIMIT;
+      Watermark_Handler watermark_handler = nullptr;
+      Send_Waiters send_waiters;                            // Woken at the low watermark
+
+      // Counters and histograms, written from the hot paths with relaxed
+      // adds, zeroed when the slot is taken by a new socket
+      Stats::Socket_Stats stats;
+
+      // Registered I/O state, kept for the next socket at this index
+      std::atomic<Registered_IO::Registered_Socket*> registered{ nullptr };
+
+      // One of each per event loop, loop_position is written by each
+      // loop's receiving thread only
+      std::unique_ptr<Socket_Link[]> scheduled;
+      std::unique_ptr<Socket_Link[]> joined;
+      std::unique_ptr<uint32_t[]> loop_position;
+
+      Socket_Link retired;
+      Retire_Task retire_task;
+   };
+
+   //+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+
+   /// @brief   Sockets one event loop polls and sends for
+   //+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+
+   struct Loop_Sockets
+   {
+      std::vector<Universal_Socket*> sockets;         // Receiving thread of the loop only
+      Lock_Free::Link_Queue<Socket_Link> changes;     // Joining and leaving, not yet adopted
+      Lock_Free::Link_Queue<Socket_Link> retired;     // Left, waiting on the loop's sending thread
+   };
+
+   //+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+
+   /// @brief   Registry every socket is created in, one per
+   /// @brief   program, created on first use
+   /// @return  Socket_Registry&  Registry
+   //+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+
+   Socket_Registry& Sockets();
+
+}  // END namespace Socket_Vars
+
+class Socket_Registry
+{
+public:
+
+   //+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+
+   /// @brief   Constructor
+   //+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+
+   Socket_Registry();
+
+   //+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+
+   /// @brief   Creates a socket, configure it through Get() then
+   /// @brief   Start() it, safe from any thread
+   /// @param   Protocol          TCP or UDP
+   /// @param   Connection_Type   CLIENT or SERVER
+   /// @param   std::string       IP address
+   /// @param   uint16_t          Port
+   /// @param   std::string       Name or short description
+   /// @return  Socket_Handle     Handle, index is NO_SOCKET on failure
+   //+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+
+   Socket_Vars::Socket_Handle Create(
+      Socket_Vars::Protocol protocol_type,
+      Socket_Vars::Connection_Type connection_type,
+      std::string ip_address,
+      uint16_t port,
+      std::string name);
+
+   //+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+
+   /// @brief   Opens a created socket and hands it to the event
+   /// @brief   loop that owns it, a TCP server to every loop since
+   /// @brief   its clients are spread across them, once per socket
+   /// @param   Socket_Handle     Socket to start
+   /// @return  bool              False if stale, started or the open failed
+   //+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+
+   bool Start(Socket_Vars::Socket_Handle handle);
+
+   //+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+
+   /// @brief   Destroys a socket, the handle goes stale at once,
+   /// @brief   each event loop lets go of the socket in turn and
+   /// @brief   the handler pool closes it and frees the slot once
+   /// @brief   its handlers are done, safe from any thread
+   /// @param   Socket_Handle     Socket to destroy
+   /// @return  bool              False if the handle was already stale
+   //+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+
+   bool Destroy(Socket_Vars::Socket_Handle handle);
+
+   //+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+
+   /// @brief   Gets a socket by handle, the pointer is stable until
+   /// @brief   the handle is destroyed
+   /// @param   Socket_Handle     Socket to get
+   /// @return  Universal_Socket* Socket, or nullptr if the handle is stale
+   //+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+
+   Universal_Socket* Get(Socket_Vars::Socket_Handle handle);
+
+   //+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+
+   /// @brief   Gets the socket at an index, for the event loops and
+   /// @brief   the socket itself, which the index cannot outlive
+   /// @param   uint32_t          Index of the socket's queues
+   /// @return  Universal_Socket* Socket, or nullptr while being created
+   //+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+
+   inline Universal_Socket* Get(uint32_t socket_index)
+   {
+      return Get_Slot(socket_index).socket.load(std::memory_order_acquire);
+   }
+
+   //+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+
+   /// @brief   Gets the slot at an index, the slot stays valid
+   /// @brief   for the life of the registry
+   /// @param   uint32_t          Index of the socket's queues
+   /// @return  Socket_Slot&      Slot
+   //+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+
+   inline Socket_Vars::Socket_Slot& Get_Slot(uint32_t socket_index)
+   {
+      return _slabs[socket_index / Socket_Vars::SOCKETS_PER_SLAB].load(std::memory_order_acquire)
+         [socket_index % Socket_Vars::SOCKETS_PER_SLAB];
+   }
+
+   //+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+
+   /// @brief   Takes a free slot for a socket being constructed,
+   /// @brief   adding a slab when none are left
+   /// @param   HANDLE            Socket's event, stored in the slot
+   /// @return  uint32_t          Socket index or NO_SOCKET
+   //+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+
+   uint32_t Add_Slot(HANDLE event);
+
+   //+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+
+   /// @brief   Copies the handle of every live socket, in no
+   /// @brief   particular order
+   /// @param   std::vector       Returning handles
+   /// @return  None
+   //+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+
+   void Get_Handles(std::vector<Socket_Vars::Socket_Handle>& handles);
+
+   //+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+
+   /// @brief   Applies the sockets joining and leaving an event
+   /// @brief   loop to its list, that loop's receiving thread only,
+   /// @brief   before every pass
+   /// @param   uint16_t          Event loop
+   /// @return  None
+   //+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+
+   void Adopt(uint16_t loop);
+
+   //+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+
+   /// @brief   Dense list of the sockets an event loop polls,
+   /// @brief   that loop's receiving thread only
+   /// @param   uint16_t          Event loop
+   /// @return  std::vector&      Sockets of the loop
+   //+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+
+   inline const std::vector<Universal_Socket*>& Get_Loop_Sockets(uint16_t loop) { return _loops[loop].sockets; }
+
+   //+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+
+   /// @brief   Passes every socket that left an event loop on to
+   /// @brief   the next loop once it is off this loop's scheduled
+   /// @brief   list, the rest wait for the next call, that loop's
+   /// @brief   sending thread only
+   /// @param   uint16_t          Event loop
+   /// @return  None
+   //+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+
+   void Release_Retired(uint16_t loop);
+
+   //+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+
+   /// @brief   Frees the slot of a socket the handler pool has
+   /// @brief   closed and deleted, Retire_Task only
+   /// @param   uint32_t          Socket index
+   /// @return  None
+   //+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+
+   void Recycle(uint32_t socket_index);
+
+   //+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+
+   /// @brief   Number of live sockets, safe from any thread
+   /// @return  uint32_t          _live_count
+   //+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+
+   inline uint32_t Get_Count() { return _live_count.load(std::memory_order_relaxed); }
+
+   //+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+
+   /// @brief   Copies one socket's counters, queue depth and
+   /// @brief   histograms, safe from any thread, nothing on the
+   /// @brief   hot paths waits for it
+   /// @param   Socket_Handle     Socket to copy
+   /// @param   Socket_Snapshot   Returning snapshot
+   /// @return  bool              False if the handle is stale
+   //+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+
+   bool Get_Snapshot(Socket_Vars::Socket_Handle handle, Stats::Socket_Snapshot& snapshot);
+
+   //+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+
+   /// @brief   Copies every live socket's snapshot, in no
+   /// @brief   particular order, safe from any thread
+   /// @param   std::vector       Returning snapshots
+   /// @return  None
+   //+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+
+   void Get_Snapshots(std::vector<Stats::Socket_Snapshot>& snapshots);
+
+private:
+
+   // Slabs of socket slots, allocated on demand
+   std::atomic<Socket_Vars::Socket_Slot*> _slabs[Socket_Vars::MAX_SOCKET_SLABS];
+   uint32_t _slab_count;
+
+   // Guards the free and dense lists and the slab count, held only for
+   // O(1) list updates, never while a socket opens or closes
+   std::mutex _mutex;
+
+   // Free slots, reused most recently freed first while still warm
+   std::vector<uint32_t> _free;
+
+   // Index of every live socket, removal swaps the last entry into the hole
+   std::vector<uint32_t> _dense;
+   std::atomic<uint32_t> _live_count;
+
+   // Sockets of each event loop
+   Socket_Vars::Loop_Sockets _loops[Socket_Vars::MAX_EVENT_LOOPS];
+
+   //+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+
+   /// @brief   Copies a slot's stats into a snapshot, the name
+   /// @brief   and index are filled in by the caller
+   /// @param   Socket_Slot       Slot to copy
+   /// @param   Socket_Snapshot   Returning snapshot
+   /// @return  None
+   //+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+
+   void Copy_Stats(Socket_Vars::Socket_Slot& slot, Stats::Socket_Snapshot& snapshot);
+
+   //+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+
+   /// @brief   Allocates the next slab and frees its slots,
+   /// @brief   _mutex must be held
+   /// @return  bool              False if every slab is in use
+   //+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+
+   bool Add_Slab();
+
+   //+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+
+   /// @brief   Checks a handle still names a live socket, _mutex
+   /// @brief   must be held
+   /// @param   Socket_Handle     Handle to check
+   /// @return  bool              True if the generation matches
+   //+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+
+   bool Is_Live(Socket_Vars::Socket_Handle handle);
+
+   //+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+
+   /// @brief   Hands a leaving socket to the next event loop, or
+   /// @brief   to the handler pool after the last loop
+   /// @param   Socket_Link*      Socket's retired link
+   /// @param   uint16_t          Next event loop
+   /// @return  None
+   //+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+
+   void Pass_On(Socket_Vars::Socket_Link* link, uint16_t loop);
+
+};  // END class Socket_Registry
@@ -0,0 +1,193 @@
+//+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+
+// 
+//  ___________ __  .__                       ___________
+//  \_   _____//  |_|  |__ _____    ____      \_   _____/
+//   |    __)_\   __\  |  \\__  \  /    \      |    __)_ 
+//   |        \|  | |   Y  \/ __ \|   |  \     |        \
+//  /_______  /|__| |___|  (____  /___|  / /\ /_______  /
+//          \/           \/     \/     \/  \/         \/ 
+// 
+// Socket Statistics Implementation File
+//
+//  Author   Date         Description
+// --------------------------------------------------------
+//  ECE      10-17-2026   Initial Implementation
+//  ECE      10-17-2026   Snapshots go to the asynchronous log
+//  ECE      10-17-2026   Named the idle timeout counter
+//+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+
+
+#include "Socket_Stats.h"
+#include "Socket_Log.h"
+
+#include <cstdio>
+
+namespace Stats
+{
+   //+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+
+   /// Value at or under which the given share of values fall
+   //+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+
+   uint64_t Histogram_Snapshot::Percentile(double percentile) const
+   {
+      uint64_t rank;
+      uint64_t seen = 0;
+
+      if (0 == count)
+      {
+         return 0;
+      }
+
+      //
+      // 1. Walk up the buckets until the rank of the percentile is reached
+      rank = static_cast<uint64_t>(percentile / 100.0 * static_cast<double>(count) + 0.5);
+      rank = (0 == rank) ? 1 : rank;
+      for (uint32_t bucket = 0; bucket < HISTOGRAM_BUCKETS; bucket++)
+      {
+         seen += buckets[bucket];
+         if (seen >= rank)
+         {
+            return Latency_Histogram::Bucket_Upper_Bound(bucket);
+         }
+      }
+
+      return Latency_Histogram::Bucket_Upper_Bound(HISTOGRAM_BUCKETS - 1);
+   }  // END Percentile()
+
+   //+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+
+   /// Records the time since a start
+   //+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+
+   void Latency_Histogram::Record_Since(std::chrono::steady_clock::time_point start)
+   {
+      std::chrono::steady_clock::duration elapsed;
+
+      if (std::chrono::steady_clock::time_point() == start)
+      {
+         return;
+      }
+
+      elapsed = std::chrono::steady_clock::now() - start;
+      Record(static_cast<uint64_t>(std::chrono::duration_cast<std::chrono::nanoseconds>(elapsed).count()));
+   }  // END Record_Since()
+
+   //+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+
+   /// Copies the buckets
+   //+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+
+   void Latency_Histogram::Copy_To(Histogram_Snapshot& snapshot) const
+   {
+      snapshot.count = 0;
+      for (uint32_t bucket = 0; bucket < HISTOGRAM_BUCKETS; bucket++)
+      {
+         snapshot.buckets[bucket] = _buckets[bucket].load(std::memory_order_relaxed);
+         snapshot.count += snapshot.buckets[bucket];
+      }
+      snapshot.total = _total.load(std::memory_order_relaxed);
+   }  // END Copy_To()
+
+   //+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+
+   /// Empties every bucket
+   //+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+
+   void Latency_Histogram::Reset()
+   {
+      for (uint32_t bucket = 0; bucket < HISTOGRAM_BUCKETS; bucket++)
+      {
+         _buckets[bucket].store(0, std::memory_order_relaxed);
+      }
+      _total.store(0, std::memory_order_relaxed);
+   }  // END Reset()
+
+   //+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+
+   /// Largest value counted in a bucket
+   //+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+
+   uint64_t Latency_Histogram::Bucket_Upper_Bound(uint32_t bucket)
+   {
+      uint32_t shift;
+      uint64_t lowest;
+
+      if (bucket < 2 * SUB_BUCKETS)
+      {
+         return bucket;
+      }
+
+      // Undo Bucket_Index(), the bucket's top bits shifted back into place
+      shift = bucket / SUB_BUCKETS - 1;
+      lowest = static_cast<uint64_t>(bucket % SUB_BUCKETS + SUB_BUCKETS) << shift;
+      return lowest + (uint64_t{ 1 } << shift) - 1;
+   }  // END Bucket_Upper_Bound()
+
+   //+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+
+   /// Zeroes everything
+   //+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+
+   void Socket_Stats::Reset()
+   {
+      for (uint32_t counter = 0; counter < COUNTER_COUNT; counter++)
+      {
+         counters[counter].store(0, std::memory_order_relaxed);
+      }
+      peak_queued_bytes.store(0, std::memory_order_relaxed);
+      queue_dwell.Reset();
+      handle_event.Reset();
+   }  // END Reset()
+
+   //+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+
+   /// Name of a counter
+   //+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+
+   const char* Counter_Name(Counter counter)
+   {
+      static const char* const names[COUNTER_COUNT] =
+      {
+         "bytes_sent",
+         "messages_sent",
+         "send_calls",
+         "partial_writes",
+         "would_blocks",
+         "messages_dropped",
+         "bytes_received",
+         "messages_received",
+         "receive_calls",
+         "reconnects",
+         "accepts",
+         "idle_timeouts"
+      };
+
+      return (COUNTER_COUNT > counter) ? names[counter] : "unknown";
+   }  // END Counter_Name()
+
+   //+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+
+   /// Logs a snapshot, the counters are formatted here since a
+   /// log record only holds so many arguments
+   //+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+
+   void Print_Snapshot(const Socket_Snapshot& snapshot)
+   {
+      const Histogram_Snapshot* histograms[2] = { &snapshot.queue_dwell, &snapshot.handle_event };
+      const char* histogram_names[2] = { "queue_dwell", "handle_event" };
+      std::string counters[2];
+      char counter_text[64];
+
+      //
+      // 1. Send counters on one line, receive counters on the next,
+      //    then the send queue depth
+      for (uint32_t counter = 0; counter < COUNTER_COUNT; counter++)
+      {
+         snprintf(counter_text, sizeof(counter_text), " %s=%llu", Counter_Name(static_cast<Counter>(counter)),
+                  static_cast<unsigned long long>(snapshot.counters[counter]));
+         counters[(BYTES_RECEIVED > counter) ? 0 : 1] += counter_text;
+      }
+      Log::Write<Log::LEVEL_INFO>("%s [%u]%s\n", snapshot.socket_name, snapshot.socket_index, counters[0]);
+      Log::Write<Log::LEVEL_INFO>("  %s\n", counters[1]);
+      Log::Write<Log::LEVEL_INFO>("   queued_bytes=%zu peak_queued_bytes=%zu%s\n", snapshot.queued_bytes, snapshot.peak_queued_bytes,
+                                  snapshot.is_throttled ? " throttled" : "");
+
+      //
+      // 2. Each histogram's count and percentiles, in microseconds
+      for (int i = 0; i < 2; i++)
+      {
+         Log::Write<Log::LEVEL_INFO>("   %s count=%llu mean=%.1fus p50=%.1fus p99=%.1fus p999=%.1fus\n",
+                histogram_names[i],
+                histograms[i]->count,
+                static_cast<double>(histograms[i]->Mean()) / 1000.0,
+                static_cast<double>(histograms[i]->Percentile(50.0)) / 1000.0,
+                static_cast<double>(histograms[i]->Percentile(99.0)) / 1000.0,
+                static_cast<double>(histograms[i]->Percentile(99.9)) / 1000.0);
+      }
+   }  // END Print_Snapshot()
+
+}  // END namespace Stats
@@ -0,0 +1,231 @@
+//+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+
+// 
+//  ___________ __  .__                       ___________
+//  \_   _____//  |_|  |__ _____    ____      \_   _____/
+//   |    __)_\   __\  |  \\__  \  /    \      |    __)_ 
+//   |        \|  | |   Y  \/ __ \|   |  \     |        \
+//  /_______  /|__| |___|  (____  /___|  / /\ /_______  /
+//          \/           \/     \/     \/  \/         \/ 
+// 
+// Socket Statistics Header File
+//
+//  Author   Date         Description
+// --------------------------------------------------------
+//  ECE      10-17-2026   Initial Implementation
+//  ECE      10-17-2026   Snapshots go to the asynchronous log
+//  ECE      10-17-2026   Counts links closed by the idle timeout
+//+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+
+
+#pragma once
+
+#include "Lock_Free_Queue.h"
+
+#include <atomic>
+#include <bit>
+#include <chrono>
+#include <cstddef>
+#include <cstdint>
+#include <string>
+
+namespace Stats
+{
+   // Each power of two of a histogram is split into 2^SUB_BUCKET_BITS
+   // linear buckets, so a recorded value is off by at most 1/16th
+   constexpr uint32_t SUB_BUCKET_BITS{ 4 };
+   constexpr uint32_t SUB_BUCKETS{ 1u << SUB_BUCKET_BITS };
+
+   // Largest power of two a histogram tells apart, in nanoseconds, about
+   // 18 minutes, anything longer lands in the last bucket
+   constexpr uint32_t MAX_VALUE_BITS{ 40 };
+
+   // Buckets in every histogram
+   constexpr uint32_t HISTOGRAM_BUCKETS{ (MAX_VALUE_BITS - SUB_BUCKET_BITS + 1) * SUB_BUCKETS };
+
+   // What each socket counts, sends are counted by its sending threads,
+   // receives by its receiving threads
+   enum Counter
+   {
+      BYTES_SENT = 0,         // Bytes the socket took, prefixes included
+      MESSAGES_SENT = 1,      // Messages handed to the socket
+      SEND_CALLS = 2,         // Send system calls
+      PARTIAL_WRITES = 3,     // Sends the socket took only part of
+      WOULD_BLOCKS = 4,       // Sends refused by a full socket buffer
+      MESSAGES_DROPPED = 5,   // Queued or received messages with no room left
+      BYTES_RECEIVED = 6,
+      MESSAGES_RECEIVED = 7,
+      RECEIVE_CALLS = 8,      // Receive system calls and completions
+      RECONNECTS = 9,
+      ACCEPTS = 10,
+      IDLE_TIMEOUTS = 11,     // Links closed after receiving nothing for the timeout
+      COUNTER_COUNT = 12
+   };
+
+   //+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+
+   /// @brief   Copy of a histogram taken by a snapshot
+   //+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+
+   struct Histogram_Snapshot
+   {
+      uint64_t buckets[HISTOGRAM_BUCKETS];
+      uint64_t count;
+      uint64_t total;                     // Sum of every value, in nanoseconds
+
+      //+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+
+      /// @brief   Value at or under which the given share of the
+      /// @brief   recorded values fall
+      /// @param   double            Percentile, 0 to 100
+      /// @return  uint64_t          Upper bound of its bucket, in nanoseconds
+      //+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+
+      uint64_t Percentile(double percentile) const;
+
+      inline uint64_t Mean() const { return (0 == count) ? 0 : total / count; }
+   };
+
+   //+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+
+   /// @brief   Log-linear histogram of nanosecond durations, any
+   /// @brief   thread may record, recording is one relaxed add
+   //+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+
+   class Latency_Histogram
+   {
+   public:
+
+      //+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+
+      /// @brief   Records one duration
+      /// @param   uint64_t          Duration, in nanoseconds
+      /// @return  None
+      //+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+
+      inline void Record(uint64_t nanoseconds)
+      {
+         _buckets[Bucket_Index(nanoseconds)].fetch_add(1, std::memory_order_relaxed);
+         _total.fetch_add(nanoseconds, std::memory_order_relaxed);
+      }
+
+      //+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+
+      /// @brief   Records the time since a start, nothing if the
+      /// @brief   start was never set
+      /// @param   time_point        When the duration began
+      /// @return  None
+      //+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+
+      void Record_Since(std::chrono::steady_clock::time_point start);
+
+      //+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+
+      /// @brief   Copies the buckets, values recorded meanwhile may
+      /// @brief   or may not be in the copy
+      /// @param   Histogram_Snapshot Copy filled in
+      /// @return  None
+      //+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+
+      void Copy_To(Histogram_Snapshot& snapshot) const;
+
+      //+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+
+      /// @brief   Empties every bucket
+      /// @return  None
+      //+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+
+      void Reset();
+
+      //+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+
+      /// @brief   Bucket a value is counted in, values under
+      /// @brief   2 * SUB_BUCKETS have a bucket each
+      /// @param   uint64_t          Value
+      /// @return  uint32_t          Bucket index
+      //+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+
+      static inline uint32_t Bucket_Index(uint64_t value)
+      {
+         uint32_t shift;
+
+         if (value < 2 * SUB_BUCKETS)
+         {
+            return static_cast<uint32_t>(value);
+         }
+
+         // The top SUB_BUCKET_BITS + 1 bits of the value pick the bucket
+         shift = static_cast<uint32_t>(std::bit_width(value)) - SUB_BUCKET_BITS - 1;
+         if (MAX_VALUE_BITS - SUB_BUCKET_BITS <= shift)
+         {
+            return HISTOGRAM_BUCKETS - 1;
+         }
+         return (shift + 1) * SUB_BUCKETS + static_cast<uint32_t>(value >> shift) - SUB_BUCKETS;
+      }
+
+      //+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+
+      /// @brief   Largest value counted in a bucket
+      /// @param   uint32_t          Bucket index
+      /// @return  uint64_t          Value
+      //+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+
+      static uint64_t Bucket_Upper_Bound(uint32_t bucket);
+
+   private:
+
+      std::atomic<uint64_t> _buckets[HISTOGRAM_BUCKETS] = {};
+      std::atomic<uint64_t> _total{ 0 };
+   };
+
+   //+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+
+   /// @brief   Counters and histograms of one socket, kept in
+   /// @brief   its registry slot, written with relaxed adds and
+   /// @brief   only ever read by a snapshot
+   //+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+
+   struct Socket_Stats
+   {
+      alignas(Lock_Free::CACHE_LINE_SIZE) std::atomic<uint64_t> counters[COUNTER_COUNT] = {};
+      std::atomic<size_t> peak_queued_bytes{ 0 };     // Most bytes ever on the send queue
+
+      Latency_Histogram queue_dwell;      // Received message waiting for its handler
+      Latency_Histogram handle_event;     // Handle_Event() of a ready socket
+
+      inline void Add(Counter counter, uint64_t amount = 1)
+      {
+         counters[counter].fetch_add(amount, std::memory_order_relaxed);
+      }
+
+      //+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+
+      /// @brief   Raises the peak queued bytes, a load and nothing
+      /// @brief   more unless it is a new peak
+      /// @param   size_t            Bytes now queued
+      /// @return  None
+      //+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+
+      inline void Raise_Peak(size_t queued_bytes)
+      {
+         size_t peak = peak_queued_bytes.load(std::memory_order_relaxed);
+         while (peak < queued_bytes
+                && !peak_queued_bytes.compare_exchange_weak(peak, queued_bytes, std::memory_order_relaxed))
+         {
+         }
+      }
+
+      //+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+
+      /// @brief   Zeroes everything, for a slot taken by a new socket
+      /// @return  None
+      //+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+
+      void Reset();
+   };
+
+   //+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+
+   /// @brief   Everything known about one socket at one moment
+   //+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+
+   struct Socket_Snapshot
+   {
+      uint32_t socket_index;
+      std::string socket_name;
+      uint64_t counters[COUNTER_COUNT];
+      size_t queued_bytes;                // Send queue depth, in bytes
+      size_t peak_queued_bytes;
+      bool is_throttled;                  // Past its high watermark
+      Histogram_Snapshot queue_dwell;
+      Histogram_Snapshot handle_event;
+   };
+
+   //+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+
+   /// @brief   Name of a counter, for printing a snapshot
+   /// @param   Counter           Counter
+   /// @return  char*             Name
+   //+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+
+   const char* Counter_Name(Counter counter);
+
+   //+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+
+   /// @brief   Logs a snapshot at LEVEL_INFO, two lines of
+   /// @brief   counters, the queue depth and one line per histogram
+   /// @param   Socket_Snapshot   Snapshot to print
+   /// @return  None
+   //+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+
+   void Print_Snapshot(const Socket_Snapshot& snapshot);
+
+}  // END namespace Stats
@@ -0,0 +1,325 @@
+//+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+
+// 
+//  ___________ __  .__                       ___________
+//  \_   _____//  |_|  |__ _____    ____      \_   _____/
+//   |    __)_\   __\  |  \\__  \  /    \      |    __)_ 
+//   |        \|  | |   Y  \/ __ \|   |  \     |        \
+//  /_______  /|__| |___|  (____  /___|  / /\ /_______  /
+//          \/           \/     \/     \/  \/         \/ 
+// 
+// Timer Wheel Source File
+//
+//  Author   Date         Description
+// --------------------------------------------------------
+//  ECE      10-17-2026   Initial Implementation
+//+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+
+
+#include "Timer_Wheel.h"
+
+#include <algorithm>
+#include <bit>
+#include <climits>
+
+namespace Timers
+{
+   //+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+
+   /// Constructor
+   //+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+
+   Timer_Wheel::Timer_Wheel()
+      : _start(std::chrono::steady_clock::now()), _current(1), _count(0), _free(NO_TIMER)
+   {
+      std::fill(std::begin(_slots), std::end(_slots), NO_TIMER);
+      for (uint32_t level = 0; level < WHEEL_LEVELS; level++)
+      {
+         std::fill(std::begin(_occupied[level]), std::end(_occupied[level]), 0);
+      }
+   }  // END Constructor
+
+   //+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+
+   /// Schedules a callback after a delay
+   //+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+
+   Timer_Id Timer_Wheel::Schedule(uint64_t delay, Timer_Callback callback, void* context, uint64_t data)
+   {
+      uint32_t node;
+
+      //
+      // 1. Reuse a freed node, the wheel only grows to the most timers
+      //    ever scheduled at once
+      if (NO_TIMER != _free)
+      {
+         node = _free;
+         _free = _nodes[node].next;
+      }
+      else
+      {
+         node = static_cast<uint32_t>(_nodes.size());
+         _nodes.push_back(Timer_Node());
+         _nodes[node].generation = 1;
+      }
+
+      //
+      // 2. Nothing fires on the tick it was scheduled on
+      Timer_Node& timer = _nodes[node];
+      timer.expires = Get_Tick() + std::clamp<uint64_t>(delay, 1, MAX_DELAY);
+      timer.callback = callback;
+      timer.context = context;
+      timer.data = data;
+      Insert(node);
+      _count++;
+
+      return (static_cast<uint64_t>(timer.generation) << 32) | node;
+   }  // END Schedule()
+
+   //+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+
+   /// Cancels a timer that has not fired
+   //+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+
+   bool Timer_Wheel::Cancel(Timer_Id id)
+   {
+      uint32_t node = static_cast<uint32_t>(id);
+
+      if (_nodes.size() <= node || _nodes[node].generation != static_cast<uint32_t>(id >> 32) || NO_TIMER == _nodes[node].slot)
+      {
+         return false;
+      }
+      Unlink(node);
+      Free(node);
+      return true;
+   }  // END Cancel()
+
+   //+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+
+   /// Fires every timer due by now
+   //+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+
+   size_t Timer_Wheel::Advance(std::chrono::steady_clock::time_point now)
+   {
+      size_t fired = 0;
+      uint64_t now_tick = static_cast<uint64_t>(std::chrono::duration_cast<std::chrono::milliseconds>(now - _start).count());
+      uint64_t tick;
+      uint32_t slot;
+      uint32_t node;
+      uint32_t next;
+
+      while ((tick = Next_Tick()) <= now_tick)
+      {
+         //
+         // 1. Every level whose slot comes round on this tick drops its
+         //    timers a level or more, the coarsest first so what it drops
+         //    into a finer slot turning over now is cascaded again below
+         _current = tick;
+         for (uint32_t level = WHEEL_LEVELS - 1; 0 < level; level--)
+         {
+            if (0 != (tick & ((uint64_t{ 1 } << (WHEEL_BITS * level)) - 1)))
+            {
+               continue;
+            }
+            slot = level * WHEEL_SLOTS + static_cast<uint32_t>((tick >> (WHEEL_BITS * level)) & (WHEEL_SLOTS - 1));
+            node = _slots[slot];
+            _slots[slot] = NO_TIMER;
+            _occupied[level][(slot % WHEEL_SLOTS) / 64] &= ~(uint64_t{ 1 } << (slot % 64));
+            while (NO_TIMER != node)
+            {
+               next = _nodes[node].next;
+               Insert(node);
+               node = next;
+            }
+         }
+
+         //
+         // 2. Fire the tick's slot, moved aside first so what its callbacks
+         //    schedule waits for a later tick
+         slot = static_cast<uint32_t>(tick & (WHEEL_SLOTS - 1));
+         _current = tick + 1;
+         _slots[FIRING_SLOT] = _slots[slot];
+         _slots[slot] = NO_TIMER;
+         _occupied[0][slot / 64] &= ~(uint64_t{ 1 } << (slot % 64));
+         for (node = _slots[FIRING_SLOT]; NO_TIMER != node; node = _nodes[node].next)
+         {
+            _nodes[node].slot = FIRING_SLOT;
+         }
+         while (NO_TIMER != (node = _slots[FIRING_SLOT]))
+         {
+            Timer_Callback callback = _nodes[node].callback;
+            void* context = _nodes[node].context;
+            uint64_t data = _nodes[node].data;
+
+            Unlink(node);
+            Free(node);
+            callback(context, data);
+            fired++;
+         }
+      }
+
+      //
+      // 3. Nothing is due before the next tick, the ticks between are skipped
+      _current = (std::max)(_current, now_tick + 1);
+
+      return fired;
+   }  // END Advance()
+
+   //+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+
+   /// Gets how long a poll may wait
+   //+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+
+   int Timer_Wheel::Get_Timeout(std::chrono::steady_clock::time_point now)
+   {
+      uint64_t next = Next_Tick();
+      uint64_t now_tick = static_cast<uint64_t>(std::chrono::duration_cast<std::chrono::milliseconds>(now - _start).count());
+
+      if (UINT64_MAX == next)
+      {
+         return -1;
+      }
+      if (next <= now_tick)
+      {
+         return 0;
+      }
+      return static_cast<int>((std::min)(next - now_tick, static_cast<uint64_t>(INT_MAX)));
+   }  // END Get_Timeout()
+
+   //+-+-+-+-+-+-+-+-+-+-+PRIVATE FUNCTIONS+-+-+-+-+-+-+-+-+-+-+-+-+-+
+
+   //+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+
+   /// Links a node into the slot its expiry falls in
+   //+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+
+   void Timer_Wheel::Insert(uint32_t node)
+   {
+      Timer_Node& timer = _nodes[node];
+      uint64_t delta = (timer.expires > _current) ? timer.expires - _current : 0;
+      uint32_t level = 0;
+      uint32_t slot;
+
+      //
+      // 1. The finest level whose revolution still reaches the expiry, the
+      //    slot is the expiry's digit at that level
+      while (level + 1 < WHEEL_LEVELS && (uint64_t{ 1 } << (WHEEL_BITS * (level + 1))) <= delta)
+      {
+         level++;
+      }
+      slot = static_cast<uint32_t>((timer.expires >> (WHEEL_BITS * level)) & (WHEEL_SLOTS - 1));
+
+      //
+      // 2. Push it on the slot's list
+      timer.slot = level * WHEEL_SLOTS + slot;
+      timer.previous = NO_TIMER;
+      timer.next = _slots[timer.slot];
+      if (NO_TIMER != timer.next)
+      {
+         _nodes[timer.next].previous = node;
+      }
+      _slots[timer.slot] = node;
+      _occupied[level][slot / 64] |= uint64_t{ 1 } << (slot % 64);
+   }  // END Insert()
+
+   //+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+
+   /// Unlinks a node from its slot
+   //+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+
+   void Timer_Wheel::Unlink(uint32_t node)
+   {
+      Timer_Node& timer = _nodes[node];
+
+      if (NO_TIMER != timer.previous)
+      {
+         _nodes[timer.previous].next = timer.next;
+      }
+      else
+      {
+         _slots[timer.slot] = timer.next;
+      }
+      if (NO_TIMER != timer.next)
+      {
+         _nodes[timer.next].previous = timer.previous;
+      }
+
+      // The last timer of a slot clears its bit, the firing list has none
+      if (NO_TIMER == _slots[timer.slot] && FIRING_SLOT != timer.slot)
+      {
+         _occupied[timer.slot / WHEEL_SLOTS][(timer.slot % WHEEL_SLOTS) / 64] &= ~(uint64_t{ 1 } << (timer.slot % 64));
+      }
+   }  // END Unlink()
+
+   //+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+
+   /// Puts a node back on the free list
+   //+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+
+   void Timer_Wheel::Free(uint32_t node)
+   {
+      Timer_Node& timer = _nodes[node];
+
+      timer.slot = NO_TIMER;
+      timer.generation = (0xFFFFFFFF == timer.generation) ? 1 : timer.generation + 1;
+      timer.next = _free;
+      _free = node;
+      _count--;
+   }  // END Free()
+
+   //+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+
+   /// Gets the first tick a slot holding timers is due
+   //+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+
+   uint64_t Timer_Wheel::Next_Tick() const
+   {
+      uint64_t best = UINT64_MAX;
+      uint64_t tick;
+      uint64_t revolution;
+      uint32_t shift;
+      uint32_t index;
+      uint32_t slot;
+
+      if (0 == _count)
+      {
+         return best;
+      }
+
+      for (uint32_t level = 0; level < WHEEL_LEVELS; level++)
+      {
+         //
+         // 1. A slot comes round at the start of its span in this level's
+         //    revolution, one already passed holds timers for the next
+         shift = WHEEL_BITS * level;
+         index = static_cast<uint32_t>((_current >> shift) & (WHEEL_SLOTS - 1));
+         revolution = (_current >> (shift + WHEEL_BITS)) << (shift + WHEEL_BITS);
+         slot = Next_Occupied(level, index);
+         if (WHEEL_SLOTS > slot && revolution + (static_cast<uint64_t>(slot) << shift) < _current)
+         {
+            slot = Next_Occupied(level, index + 1);
+         }
+         if (WHEEL_SLOTS > slot)
+         {
+            tick = revolution + (static_cast<uint64_t>(slot) << shift);
+         }
+         //
+         // 2. Otherwise the first occupied slot of the next revolution
+         else if (WHEEL_SLOTS > (slot = Next_Occupied(level, 0)))
+         {
+            tick = revolution + (uint64_t{ 1 } << (shift + WHEEL_BITS)) + (static_cast<uint64_t>(slot) << shift);
+         }
+         else
+         {
+            continue;
+         }
+         best = (std::min)(best, tick);
+      }
+
+      return best;
+   }  // END Next_Tick()
+
+   //+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+
+   /// Gets the first occupied slot of a level from a slot on
+   //+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+
+   uint32_t Timer_Wheel::Next_Occupied(uint32_t level, uint32_t slot) const
+   {
+      uint64_t bits;
+
+      for (uint32_t word = slot / 64; word < BITMAP_WORDS; word++)
+      {
+         bits = _occupied[level][word];
+         if (word == slot / 64)
+         {
+            bits &= ~uint64_t{ 0 } << (slot % 64);
+         }
+         if (0 != bits)
+         {
+            return word * 64 + static_cast<uint32_t>(std::countr_zero(bits));
+         }
+      }
+
+      return WHEEL_SLOTS;
+   }  // END Next_Occupied()
+
+}  // END namespace Timers
@@ -0,0 +1,173 @@
+//+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+
+// 
+//  ___________ __  .__                       ___________
+//  \_   _____//  |_|  |__ _____    ____      \_   _____/
+//   |    __)_\   __\  |  \\__  \  /    \      |    __)_ 
+//   |        \|  | |   Y  \/ __ \|   |  \     |        \
+//  /_______  /|__| |___|  (____  /___|  / /\ /_______  /
+//          \/           \/     \/     \/  \/         \/ 
+// 
+// Timer Wheel Header File
+//
+//  Author   Date         Description
+// --------------------------------------------------------
+//  ECE      10-17-2026   Initial Implementation
+//+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+
+
+#pragma once
+
+#include <chrono>
+#include <cstdint>
+#include <vector>
+
+namespace Timers
+{
+   // Slots of every level of the wheel, a power of two
+   constexpr uint32_t WHEEL_BITS{ 8 };
+   constexpr uint32_t WHEEL_SLOTS{ 1 << WHEEL_BITS };
+
+   // Levels of the wheel, each tick is a millisecond so the last level
+   // reaches 2^32 ms, longer delays are cut to that
+   constexpr uint32_t WHEEL_LEVELS{ 4 };
+
+   // Longest delay a timer may be scheduled with, in milliseconds
+   constexpr uint64_t MAX_DELAY{ (uint64_t{ 1 } << (WHEEL_BITS * WHEEL_LEVELS)) - 1 };
+
+   // Names a scheduled timer, 0 names none, a timer that fired or was
+   // cancelled no longer matches so a stale id is harmless
+   typedef uint64_t Timer_Id;
+
+   // Called on the wheel's thread when a timer is due, it may schedule
+   // and cancel timers, its own id is already stale
+   typedef void (*Timer_Callback)(void* context, uint64_t data);
+
+   //+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+
+   /// @brief   Hierarchical timer wheel of millisecond ticks, one
+   /// @brief   per event loop and touched by that loop's receiving
+   /// @brief   thread only. Scheduling and cancelling are O(1) list
+   /// @brief   splices with no system call, a timer far off waits
+   /// @brief   on a coarser level and drops a level each time its
+   /// @brief   slot comes round
+   //+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+
+   class Timer_Wheel
+   {
+   public:
+
+      //+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+
+      /// @brief   Constructor, tick 0 is now
+      //+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+
+      Timer_Wheel();
+
+      Timer_Wheel(const Timer_Wheel&) = delete;
+      Timer_Wheel& operator=(const Timer_Wheel&) = delete;
+
+      //+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+
+      /// @brief   Schedules a callback delay milliseconds from the
+      /// @brief   last Advance(), at least one tick away
+      /// @param   uint64_t          Delay, in milliseconds
+      /// @param   Timer_Callback    Called once the delay has passed
+      /// @param   void*             Passed to the callback
+      /// @param   uint64_t          Passed to the callback
+      /// @return  Timer_Id          Id to cancel it with
+      //+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+
+      Timer_Id Schedule(uint64_t delay, Timer_Callback callback, void* context, uint64_t data);
+
+      //+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+
+      /// @brief   Cancels a timer that has not fired
+      /// @param   Timer_Id          Id Schedule() returned
+      /// @return  bool              False if it already fired or was cancelled
+      //+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+
+      bool Cancel(Timer_Id id);
+
+      //+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+
+      /// @brief   Fires every timer due by now, slots with nothing
+      /// @brief   to fire or cascade are skipped, not walked
+      /// @param   time_point        Time now
+      /// @return  size_t            Number of timers fired
+      //+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+
+      size_t Advance(std::chrono::steady_clock::time_point now);
+
+      //+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+
+      /// @brief   Gets how long a poll may wait before Advance()
+      /// @brief   has something to do
+      /// @param   time_point        Time now
+      /// @return  int               Milliseconds, -1 if nothing is scheduled
+      //+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+
+      int Get_Timeout(std::chrono::steady_clock::time_point now);
+
+      // Tick of the last Advance(), a cheap clock for the wheel's thread
+      inline uint64_t Get_Tick() const { return _current - 1; }
+
+      // Timers scheduled and not yet fired or cancelled
+      inline size_t Get_Count() const { return _count; }
+
+   private:
+
+      static constexpr uint32_t NO_TIMER{ 0xFFFFFFFF };
+      static constexpr uint32_t BITMAP_WORDS{ WHEEL_SLOTS / 64 };
+
+      // Extra list the slot being fired is moved to, so a callback may
+      // schedule into that slot or cancel a timer still waiting to fire
+      static constexpr uint32_t FIRING_SLOT{ WHEEL_LEVELS * WHEEL_SLOTS };
+
+      struct Timer_Node
+      {
+         uint64_t expires;          // Tick it fires on
+         Timer_Callback callback;
+         void* context;
+         uint64_t data;
+         uint32_t next;             // Next in its slot, or on the free list
+         uint32_t previous;
+         uint32_t slot;             // Level * WHEEL_SLOTS + slot, NO_TIMER if free
+         uint32_t generation;       // Bumped whenever the node is freed
+      };
+
+      //+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+
+      /// @brief   Links a node into the slot its expiry falls in
+      /// @brief   from _current, the level is set by how far off it is
+      /// @param   uint32_t          Node index
+      /// @return  None
+      //+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+
+      void Insert(uint32_t node);
+
+      //+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+
+      /// @brief   Unlinks a node from its slot
+      /// @param   uint32_t          Node index
+      /// @return  None
+      //+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+
+      void Unlink(uint32_t node);
+
+      //+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+
+      /// @brief   Puts a node back on the free list, its id goes stale
+      /// @param   uint32_t          Node index
+      /// @return  None
+      //+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+
+      void Free(uint32_t node);
+
+      //+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+
+      /// @brief   Gets the first tick from _current on where a slot
+      /// @brief   holding timers fires or cascades
+      /// @return  uint64_t          Tick, UINT64_MAX if nothing is scheduled
+      //+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+
+      uint64_t Next_Tick() const;
+
+      //+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+
+      /// @brief   Gets the first occupied slot of a level at or
+      /// @brief   after a slot
+      /// @param   uint32_t          Level
+      /// @param   uint32_t          First slot to look at
+      /// @return  uint32_t          Slot, WHEEL_SLOTS if none
+      //+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+
+      uint32_t Next_Occupied(uint32_t level, uint32_t slot) const;
+
+      std::chrono::steady_clock::time_point _start;
+      uint64_t _current;                                    // Next tick to process
+      size_t _count;
+      uint32_t _free;                                       // Head of the free list
+      std::vector<Timer_Node> _nodes;
+      uint32_t _slots[FIRING_SLOT + 1];                     // Head of each slot's list
+      uint64_t _occupied[WHEEL_LEVELS][BITMAP_WORDS];       // Slots with a timer
+
+   };  // END class Timer_Wheel
+
+}  // END namespace Timers
@@ -15,54 +15,684 @@
 //  ECE      08-14-2024   Added _is_socket_connected flag
 //  ECE      08-15-2024   Implemented TCP Client option
 //  ECE      08-16-2024   Implemented UDP option
+//  ECE      10-17-2026   socket_events is now a growable list
+//  ECE      10-17-2026   Added Registered I/O engine option
+//  ECE      10-17-2026   Added Queue_Message and send wakeups
+//  ECE      10-17-2026   Lock free send and receive queues
+//  ECE      10-17-2026   TCP servers accept many clients into a connection table
+//  ECE      10-17-2026   Optional length prefixed framing, binary sends
+//  ECE      10-17-2026   Gathered batch sends with partial write resume
+//  ECE      10-17-2026   Batched UDP receives and segmented UDP sends
+//  ECE      10-17-2026   Received messages are pooled buffer views, no copies
+//  ECE      10-17-2026   Sockets and connections are sharded across event loops
+//  ECE      10-17-2026   Received messages are handled on the work stealing pool
+//  ECE      10-17-2026   Coroutine receive, send and accept
+//  ECE      10-17-2026   Sockets live in the registry, no MAX_SOCKETS ceiling
+//  ECE      10-17-2026   Non-blocking connect and reconnect with backoff, no threads
+//  ECE      10-17-2026   Full socket buffers leave a backlog resumed when writable
+//  ECE      10-17-2026   Queued send bytes are bounded by per socket watermarks
+//  ECE      10-17-2026   Counts bytes, messages, calls and latencies per socket
+//  ECE      10-17-2026   Messages go to the asynchronous log
+//  ECE      10-17-2026   Large TCP client messages may be sent zero-copy
+//  ECE      10-17-2026   Files streamed by TransmitFile from the send backlog
+//  ECE      10-17-2026   UNIX_STREAM sockets over AF_UNIX, sockets passed to the peer
+//  ECE      10-17-2026   SHARED_MEMORY sockets over rings in a shared mapping
+//  ECE      10-17-2026   Deadlines, idle timeouts and heartbeats on per loop timer wheels
+//  ECE      10-17-2026   Broadcasts framed once and shared by every subscriber
+//  ECE      10-17-2026   IPv6 UDP, multicast joins and per group receive demultiplexing
+//  ECE      10-17-2026   Queued messages are held in pooled buffers
+//  ECE      10-17-2026   Zero-copy clients keep the default send buffer
+//  ECE      10-17-2026   Broadcasts walk each loop's active list, not every slot
+//  ECE      10-17-2026   Datagram replies go straight to their sender, the peer address is never changed
+//  ECE      10-17-2026   Zero-copy clients have no send buffer and send every message overlapped
+//  ECE      10-17-2026   Async sends park on a full queue, connection events never wait
+//  ECE      10-17-2026   Datagram replies are queued with their destination, UDP sends go to the last sender
 //+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+
 
 // Need to link with Ws2_32.lib
 #pragma comment (lib, "Ws2_32.lib")
+#pragma comment (lib, "Mswsock.lib")
 
 #include "Universal_Socket.h"
+#include "Registered_IO.h"
+#include "Socket_Registry.h"
 
+#include <algorithm>
+#include <atomic>
 #include <tchar.h>
+#include <thread>
+
+// Segmented UDP sends need the Windows 10 1809 SDK or newer
+#ifndef UDP_SEND_MSG_SIZE
+#define UDP_SEND_MSG_SIZE 2
+#endif
 
 namespace Socket_Vars
 {
-   // List of all socket event handles
-   HANDLE socket_events[MAX_EVENTS];
+   // Number of event loops, fixed once the first socket is created
+   uint16_t event_loop_count = 1;
+
+   // Every message handled is printed while true
+   bool print_messages = true;
+
+   // Signaled whenever a socket is scheduled on an event loop
+   HANDLE send_wake_events[MAX_EVENT_LOOPS];
+
+   // Sockets waiting on each event loop's sending thread, linked through
+   // each socket's slot, the link's flag keeps a socket from being listed
+   // twice on the same loop
+   Lock_Free::Link_Queue<Socket_Link> scheduled_sends[MAX_EVENT_LOOPS];
+
+   // The first socket fixes the number of event loops
+   std::once_flag event_loops_fixed;
+
+   // Loopback socket each event loop polls alongside its sockets, a datagram
+   // sent to it wakes the loop, is_loop_wake_pending keeps every wake after
+   // the first from sending again
+   SOCKET loop_wake_sockets[MAX_EVENT_LOOPS];
+   SOCKADDR_IN loop_wake_addresses[MAX_EVENT_LOOPS];
+   std::atomic<bool> is_loop_open[MAX_EVENT_LOOPS];
+   std::atomic<bool> is_loop_wake_pending[MAX_EVENT_LOOPS];
+
+   // Each event loop's timers, its receiving thread the only one to touch them
+   Timers::Timer_Wheel timer_wheels[MAX_EVENT_LOOPS];
+
+   extern bool Add_Event_To_Event_List(HANDLE& event, uint32_t& event_list_index)
+   {
+      bool result = true;
+
+      //
+      // 1. The first socket fixes the number of event loops, each loop gets
+      //    its wake event
+      std::call_once(event_loops_fixed, []()
+      {
+         if (0 == event_loop_count || MAX_EVENT_LOOPS < event_loop_count)
+         {
+            event_loop_count = (0 == event_loop_count) ? 1 : MAX_EVENT_LOOPS;
+         }
+         for (uint16_t loop = 0; loop < event_loop_count; loop++)
+         {
+            send_wake_events[loop] = CreateEvent(nullptr, FALSE, FALSE, nullptr);
+         }
+      });
+
+      //
+      // 2. Take a registry slot, it holds the event and the send queue
+      event_list_index = Sockets().Add_Slot(event);
+      if (NO_SOCKET == event_list_index)
+      {
+         result &= false;
+      }
+
+      return result;
+   }  // END Add_Event_To_Event_List()
+
+   extern HANDLE& Get_Socket_Event(uint32_t socket_index)
+   {
+      return Sockets().Get_Slot(socket_index).event;
+   }  // END Get_Socket_Event()
+
+   extern Lock_Free::MPSC_Queue<Queued_Send>& Get_Send_Queue(uint32_t socket_index)
+   {
+      return Sockets().Get_Slot(socket_index).send_queue;
+   }  // END Get_Send_Queue()
+
+   //+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+
+   /// Tells the handler each time the socket crosses a watermark
+   //+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+
+   static void Check_Watermarks(uint32_t socket_index)
+   {
+      Socket_Slot& slot = Sockets().Get_Slot(socket_index);
+      size_t queued_bytes;
+      bool is_throttled;
+
+      //
+      // 1. Only the thread that flips the flag calls the handler, the count
+      //    is read again after since it may have crossed back meanwhile
+      while (true)
+      {
+         queued_bytes = slot.queued_bytes.load(std::memory_order_acquire);
+         is_throttled = slot.is_throttled.load(std::memory_order_acquire);
+         if (!is_throttled && slot.high_watermark <= queued_bytes)
+         {
+            if (slot.is_throttled.exchange(true, std::memory_order_acq_rel))
+            {
+               continue;
+            }
+         }
+         else if (is_throttled && queued_bytes <= slot.low_watermark)
+         {
+            if (!slot.is_throttled.exchange(false, std::memory_order_acq_rel))
+            {
+               continue;
+            }
+         }
+         else
+         {
+            break;
+         }
+
+         if (nullptr != slot.watermark_handler)
+         {
+            slot.watermark_handler(socket_index, !is_throttled);
+         }
+      }
+   }  // END Check_Watermarks()
+
+   //+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+
+   /// Counts the message's bytes and pushes it on the send queue, with
+   /// the datagram destination when one is given
+   //+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+
+   static bool Push_Send(uint32_t socket_index, Buffers::Buffer_View message, const SOCKADDR_INET* destination = nullptr)
+   {
+      Socket_Slot& slot = Sockets().Get_Slot(socket_index);
+      size_t length = message.Size();
+      size_t queued_bytes;
+      Queued_Send queued{ std::move(message) };
+
+      if (nullptr != destination)
+      {
+         queued.destination = *destination;
+      }
+
+      //
+      // 1. Count the bytes before the push so the sending thread never takes
+      //    off more than was added, a message past the limit is refused
+      queued_bytes = slot.queued_bytes.fetch_add(length, std::memory_order_acq_rel) + length;
+      if (slot.send_buffer_limit < queued_bytes)
+      {
+         slot.queued_bytes.fetch_sub(length, std::memory_order_acq_rel);
+         slot.stats.Add(Stats::MESSAGES_DROPPED);
+         return false;
+      }
+      if (!slot.send_queue.Push(std::move(queued)))
+      {
+         slot.queued_bytes.fetch_sub(length, std::memory_order_acq_rel);
+         slot.stats.Add(Stats::MESSAGES_DROPPED);
+         return false;
+      }
+      slot.stats.Raise_Peak(queued_bytes);
+
+      //
+      // 2. Producers are told to hold off once the high watermark is reached
+      if (slot.high_watermark <= queued_bytes)
+      {
+         Check_Watermarks(socket_index);
+      }
+      return true;
+   }  // END Push_Send()
+
+   extern bool Is_Send_Throttled(uint32_t socket_index)
+   {
+      return Sockets().Get_Slot(socket_index).is_throttled.load(std::memory_order_acquire);
+   }  // END Is_Send_Throttled()
+
+   extern void Release_Send_Bytes(uint32_t socket_index, size_t bytes)
+   {
+      Socket_Slot& slot = Sockets().Get_Slot(socket_index);
+      size_t queued_bytes;
 
-   // Number of events in the socket_events list
-   uint16_t event_count = 0;
+      if (0 == bytes)
+      {
+         return;
+      }
+
+      //
+      // 1. Producers held off are told to go on once the low watermark is
+      //    reached, async sends parked on the full queue are handed back
+      queued_bytes = slot.queued_bytes.fetch_sub(bytes, std::memory_order_acq_rel) - bytes;
+      if (queued_bytes <= slot.low_watermark)
+      {
+         if (slot.is_throttled.load(std::memory_order_acquire))
+         {
+            Check_Watermarks(socket_index);
+         }
+         slot.send_waiters.Wake();
+      }
+   }  // END Release_Send_Bytes()
 
-   // Mutexs for send and receive queues
-   std::mutex receive_mutex[MAX_SOCKETS];
-   std::mutex send_mutex[MAX_SOCKETS];
+   extern SOCKET Open_Passed_Socket(const char* message, size_t length)
+   {
+      WSAPROTOCOL_INFOW info;
+
+      //
+      // 1. Anything but a whole WSAPROTOCOL_INFOW is an ordinary message
+      if (sizeof(info) != length)
+      {
+         Log::Write<Log::LEVEL_WARNING>("Open_Passed_Socket() message of %zu bytes is not a socket!\n", length);
+         return INVALID_SOCKET;
+      }
+      memcpy(&info, message, sizeof(info));
 
-   // Receive and send queues for each socket,
-   // if you have a message to be sent, place it on the send queue
-   // if a message is received, it will be placed on the receive queue
-   std::queue<std::string> receive_queue[MAX_SOCKETS];
-   std::queue<std::string> send_queue[MAX_SOCKETS];
+      //
+      // 2. The duplicate was made for this process, opening it takes it over
+      return WSASocketW(FROM_PROTOCOL_INFO, FROM_PROTOCOL_INFO, FROM_PROTOCOL_INFO, &info, 0, WSA_FLAG_OVERLAPPED);
+   }  // END Open_Passed_Socket()
 
-   extern bool Add_Event_To_Event_List(HANDLE& event, uint16_t& event_list_index)
+   extern bool Queue_Message(uint32_t socket_index, Buffers::Buffer_View message)
    {
       bool result = true;
 
       //
-      // 1. Check size of the event list
-      if (MAX_EVENTS <= event_count)
+      // 1. Place the message on the send queue, unless the queue is full or
+      //    it would take the socket past its send buffer limit
+      if (!Push_Send(socket_index, std::move(message)))
       {
-         printf("Too many sockets!\n");
+         Log::Write<Log::LEVEL_WARNING>("Socket %u send_queue is full, message dropped!\n", socket_index);
          result &= false;
          return result;
       }
 
       //
-      // 2. Add event to event list and increment size
-      event_list_index = event_count;
-      socket_events[event_list_index] = event;  // Might be false warning, should be ok
-      event_count++;
+      // 2. Wake the sending thread for this socket
+      Schedule_Send(socket_index);
 
       return result;
-   }  // END Add_Event_To_Event_List()
+   }  // END Queue_Message()
+
+   extern bool Queue_Message(uint32_t socket_index, const std::string& message)
+   {
+      return Queue_Message(socket_index, Buffers::Copy_To_Send_Pool(message.data(), message.size()));
+   }  // END Queue_Message()
+
+   extern bool Queue_Datagram(uint32_t socket_index, const SOCKADDR_INET& destination, Buffers::Buffer_View message)
+   {
+      bool result = true;
+
+      //
+      // 1. The datagram waits on the send queue in order with the socket's
+      //    other messages, under the same limit and watermarks
+      if (!Push_Send(socket_index, std::move(message), &destination))
+      {
+         Log::Write<Log::LEVEL_WARNING>("Socket %u send_queue is full, datagram dropped!\n", socket_index);
+         result &= false;
+         return result;
+      }
+
+      //
+      // 2. Wake the sending thread for this socket
+      Schedule_Send(socket_index);
+
+      return result;
+   }  // END Queue_Datagram()
+
+   extern bool Queue_Connection_Message(
+      uint32_t socket_index,
+      Connection_Table* connections,
+      uint32_t connection,
+      Buffers::Buffer_View message)
+   {
+      bool result = true;
+      uint16_t loop = connections->Get(connection).loop.load(std::memory_order_acquire);
+
+      //
+      // 1. Place the message on the connection's send queue
+      if (!connections->Queue_Message(connection, std::move(message)))
+      {
+         Log::Write<Log::LEVEL_WARNING>("Socket %u connection %u closed or full, message dropped!\n", socket_index, connection);
+         Sockets().Get_Slot(socket_index).stats.Add(Stats::MESSAGES_DROPPED);
+         result &= false;
+         return result;
+      }
+
+      //
+      // 2. Wake the sending thread of the connection's event loop
+      Schedule_Send(socket_index, loop);
+
+      return result;
+   }  // END Queue_Connection_Message()
+
+   extern bool Reply(Message_Context& context, const Received_Message& received, Buffers::Buffer_View message)
+   {
+      if (NO_CONNECTION != received.connection)
+      {
+         return Queue_Connection_Message(context.socket_index, context.connections, received.connection, std::move(message));
+      }
+
+      //
+      // A datagram is queued with the sender it answers, the sending thread
+      // sends it there whatever arrived since
+      if (0 != received.sender.si_family)
+      {
+         return Queue_Datagram(context.socket_index, received.sender, std::move(message));
+      }
+      return Queue_Message(context.socket_index, std::move(message));
+   }  // END Reply()
+
+   extern bool Reply(Message_Context& context, const Received_Message& received, const std::string& message)
+   {
+      return Reply(context, received, Buffers::Copy_To_Send_Pool(message.data(), message.size()));
+   }  // END Reply()
+
+   extern void Default_Message_Handler(Message_Context& context, Received_Message& received)
+   {
+      static std::atomic<int> send_count{ 1 };
+
+      //
+      // 1. Logged straight out of the pooled buffer, not null-terminated
+      //    so only its length is copied
+      if (print_messages)
+      {
+         Log::Write<Log::LEVEL_DEBUG>("%s Receive() = %s\n",
+            context.socket_name,
+            std::string_view(received.message.Data(), received.message.Size()));
+      }
+
+      //
+      // 2. Queue the reply, only to the client that sent the message
+      //    when it arrived on one of many accepted connections
+      std::string my_string = "Hey Client!";
+      my_string += std::to_string(send_count++);
+      Reply(context, received, my_string);
+   }  // END Default_Message_Handler()
+
+   extern void Async_Message_Handler(Message_Context& context, Received_Message& received)
+   {
+      //
+      // 1. A new client, anything left from the slot's last client goes,
+      //    then the server's accepting coroutine gets it
+      if (CONNECTION_OPENED == received.event)
+      {
+         context.connections->Get_Queues(received.connection).received.Clear();
+         context.accepted.Deliver(Async_Connection(&context, received.connection));
+         return;
+      }
+
+      //
+      // 2. Messages and the closing event go to whoever awaits the
+      //    connection, or the socket itself
+      if (NO_CONNECTION != received.connection)
+      {
+         context.connections->Get_Queues(received.connection).received.Deliver(std::move(received));
+      }
+      else
+      {
+         context.received.Deliver(std::move(received));
+      }
+   }  // END Async_Message_Handler()
+
+   //+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+
+   /// Runs a socket's handler on a message taken off a strand,
+   /// then releases the view back to the pool
+   //+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+
+   static void Dispatch_Message(void* context, Received_Message& received)
+   {
+      Message_Context* message_context = static_cast<Message_Context*>(context);
+
+      if (MESSAGE_RECEIVED == received.event)
+      {
+         message_context->stats->queue_dwell.Record_Since(received.queued_at);
+      }
+      message_context->handler(*message_context, received);
+      received.message.Reset();
+   }  // END Dispatch_Message()
+
+   //+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+
+   /// Parses an address of the given family into a group key,
+   /// an IPv4 address mapped to ::ffff:a.b.c.d, true only if it
+   /// is a multicast group, 224.0.0.0/4 or ff00::/8
+   //+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+
+   static bool Get_Group_Key(const std::string& address, ADDRESS_FAMILY family, uint8_t* key)
+   {
+      std::wstring w_str(address.begin(), address.end());
+
+      memset(key, 0, sizeof(Multicast_Group::key));
+      if (AF_INET6 == family)
+      {
+         return 1 == InetPton(AF_INET6, w_str.c_str(), key) && 0xFF == key[0];
+      }
+      key[10] = 0xFF;
+      key[11] = 0xFF;
+      return 1 == InetPton(AF_INET, w_str.c_str(), &key[12]) && 0xE0 == (key[12] & 0xF0);
+   }  // END Get_Group_Key()
+
+   //+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+
+   /// Finds the group a datagram's destination belongs to in a
+   /// sorted snapshot, feeds arrive in bursts so the group of the
+   /// last datagram is tried before the binary search
+   //+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+
+   static uint32_t Find_Group(const Multicast_Groups& groups, const uint8_t* key, size_t& last_hit)
+   {
+      size_t low = 0;
+      size_t high = groups.size();
+      size_t middle;
+      int order;
+
+      if (last_hit < groups.size() && 0 == memcmp(groups[last_hit].key, key, sizeof(Multicast_Group::key)))
+      {
+         return groups[last_hit].group;
+      }
+      while (low < high)
+      {
+         middle = low + (high - low) / 2;
+         order = memcmp(groups[middle].key, key, sizeof(Multicast_Group::key));
+         if (0 == order)
+         {
+            last_hit = middle;
+            return groups[middle].group;
+         }
+         if (0 > order)
+         {
+            low = middle + 1;
+         }
+         else
+         {
+            high = middle;
+         }
+      }
+      return NO_GROUP;
+   }  // END Find_Group()
+
+   extern void Schedule_Send(uint32_t socket_index, uint16_t loop)
+   {
+      Socket_Link& link = Sockets().Get_Slot(socket_index).scheduled[loop];
+
+      //
+      // 1. Only the producer that flips the flag lists the socket, the list
+      //    is linked through the slot so the push never fails
+      if (link.is_listed.exchange(true, std::memory_order_acq_rel))
+      {
+         return;
+      }
+      scheduled_sends[loop].Push(&link);
+
+      //
+      // 2. Only the producer that scheduled the socket signals the event,
+      //    later producers know the sending thread is already coming
+      SetEvent(send_wake_events[loop]);
+   }  // END Schedule_Send()
+
+   extern void Take_Scheduled_Sends(uint16_t loop, std::vector<uint32_t>& socket_indexes)
+   {
+      Socket_Link* link;
+
+      // The flag is cleared before the socket is serviced so a message
+      // queued during the send schedules it again
+      socket_indexes.clear();
+      while (nullptr != (link = scheduled_sends[loop].Pop()))
+      {
+         link->is_listed.store(false, std::memory_order_release);
+         socket_indexes.push_back(link->socket_index);
+      }
+   }  // END Take_Scheduled_Sends()
+
+   extern SOCKET Open_Event_Loop(uint16_t loop)
+   {
+      int func_result;
+      int address_size = sizeof(SOCKADDR_IN);
+      u_long non_blocking = 1;
+      SOCKET wake_socket;
+
+      //
+      // 1. WSAPoll() has no eventfd, a UDP socket on an ephemeral loopback
+      //    port stands in for one
+      wake_socket = socket(AF_INET, SOCK_DGRAM, IPPROTO_UDP);
+      if (INVALID_SOCKET == wake_socket)
+      {
+         Log::Write<Log::LEVEL_ERROR>("Event loop %u wake socket() failed with: %u\n", loop, WSAGetLastError());
+         return INVALID_SOCKET;
+      }
+
+      //
+      // 2. Bind it and read back the port the system picked
+      memset(&loop_wake_addresses[loop], 0, sizeof(SOCKADDR_IN));
+      loop_wake_addresses[loop].sin_family = AF_INET;
+      loop_wake_addresses[loop].sin_port = 0;
+      loop_wake_addresses[loop].sin_addr.s_addr = htonl(INADDR_LOOPBACK);
+      func_result = bind(wake_socket, (SOCKADDR*)&loop_wake_addresses[loop], sizeof(SOCKADDR_IN));
+      if (SOCKET_ERROR != func_result)
+      {
+         func_result = getsockname(wake_socket, (SOCKADDR*)&loop_wake_addresses[loop], &address_size);
+      }
+      if (SOCKET_ERROR != func_result)
+      {
+         func_result = ioctlsocket(wake_socket, FIONBIO, &non_blocking);
+      }
+      if (SOCKET_ERROR == func_result)
+      {
+         Log::Write<Log::LEVEL_ERROR>("Event loop %u wake socket setup failed with: %u\n", loop, WSAGetLastError());
+         closesocket(wake_socket);
+         return INVALID_SOCKET;
+      }
+
+      //
+      // 3. Publish it, wakes before now are not lost since the loop builds
+      //    its poll set after opening
+      loop_wake_sockets[loop] = wake_socket;
+      is_loop_open[loop].store(true, std::memory_order_release);
+
+      return wake_socket;
+   }  // END Open_Event_Loop()
+
+   extern void Wake_Event_Loop(uint16_t loop)
+   {
+      char wake = 0;
+
+      if (!is_loop_open[loop].load(std::memory_order_acquire))
+      {
+         return;
+      }
+      if (!is_loop_wake_pending[loop].exchange(true, std::memory_order_acq_rel))
+      {
+         sendto(loop_wake_sockets[loop], &wake, 1, 0, (SOCKADDR*)&loop_wake_addresses[loop], sizeof(SOCKADDR_IN));
+      }
+   }  // END Wake_Event_Loop()
+
+   extern void Clear_Event_Loop_Wake(uint16_t loop)
+   {
+      char drain[16];
+
+      // Rearm before draining so a wake sent during the drain is not lost
+      is_loop_wake_pending[loop].exchange(false, std::memory_order_acq_rel);
+      while (0 < recv(loop_wake_sockets[loop], drain, sizeof(drain), 0))
+      {
+      }
+   }  // END Clear_Event_Loop_Wake()
+
+   extern Timers::Timer_Wheel& Get_Timer_Wheel(uint16_t loop)
+   {
+      return timer_wheels[loop];
+   }  // END Get_Timer_Wheel()
+
+   //-+-+-+-+-+-+-+-+-+-+-+Send_Awaiter FUNCTIONS+-+-+-+-+-+-+-+-+-+-+-+-+
+
+   //+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+
+   /// Constructor
+   //+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+
+   Send_Awaiter::Send_Awaiter(Message_Context* context, uint32_t connection, std::span<const char> message)
+      : _context(context), _connection(connection), _message(Buffers::Copy_To_Send_Pool(message.data(), message.size())), _result(false)
+   {
+   }  // END Constructor
+
+   //+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+
+   /// Queues the message and wakes its sending thread
+   //+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+
+   bool Send_Awaiter::Try_Queue()
+   {
+      //
+      // 1. To the socket itself
+      if (NO_CONNECTION == _connection)
+      {
+         if (!Push_Send(_context->socket_index, _message))
+         {
+            return false;
+         }
+         Schedule_Send(_context->socket_index);
+         _result = true;
+         return true;
+      }
+
+      //
+      // 2. To one client, a client that left is done with, not retried
+      Connection& state = _context->connections->Get(_connection);
+      if (!_context->connections->Is_Current(_connection) || !state.is_connected.load(std::memory_order_acquire))
+      {
+         _result = false;
+         return true;
+      }
+      if (!_context->connections->Queue_Message(_connection, _message))
+      {
+         return false;
+      }
+      Schedule_Send(_context->socket_index, state.loop.load(std::memory_order_acquire));
+      _result = true;
+      return true;
+   }  // END Try_Queue()
+
+   //+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+
+   /// Tries once more, then waits for the sending thread to make room
+   //+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+
+   bool Send_Awaiter::Park()
+   {
+      Send_Waiters& waiters = (NO_CONNECTION == _connection)
+         ? Sockets().Get_Slot(_context->socket_index).send_waiters
+         : _context->connections->Get_Queues(_connection).send_waiters;
+      std::lock_guard<std::mutex> lock(waiters.mutex);
+
+      //
+      // 1. Count in before the last try, a sending thread that makes room
+      //    after it sees the count and wakes the list, see Send_Waiters
+      waiters.count.fetch_add(1, std::memory_order_seq_cst);
+      std::atomic_thread_fence(std::memory_order_seq_cst);
+      if (Try_Queue())
+      {
+         waiters.count.fetch_sub(1, std::memory_order_seq_cst);
+         return false;
+      }
+
+      //
+      // 2. Still full, the awaiter holds no worker while it waits
+      waiters.tasks.push_back(this);
+      return true;
+   }  // END Park()
+
+   //+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+
+   /// The send queue was full, park until there is room
+   //+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+
+   bool Send_Awaiter::await_suspend(std::coroutine_handle<> handle)
+   {
+      _handle = handle;
+      return Park();
+   }  // END await_suspend()
+
+   //+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+
+   /// Woken by the sending thread, queues the send or parks again
+   //+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+
+   void Send_Awaiter::Run()
+   {
+      if (!Park())
+      {
+         _handle.resume();
+      }
+   }  // END Run()
+
+   //+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+
+   /// Awaits the client's next message
+   //+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+
+   Async::Channel<Received_Message>::Awaiter Async_Connection::Async_Receive()
+   {
+      return _context->connections->Get_Queues(_connection).received.Receive();
+   }  // END Async_Receive()
 
 }  // END namespace Socket_Vars
 
@@ -75,18 +705,17 @@ bool Universal_Socket::TCP_Server_Start()
 {
    bool result = true;
    int func_result = 0;
-   int opt_val = 0;
+   int opt_val = 1;
 
    //
-   // 1. Create the listen socket for TCP
-   _listen_socket = socket(
-      AF_INET,     // address family = IPV4
+   // 1. Create the listen socket for TCP, or AF_UNIX for UNIX_STREAM
+   _listen_socket = Open_Socket(
       SOCK_STREAM, // type = TCP
       IPPROTO_TCP  // protocol = TCP
    );
    if (SOCKET_ERROR == _listen_socket)
    {
-      printf("ERROR, Server socket() failed with: %u\n", WSAGetLastError());
+      Log::Write<Log::LEVEL_ERROR>("ERROR, Server socket() failed with: %u\n", WSAGetLastError());
       result &= false;
       return result;
    }
@@ -96,48 +725,57 @@ bool Universal_Socket::TCP_Server_Start()
    setsockopt(_listen_socket, SOL_SOCKET, SO_KEEPALIVE, (char*)&opt_val, sizeof(int));
 
    //
-   // 3. Initialize the SOCKADDR_IN
-   _address.sin_family = AF_INET;
-   _address.sin_port = htons(_port);
-   // InetPton() requires IP Address as a PCWSTR
-   // this is the conversion of std::string to PCWSTR
-   std::wstring w_str(_ip_address.begin(), _ip_address.end());
-   PCWSTR pcwstr_ip = w_str.c_str();
-   InetPton(AF_INET, pcwstr_ip, &_address.sin_addr.s_addr);
+   // 3. Initialize the address, a UNIX_STREAM path left by a server that
+   //    did not close cleanly would refuse the bind
+   result &= Set_Stream_Address();
+   if (!result)
+   {
+      return result;
+   }
+   if (Socket_Vars::UNIX_STREAM == _protocol)
+   {
+      DeleteFileA(_unix_address.sun_path);
+   }
  
    //
-   // 4. Bind the socket to an IP address and port
-   func_result = bind(_listen_socket, (SOCKADDR*)&_address, sizeof(_address));
+   // 4. Bind the socket to an IP address and port, or to its path
+   func_result = bind(_listen_socket, Stream_Address(), Stream_Address_Size());
    if (SOCKET_ERROR == func_result)
    {
-      printf("ERROR, Server bind() failed with: %u\n", WSAGetLastError());
-      printf("Port = %d\n", _port);
-      printf("IP Address = %s\n", _ip_address.c_str());
+      Log::Write<Log::LEVEL_ERROR>("ERROR, Server bind() failed with: %u\n", WSAGetLastError());
+      Log::Write<Log::LEVEL_ERROR>("Port = %d\n", _port);
+      Log::Write<Log::LEVEL_ERROR>("IP Address = %s\n", _ip_address);
       result &= false;
       return result;
    }
 
    //
-   // 5. Listen for incoming connections
-   func_result = listen(_listen_socket, 1);
+   // 5. Listen for incoming connections, event select servers keep every
+   //    client in a connection table so the backlog is as deep as allowed
+   if (Socket_Vars::EVENT_SELECT == _io_engine)
+   {
+      _connections.reset(new Connection_Table(Socket_Vars::event_loop_count, Socket_Vars::Dispatch_Message, _context.get()));
+      _context->connections = _connections.get();
+   }
+   func_result = listen(_listen_socket, SOMAXCONN);
    if (SOCKET_ERROR == func_result)
    {
-      printf("ERROR, Server listen() failed with: %u\n", WSAGetLastError());
+      Log::Write<Log::LEVEL_ERROR>("ERROR, Server listen() failed with: %u\n", WSAGetLastError());
       result &= false;
       return result;
    }
    else
    {
-      printf("TCP-Server %s awaiting new connections!\n", _socket_name.c_str());
+      Log::Write<Log::LEVEL_INFO>("TCP-Server %s awaiting new connections!\n", _socket_name);
    }
 
    //
    // 6. Create an event for the listen socket
    HANDLE event = WSACreateEvent();
-   Socket_Vars::socket_events[_event_handle_index] = event;
-   if (WSA_INVALID_EVENT == Socket_Vars::socket_events[_event_handle_index])
+   Socket_Vars::Get_Socket_Event(_event_handle_index) = event;
+   if (WSA_INVALID_EVENT == Socket_Vars::Get_Socket_Event(_event_handle_index))
    {
-      printf("ERROR, Server WSACreateEvent() failed with: %u\n", WSAGetLastError());
+      Log::Write<Log::LEVEL_ERROR>("ERROR, Server WSACreateEvent() failed with: %u\n", WSAGetLastError());
       result &= false;
       return result;
    }
@@ -146,11 +784,11 @@ bool Universal_Socket::TCP_Server_Start()
    // 7. Use 'WSAEventSelect' to associate an event with the socket
    func_result = WSAEventSelect(
       _listen_socket, 
-      Socket_Vars::socket_events[_event_handle_index],
+      Socket_Vars::Get_Socket_Event(_event_handle_index),
       FD_ACCEPT | FD_READ | FD_WRITE | FD_CLOSE);
    if (SOCKET_ERROR == func_result)
    {
-      printf("ERROR, Server WSAEventSelect() failed with: %u\n", WSAGetLastError());
+      Log::Write<Log::LEVEL_ERROR>("ERROR, Server WSAEventSelect() failed with: %u\n", WSAGetLastError());
       result &= false;
       return result;
    }
@@ -164,22 +802,53 @@ bool Universal_Socket::TCP_Server_Start()
 bool Universal_Socket::TCP_Client_Start()
 {
    bool result = true;
-   int func_result = 0;
+
    //
-   // 1. Attempt connection with the server
-   _socket = socket(
-      AF_INET,       // address family = IPV4
-      SOCK_STREAM,   // type = TCP
-      IPPROTO_TCP);  // protocol = TCP
-   if (INVALID_SOCKET == _socket)
+   // 1. Initialize the address of the server
+   result &= Set_Stream_Address();
+   if (!result)
    {
-      printf("ERROR, Client socket() failed with: %u\n", WSAGetLastError());
-      result &= false;
       return result;
    }
 
    //
-   // 2. Initialize the SOCKADDR_IN
+   // 2. Start connecting with the server, the connect completes on the
+   //    event loop, a server not up yet is retried with backoff
+   _reconnect_attempts = 0;
+   if (!Begin_Connect())
+   {
+      result &= Reconnect();
+   }
+
+   return result;
+}  // END TCP_Client_Start()
+
+//+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+    
+/// Fills in the address a stream socket binds or connects to
+//+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+
+bool Universal_Socket::Set_Stream_Address()
+{
+   bool result = true;
+
+   //
+   // 1. A UNIX_STREAM socket's ip_address is its path, with room for the
+   //    terminator
+   if (Socket_Vars::UNIX_STREAM == _protocol)
+   {
+      if (sizeof(_unix_address.sun_path) <= _ip_address.size())
+      {
+         Log::Write<Log::LEVEL_ERROR>("%s path is over %zu characters: %s\n", _socket_name, sizeof(_unix_address.sun_path) - 1, _ip_address);
+         result &= false;
+         return result;
+      }
+      memset(&_unix_address, 0, sizeof(_unix_address));
+      _unix_address.sun_family = AF_UNIX;
+      memcpy(_unix_address.sun_path, _ip_address.data(), _ip_address.size());
+      return result;
+   }
+
+   //
+   // 2. Initialize the SOCKADDR_IN
    _address.sin_family = AF_INET;
    _address.sin_port = htons(_port);
    // InetPton() requires IP Address as a PCWSTR
@@ -188,449 +857,3089 @@ bool Universal_Socket::TCP_Client_Start()
    PCWSTR pcwstr_ip = w_str.c_str();
    InetPton(AF_INET, pcwstr_ip, &_address.sin_addr.s_addr);
 
+   return result;
+}  // END Set_Stream_Address()
+
+//+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+    
+/// Opens the socket as UDP
+//+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+
+bool Universal_Socket::UDP_Socket_Start()
+{
+   bool result = true;
+   int func_result;
+   DWORD reuse = 1;
+   SOCKADDR_IN bind_address;
+   SOCKADDR_IN6 bind_address6;
+   uint8_t key[sizeof(Socket_Vars::Multicast_Group::key)];
+
    //
-   // 3. Make a connection with the server
-   func_result = connect(_socket, (SOCKADDR*) &_address, sizeof(_address));
+   // 1. Create a UDP socket in the family of its address
+   _socket = Open_Socket(SOCK_DGRAM, IPPROTO_UDP);
+   if (INVALID_SOCKET == _socket) {
+      Log::Write<Log::LEVEL_ERROR>("UDP %s socket() failed with: %u\n", _socket_name, WSAGetLastError());
+      result &= false;
+      return result;
+   }
+
+   //
+   // 2. Initialize the SOCKADDR_IN, or the SOCKADDR_IN6 of an IPv6 socket
+   // InetPton() requires IP Address as a PCWSTR
+   // this is the conversion of std::string to PCWSTR
+   std::wstring w_str(_ip_address.begin(), _ip_address.end());
+   PCWSTR pcwstr_ip = w_str.c_str();
+   if (AF_INET6 == _family)
+   {
+      _address6.sin6_family = AF_INET6;
+      _address6.sin6_port = htons(_port);
+      InetPton(AF_INET6, pcwstr_ip, &_address6.sin6_addr);
+   }
+   else
+   {
+      _address.sin_family = AF_INET;
+      _address.sin_port = htons(_port);
+      InetPton(AF_INET, pcwstr_ip, &_address.sin_addr.s_addr);
+   }
+   _is_multicast = Socket_Vars::Get_Group_Key(_ip_address, _family, key);
+
+   //
+   // 3. Listen on specific port for incoming messages, a socket whose
+   //    address is a group binds the wildcard address so every group
+   //    joined on the port arrives, and shares the port on this host
+   bind_address = _address;
+   bind_address6 = _address6;
+   if (_is_multicast)
+   {
+      setsockopt(_socket, SOL_SOCKET, SO_REUSEADDR, (char*)&reuse, sizeof(reuse));
+      bind_address.sin_addr.s_addr = htonl(INADDR_ANY);
+      memset(&bind_address6.sin6_addr, 0, sizeof(bind_address6.sin6_addr));
+   }
+   func_result = bind(
+      _socket,
+      (AF_INET6 == _family) ? (SOCKADDR*)&bind_address6 : (SOCKADDR*)&bind_address,
+      Peer_Address_Size());
    if (0 != func_result)
    {
-      printf("ERROR, Client connect() failed with: %u\n", WSAGetLastError());
+      Log::Write<Log::LEVEL_ERROR>("ERROR, UDP bind() failed with: %u\n", WSAGetLastError());
       result &= false;
       return result;
    }
    else
    {
-      printf("TCP Client %s: Ready for sending and/or receiving messages...\n", _socket_name.c_str());
+      Log::Write<Log::LEVEL_INFO>("UDP Socket %s: Ready for sending and/or receiving messages...\n", _socket_name);
       result &= true;
       _is_socket_connected = true;
    }
 
    //
-   // 4. Create an event for the listen socket
-   HANDLE event = WSACreateEvent();
-   Socket_Vars::socket_events[_event_handle_index] = event;
-   if (WSA_INVALID_EVENT == Socket_Vars::socket_events[_event_handle_index])
+   // 4. Size the batch up front, datagrams land in pooled buffers
+   if (1 < _udp_batch_size)
+   {
+      _datagrams.resize(_udp_batch_size);
+      _datagram_senders.resize(_udp_batch_size);
+   }
+
+   //
+   // 5. Datagrams carry their destination and groups asked for are joined
+   result &= Configure_Multicast();
+   if (!result)
    {
-      printf("ERROR, Client WSACreateEvent() failed with: %u\n", WSAGetLastError());
-      result &= false;
       return result;
    }
 
    //
-   // 5. Use 'WSAEventSelect' to associate an event with the socket
-   func_result = WSAEventSelect(
-      _socket,
-      Socket_Vars::socket_events[_event_handle_index],
-      FD_ACCEPT | FD_READ | FD_WRITE | FD_CLOSE);
+   // 6. Attach the socket to its event or the registered I/O engine
+   result &= Attach_Socket();
+
+   return result;
+}  // END UDP_Socket_Start()
+
+//+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+
+/// Sets the bound UDP socket up for multicast
+//+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+
+bool Universal_Socket::Configure_Multicast()
+{
+   bool result = true;
+   int func_result;
+   int level = (AF_INET6 == _family) ? IPPROTO_IPV6 : IPPROTO_IP;
+   DWORD option = 1;
+   DWORD bytes = 0;
+   DWORD interface_index;
+   DWORD ttl = _multicast_ttl;
+   DWORD is_loopback = _is_multicast_loopback ? 1 : 0;
+   GUID receive_id = WSAID_WSARECVMSG;
+
+   //
+   // 1. Every datagram carries the address it was sent to, which says the
+   //    group it arrived on, only WSARecvMsg() reads it
+   func_result = setsockopt(_socket, level, (AF_INET6 == _family) ? IPV6_PKTINFO : IP_PKTINFO, (char*)&option, sizeof(option));
+   if (SOCKET_ERROR != func_result)
+   {
+      func_result = WSAIoctl(
+         _socket,
+         SIO_GET_EXTENSION_FUNCTION_POINTER,
+         &receive_id, sizeof(receive_id),
+         &_receive_message, sizeof(_receive_message),
+         &bytes, nullptr, nullptr);
+   }
    if (SOCKET_ERROR == func_result)
    {
-      printf("ERROR, Server WSAEventSelect() failed with: %u\n", WSAGetLastError());
+      Log::Write<Log::LEVEL_ERROR>("%s packet info failed with: %u\n", _socket_name, WSAGetLastError());
       result &= false;
       return result;
    }
 
+   //
+   // 2. Sends to a group leave on the interface asked for, an IPv4 index
+   //    goes in network order where an interface's address would, and
+   //    come back to this host's own members if asked
+   if (_is_multicast)
+   {
+      interface_index = (AF_INET6 == _family) ? _multicast_interface : htonl(_multicast_interface);
+      func_result = setsockopt(_socket, level, (AF_INET6 == _family) ? IPV6_MULTICAST_IF : IP_MULTICAST_IF, (char*)&interface_index, sizeof(interface_index));
+      if (SOCKET_ERROR != func_result)
+      {
+         func_result = setsockopt(_socket, level, (AF_INET6 == _family) ? IPV6_MULTICAST_HOPS : IP_MULTICAST_TTL, (char*)&ttl, sizeof(ttl));
+      }
+      if (SOCKET_ERROR != func_result)
+      {
+         func_result = setsockopt(_socket, level, (AF_INET6 == _family) ? IPV6_MULTICAST_LOOP : IP_MULTICAST_LOOP, (char*)&is_loopback, sizeof(is_loopback));
+      }
+      if (SOCKET_ERROR == func_result)
+      {
+         Log::Write<Log::LEVEL_ERROR>("%s multicast options failed with: %u\n", _socket_name, WSAGetLastError());
+         result &= false;
+         return result;
+      }
+   }
+
+   //
+   // 3. Join the groups asked for before the socket was open, or again
+   //    after a reconnect, one that fails is logged and the rest still join
+   std::lock_guard<std::mutex> lock(_group_lock);
+   for (const Socket_Vars::Multicast_Group& group : *_groups.load(std::memory_order_acquire))
+   {
+      Set_Membership(group, true);
+   }
+
    return result;
-}  // END TCP_Client_Start()
+}  // END Configure_Multicast()
 
-//+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+    
-/// Opens the socket as UDP
 //+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+
-bool Universal_Socket::UDP_Socket_Start()
+/// Adds or drops _socket's membership of one group
+//+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+
+bool Universal_Socket::Set_Membership(const Socket_Vars::Multicast_Group& group, bool is_join)
 {
    bool result = true;
    int func_result;
+   ip_mreq request;
+   ipv6_mreq request6;
 
    //
-   // 1. Create a UDP socket
-   _socket = socket(AF_INET, SOCK_DGRAM, IPPROTO_UDP);
-   if (INVALID_SOCKET == _socket) {
-      printf("UDP %s socket() failed with: %u\n", _socket_name.c_str(), WSAGetLastError());
+   // 1. An IPv4 group is the last 4 bytes of its mapped key
+   if (AF_INET6 == _family)
+   {
+      memcpy(&request6.ipv6mr_multiaddr, group.key, sizeof(group.key));
+      request6.ipv6mr_interface = group.interface_index;
+      func_result = setsockopt(
+         _socket,
+         IPPROTO_IPV6,
+         is_join ? IPV6_ADD_MEMBERSHIP : IPV6_DROP_MEMBERSHIP,
+         (char*)&request6,
+         sizeof(request6));
+   }
+   else
+   {
+      memcpy(&request.imr_multiaddr.s_addr, &group.key[12], sizeof(request.imr_multiaddr.s_addr));
+      request.imr_interface.s_addr = htonl(group.interface_index);
+      func_result = setsockopt(
+         _socket,
+         IPPROTO_IP,
+         is_join ? IP_ADD_MEMBERSHIP : IP_DROP_MEMBERSHIP,
+         (char*)&request,
+         sizeof(request));
+   }
+   if (SOCKET_ERROR == func_result)
+   {
+      Log::Write<Log::LEVEL_ERROR>("%s %s group %u failed with: %u\n", _socket_name, is_join ? "join" : "leave", group.group, WSAGetLastError());
+      result &= false;
+   }
+
+   return result;
+}  // END Set_Membership()
+
+//+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+    
+/// Opens the socket as a shared memory link
+//+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+
+bool Universal_Socket::Shared_Memory_Start()
+{
+   bool result = true;
+
+   //
+   // 1. The stop event wakes the link's thread wherever it waits
+   if (nullptr == _channel_stop_event)
+   {
+      Log::Write<Log::LEVEL_ERROR>("ERROR, %s CreateEvent() failed with: %u\n", _socket_name, GetLastError());
+      result &= false;
+      return result;
+   }
+
+   //
+   // 2. Attaching may wait on the peer, so it is done on the link's own
+   //    thread, sends queued meanwhile go once it is connected
+   _is_channel_running.store(true, std::memory_order_release);
+   _channel_thread = std::thread(&Universal_Socket::Shared_Memory_Thread, this);
+   Log::Write<Log::LEVEL_INFO>("Shared Memory Socket %s: Attaching to %s...\n", _socket_name, _ip_address);
+
+   return result;
+}  // END Shared_Memory_Start()
+
+//+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+
+/// Receives on a shared memory link until the socket stops
+//+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+
+void Universal_Socket::Shared_Memory_Thread()
+{
+   Buffers::Buffer_View message;
+   HANDLE handles[3];
+   DWORD wait_result;
+   uint32_t spins;
+   bool is_peer_alive;
+   bool is_attached;
+
+   while (Attach_Channel())
+   {
+      //
+      // 1. Anything queued while the peer was away goes now
+      _is_socket_connected = true;
+      Log::Write<Log::LEVEL_INFO>("Shared Memory Socket %s: Connected...\n", _socket_name);
+      Socket_Vars::Schedule_Send(_event_handle_index);
+
+      //
+      // 2. Hand every message on, the peer is only checked before a read
+      //    so what it wrote before leaving is still handled
+      spins = 0;
+      is_peer_alive = true;
+      while (!_is_stopping.load(std::memory_order_acquire))
+      {
+         is_attached = is_peer_alive && _channel->Is_Peer_Attached();
+         if (_channel->Read(message))
+         {
+            _stats->Add(Stats::RECEIVE_CALLS);
+            _stats->Add(Stats::BYTES_RECEIVED, message.Size());
+            Handle_Message(message, nullptr, Socket_Vars::NO_CONNECTION);
+            spins = 0;
+            continue;
+         }
+         if (!is_attached)
+         {
+            break;
+         }
+         if (_channel->Is_Corrupt())
+         {
+            Log::Write<Log::LEVEL_ERROR>("%s Shared memory peer wrote a broken record, dropping it!\n", _socket_name);
+            break;
+         }
+
+         //
+         // 3. An empty ring is polled a while when spinning, then the
+         //    thread sleeps until the peer sees it asleep and sets the event
+         if (_is_spinning && Shared_Memory::SPIN_COUNT > spins)
+         {
+            spins++;
+            YieldProcessor();
+            continue;
+         }
+         spins = 0;
+         if (!_channel->Begin_Sleep())
+         {
+            continue;
+         }
+         handles[0] = _channel->Get_Data_Event();
+         handles[1] = _channel_stop_event;
+         handles[2] = _channel->Get_Peer_Process();
+         wait_result = WaitForMultipleObjects(3, handles, FALSE, INFINITE);
+         _channel->End_Sleep();
+         if (WAIT_OBJECT_0 + 2 == wait_result)
+         {
+            is_peer_alive = false;
+         }
+      }
+
+      //
+      // 4. The peer left, a server keeps its mapping for the next client,
+      //    a client lets go of it and looks for a server again, a server
+      //    dropping a broken client waits for it to let go first
+      if (Socket_Vars::SERVER == _connection && _channel->Is_Corrupt())
+      {
+         _channel->Drop_Peer();
+         while (is_peer_alive && _channel->Is_Peer_Attached() && !_is_stopping.load(std::memory_order_acquire))
+         {
+            handles[0] = _channel->Get_Data_Event();
+            handles[1] = _channel_stop_event;
+            handles[2] = _channel->Get_Peer_Process();
+            if (WAIT_OBJECT_0 + 2 == WaitForMultipleObjects(3, handles, FALSE, INFINITE))
+            {
+               is_peer_alive = false;
+            }
+         }
+      }
+      {
+         std::lock_guard<std::mutex> lock(_channel_lock);
+         _is_socket_connected = false;
+         if (Socket_Vars::SERVER == _connection)
+         {
+            _channel->Release_Peer();
+         }
+         else
+         {
+            _channel.reset();
+         }
+      }
+      if (_is_stopping.load(std::memory_order_acquire))
+      {
+         break;
+      }
+      Log::Write<Log::LEVEL_INFO>("%s Shared memory peer left!\n", _socket_name);
+      _stats->Add(Stats::RECONNECTS);
+   }
+
+   _is_channel_running.store(false, std::memory_order_release);
+}  // END Shared_Memory_Thread()
+
+//+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+
+/// Makes the channel and waits for its peer
+//+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+
+bool Universal_Socket::Attach_Channel()
+{
+   std::unique_ptr<Shared_Memory::Channel> channel;
+   HANDLE handles[2];
+   uint32_t attempts = 0;
+   uint32_t delay;
+
+   while (!_is_stopping.load(std::memory_order_acquire))
+   {
+      //
+      // 1. Make or open the mapping, the sending thread only sees it once
+      //    it is whole
+      if (nullptr == _channel)
+      {
+         channel.reset(new Shared_Memory::Channel());
+         if (channel->Open(_ip_address, Socket_Vars::SERVER == _connection, _event_handle_index, Socket_Vars::Get_Event_Loop(_event_handle_index)))
+         {
+            std::lock_guard<std::mutex> lock(_channel_lock);
+            _channel = std::move(channel);
+         }
+         channel.reset();
+      }
+
+      //
+      // 2. An opened client is attached, a server once a client claimed it,
+      //    a new generation drops any backlog left for the last peer
+      if (nullptr != _channel && (Socket_Vars::CLIENT == _connection || _channel->Accept_Peer()))
+      {
+         _channel_generation.fetch_add(1, std::memory_order_acq_rel);
+         return true;
+      }
+
+      //
+      // 3. A server sleeps until a client sets its data event on claiming
+      //    it, a client without a server backs off the way reconnects do
+      if (nullptr != _channel)
+      {
+         handles[0] = _channel->Get_Data_Event();
+         handles[1] = _channel_stop_event;
+         WaitForMultipleObjects(2, handles, FALSE, INFINITE);
+         continue;
+      }
+      delay = _reconnect_max_delay;
+      if (attempts < 31 && (_reconnect_max_delay >> attempts) >= _reconnect_base_delay)
+      {
+         delay = _reconnect_base_delay << attempts;
+      }
+      delay = (delay / 2) + static_cast<uint32_t>(_jitter() % ((delay / 2) + 1));
+      attempts++;
+      WaitForSingleObject(_channel_stop_event, delay);
+   }
+
+   return false;
+}  // END Attach_Channel()
+
+//+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+
+/// Copies a batch into the shared memory ring
+//+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+
+bool Universal_Socket::Send_Shared(uint64_t generation, Buffers::Buffer_View* messages, size_t count, Socket_Vars::Send_Backlog& backlog)
+{
+   bool result = true;
+   std::lock_guard<std::mutex> lock(_channel_lock);
+
+   //
+   // 1. Nothing is written for a peer that left, the next one starts clean
+   if (nullptr == _channel || _channel_generation.load(std::memory_order_acquire) != generation || !_channel->Is_Peer_Attached())
+   {
+      Log::Write<Log::LEVEL_WARNING>("%s Send() shared memory peer left, %zu messages dropped!\n", _socket_name, count);
+      _stats->Add(Stats::MESSAGES_DROPPED, count);
+      return result;
+   }
+
+   //
+   // 2. Each message is one record, those a full ring refuses wait in the
+   //    backlog until the reader's space event schedules the socket again
+   for (size_t i = 0; i < count; i++)
+   {
+      if (Shared_Memory::MAX_MESSAGE_SIZE < messages[i].Size())
+      {
+         Log::Write<Log::LEVEL_WARNING>("%s Send() message of %zu bytes is over the shared memory limit!\n", _socket_name, messages[i].Size());
+         result &= false;
+         continue;
+      }
+      if (!_channel->Write(messages[i].Data(), static_cast<uint32_t>(messages[i].Size())))
+      {
+         _stats->Add(Stats::WOULD_BLOCKS);
+         backlog.generation = generation;
+         backlog.messages.insert(backlog.messages.end(), std::make_move_iterator(messages + i), std::make_move_iterator(messages + count));
+         break;
+      }
+      _stats->Add(Stats::MESSAGES_SENT);
+      _stats->Add(Stats::BYTES_SENT, messages[i].Size());
+   }
+
+   return result;
+}  // END Send_Shared()
+
+//+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+
+/// Accepts every pending client into the connection table
+//+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+
+bool Universal_Socket::Accept_Connections()
+{
+   bool result = true;
+   SOCKET accepted;
+   uint32_t connection;
+   uint16_t loop;
+   uint16_t accepting_loop = Socket_Vars::Get_Event_Loop(_event_handle_index);
+
+   while (true)
+   {
+      //
+      // 1. Accept the next client, the listen socket is non-blocking
+      //    so an empty backlog ends the loop
+      accepted = accept(_listen_socket, nullptr, nullptr);
+      if (INVALID_SOCKET == accepted)
+      {
+         if (WSAEWOULDBLOCK != WSAGetLastError())
+         {
+            Log::Write<Log::LEVEL_ERROR>("%s accept() failed with: %u!\n", _socket_name, WSAGetLastError());
+            result &= false;
+         }
+         break;
+      }
+
+      //
+      // 2. Drop the event select inherited from the listen socket,
+      //    connections are polled directly by the event loop
+      WSAEventSelect(accepted, nullptr, 0);
+
+      //
+      // 3. Give the client its own slot in the connection table, owned by
+      //    the next event loop in turn
+      loop = _next_loop;
+      _next_loop = static_cast<uint16_t>((_next_loop + 1) % Socket_Vars::event_loop_count);
+      connection = _connections->Add(accepted, loop);
+      if (Socket_Vars::NO_CONNECTION == connection)
+      {
+         Log::Write<Log::LEVEL_WARNING>("%s connection table is full, client refused!\n", _socket_name);
+         closesocket(accepted);
+         result &= false;
+         break;
+      }
+      _connections->Get_Queues(connection).decoder.Configure(_framing, _max_frame_size);
+      _stats->Add(Stats::ACCEPTS);
+      if (_context->is_async)
+      {
+         Post_Connection_Event(connection, Socket_Vars::CONNECTION_OPENED);
+      }
+      if (Socket_Vars::print_messages)
+      {
+         Log::Write<Log::LEVEL_INFO>("%s accept() succeeded! Connection %u\n", _socket_name, connection);
+      }
+
+      //
+      // 4. Hand it to its loop, another loop is woken so it starts
+      //    polling the client without waiting on its other sockets
+      _connections->Hand_Off(connection);
+      if (accepting_loop != loop)
+      {
+         Socket_Vars::Wake_Event_Loop(loop);
+      }
+   }
+
+   //
+   // 5. Anything queued while no client was connected can go now
+   Socket_Vars::Schedule_Send(_event_handle_index);
+
+   return result;
+}  // END Accept_Connections()
+
+//+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+
+/// Gets the size of the address a SOCKADDR_INET holds
+//+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+
+static inline int Address_Size(const SOCKADDR_INET& address)
+{
+   return (AF_INET6 == address.si_family) ? sizeof(SOCKADDR_IN6) : sizeof(SOCKADDR_IN);
+}  // END Address_Size()
+
+//+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+
+/// Sends one datagram over the given socket to the given address
+//+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+
+bool Universal_Socket::Send_Datagram(SOCKET socket, const SOCKADDR_INET& destination, const char* buffer, size_t length)
+{
+   bool result = true;
+   int buffer_length = static_cast<int>(length);
+   int bytes_sent;
+
+   //
+   // 1. A datagram goes out whole or not at all
+   bytes_sent = sendto(socket, buffer, buffer_length, 0, (const SOCKADDR*)&destination, Address_Size(destination));
+   _stats->Add(Stats::SEND_CALLS);
+   if (bytes_sent != buffer_length)
+   {
+      _stats->Add((WSAEWOULDBLOCK == WSAGetLastError()) ? Stats::WOULD_BLOCKS : Stats::MESSAGES_DROPPED);
       result &= false;
       return result;
    }
+   _stats->Add(Stats::BYTES_SENT, static_cast<uint64_t>(bytes_sent));
+   _stats->Add(Stats::MESSAGES_SENT);
+
+   return result;
+}  // END Send_Datagram()
+
+//+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+
+/// Completion routine of a zero-copy send, runs on the sending
+/// thread that started it once that thread waits alertable, lets
+/// go of the message and schedules the socket to move its backlog on
+//+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+
+static void CALLBACK Zero_Copy_Completed(DWORD error, DWORD bytes_sent, LPWSAOVERLAPPED overlapped, DWORD flags)
+{
+   Socket_Vars::Zero_Copy_Send* send = static_cast<Socket_Vars::Zero_Copy_Send*>(overlapped->hEvent);
+   std::shared_ptr<Socket_Vars::Zero_Copy_Send> keep_alive = std::move(send->self);
+
+   //
+   // 1. The backlog reaps it on the next pass, or it goes with keep_alive
+   //    when its socket was closed meanwhile
+   send->error = error;
+   send->bytes_sent = bytes_sent;
+   send->is_complete = true;
+   Socket_Vars::Schedule_Send(send->socket_index, send->loop);
+}  // END Zero_Copy_Completed()
+
+//+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+
+/// Sends a batch of messages over the given socket
+//+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+
+bool Universal_Socket::Send_Batch(SOCKET socket, Buffers::Buffer_View* messages, size_t count, Socket_Vars::Send_Backlog& backlog)
+{
+   bool result = true;
+   DWORD buffer_count = 0;
+   char headers[Socket_Vars::SEND_BATCH_SIZE][Framing::MAX_HEADER_SIZE];
+   WSABUF buffers[2 * Socket_Vars::SEND_BATCH_SIZE];
+   bool is_framed = (Framing::NONE != _framing);
+   bool is_zero_copy = _is_zero_copy && nullptr == _connections;
+
+   //
+   // 1. Shared memory messages are records of their own, copied into the
+   //    ring of the peer attached now rather than written to a socket
+   if (Socket_Vars::SHARED_MEMORY == _protocol)
+   {
+      return Send_Shared(_channel_generation.load(std::memory_order_acquire), messages, count, backlog);
+   }
+
+   //
+   // 2. A zero-copy client has no send buffer, a message not sent
+   //    overlapped would wait on the peer's ACK before the next could go
+   if (is_zero_copy)
+   {
+      return Send_Zero_Copy(socket, messages, count, backlog);
+   }
+
+   //
+   // 3. Gather every message, and its prefix when framed, into one buffer list
+   for (size_t i = 0; i < count; i++)
+   {
+      if (is_framed && _max_frame_size < messages[i].Size())
+      {
+         Log::Write<Log::LEVEL_WARNING>("%s Send() message of %zu bytes is over the max frame size!\n", _socket_name, messages[i].Size());
+         result &= false;
+         continue;
+      }
+      if (backlog.Is_Empty())
+      {
+         if (is_framed)
+         {
+            buffers[buffer_count].buf = headers[i];
+            buffers[buffer_count].len = Framing::Encode_Header(_framing, static_cast<uint32_t>(messages[i].Size()), headers[i]);
+            buffer_count++;
+         }
+         buffers[buffer_count].buf = const_cast<char*>(messages[i].Data());
+         buffers[buffer_count].len = static_cast<ULONG>(messages[i].Size());
+         buffer_count++;
+         _stats->Add(Stats::MESSAGES_SENT);
+         continue;
+      }
+
+      // Behind a full socket buffer, the rest waits in the backlog in the
+      // order it was queued
+      backlog.socket = socket;
+      backlog.messages.insert(backlog.messages.end(), std::make_move_iterator(messages + i), std::make_move_iterator(messages + count));
+      break;
+   }
+
+   //
+   // 4. Whatever was gathered goes in one write
+   result &= Write_Buffers(socket, buffers, buffer_count, backlog);
+
+   return result;
+}  // END Send_Batch()
+
+//+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+
+/// Writes gathered buffers, the rest goes to the backlog
+//+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+
+bool Universal_Socket::Write_Buffers(SOCKET socket, WSABUF* buffers, DWORD buffer_count, Socket_Vars::Send_Backlog& backlog)
+{
+   bool result = true;
+   int func_result;
+   DWORD bytes_sent;
+   DWORD first_buffer = 0;
+
+   //
+   // 1. Write until every buffer has gone, a partial write resumes at the
+   //    buffer and offset where it stopped, whatever a full socket buffer
+   //    leaves is copied to the backlog rather than waited on
+   while (first_buffer < buffer_count)
+   {
+      func_result = WSASend(socket, &buffers[first_buffer], buffer_count - first_buffer, &bytes_sent, 0, nullptr, nullptr);
+      _stats->Add(Stats::SEND_CALLS);
+      if (SOCKET_ERROR == func_result)
+      {
+         if (WSAEWOULDBLOCK == WSAGetLastError())
+         {
+            _stats->Add(Stats::WOULD_BLOCKS);
+            backlog.socket = socket;
+            for (DWORD i = first_buffer; i < buffer_count; i++)
+            {
+               backlog.stream.append(buffers[i].buf, buffers[i].len);
+            }
+            break;
+         }
+         Log::Write<Log::LEVEL_ERROR>("%s Send() failed with error: %u\n", _socket_name, WSAGetLastError());
+         result &= false;
+         break;
+      }
+
+      // Skip the buffers sent in full, then trim the one sent in part
+      _stats->Add(Stats::BYTES_SENT, bytes_sent);
+      while (first_buffer < buffer_count && bytes_sent >= buffers[first_buffer].len)
+      {
+         bytes_sent -= buffers[first_buffer].len;
+         first_buffer++;
+      }
+      if (first_buffer < buffer_count)
+      {
+         buffers[first_buffer].buf += bytes_sent;
+         buffers[first_buffer].len -= bytes_sent;
+         _stats->Add(Stats::PARTIAL_WRITES);
+      }
+   }
+
+   return result;
+}  // END Write_Buffers()
+
+//+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+
+/// Writes a batch of broadcasts from their shared buffers
+//+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+
+bool Universal_Socket::Send_Broadcasts(SOCKET socket, Buffers::Buffer_View* broadcasts, size_t count, Socket_Vars::Send_Backlog& backlog)
+{
+   bool result = true;
+   WSABUF buffers[Socket_Vars::SEND_BATCH_SIZE];
+
+   //
+   // 1. Each broadcast was framed when queued, the write gathers straight
+   //    from the buffers the other subscribers share
+   for (size_t i = 0; i < count; i++)
+   {
+      buffers[i].buf = const_cast<char*>(broadcasts[i].Data());
+      buffers[i].len = static_cast<ULONG>(broadcasts[i].Size());
+   }
+   _stats->Add(Stats::MESSAGES_SENT, count);
+
+   //
+   // 2. One write for the batch, a full socket buffer copies what is left
+   //    to the backlog, so this connection's references go either way
+   result &= Write_Buffers(socket, buffers, static_cast<DWORD>(count), backlog);
+   for (size_t i = 0; i < count; i++)
+   {
+      broadcasts[i].Reset();
+   }
+
+   return result;
+}  // END Send_Broadcasts()
+
+//+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+
+/// Starts overlapped sends straight from the messages, a long
+/// message goes on its own, short ones are gathered several to
+/// a send, as many sends as there is room for in flight
+//+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+
+bool Universal_Socket::Send_Zero_Copy(SOCKET socket, Buffers::Buffer_View* messages, size_t count, Socket_Vars::Send_Backlog& backlog)
+{
+   bool result = true;
+   int func_result;
+   bool is_framed = (Framing::NONE != _framing);
+   bool is_long;
+   DWORD buffer_count;
+   size_t next = 0;
+   std::shared_ptr<Socket_Vars::Zero_Copy_Send> send;
+
+   while (next < count && Socket_Vars::ZERO_COPY_MAX_IN_FLIGHT > backlog.zero_copy.size())
+   {
+      //
+      // 1. Move the next messages, and their prefixes when framed, into a
+      //    send of their own memory, it holds itself until its completion
+      //    routine runs
+      send = std::make_shared<Socket_Vars::Zero_Copy_Send>();
+      buffer_count = 0;
+      while (next < count && Socket_Vars::ZERO_COPY_GATHER > send->message_count)
+      {
+         if (is_framed && _max_frame_size < messages[next].Size())
+         {
+            Log::Write<Log::LEVEL_WARNING>("%s Send() message of %zu bytes is over the max frame size!\n", _socket_name, messages[next].Size());
+            result &= false;
+            messages[next++].Reset();
+            continue;
+         }
+         is_long = (_zero_copy_threshold <= messages[next].Size());
+         if (is_long && 0 < send->message_count)
+         {
+            break;
+         }
+         Buffers::Buffer_View& message = send->messages[send->message_count];
+         message = std::move(messages[next++]);
+         if (is_framed)
+         {
+            send->buffers[buffer_count].buf = send->headers[send->message_count];
+            send->buffers[buffer_count].len = Framing::Encode_Header(_framing, static_cast<uint32_t>(message.Size()), send->headers[send->message_count]);
+            buffer_count++;
+         }
+         send->buffers[buffer_count].buf = const_cast<char*>(message.Data());
+         send->buffers[buffer_count].len = static_cast<ULONG>(message.Size());
+         buffer_count++;
+         send->message_count++;
+         if (is_long)
+         {
+            break;
+         }
+      }
+      if (0 == send->message_count)
+      {
+         continue;
+      }
+      memset(&send->overlapped, 0, sizeof(send->overlapped));
+      send->overlapped.hEvent = send.get();
+      send->socket_index = _event_handle_index;
+      send->loop = Socket_Vars::Get_Event_Loop(_event_handle_index);
+      send->self = send;
+
+      //
+      // 2. Pending or done at once, the completion routine runs either way,
+      //    a refused send hands its messages back ahead of the rest
+      func_result = WSASend(socket, send->buffers, buffer_count, nullptr, 0, &send->overlapped, Zero_Copy_Completed);
+      _stats->Add(Stats::SEND_CALLS);
+      if (SOCKET_ERROR == func_result && WSA_IO_PENDING != WSAGetLastError())
+      {
+         send->self.reset();
+         if (WSAEWOULDBLOCK != WSAGetLastError())
+         {
+            Log::Write<Log::LEVEL_ERROR>("%s Send() zero-copy failed with error: %u\n", _socket_name, WSAGetLastError());
+            result &= false;
+            continue;
+         }
+         _stats->Add(Stats::WOULD_BLOCKS);
+         backlog.socket = socket;
+         backlog.messages.insert(
+            backlog.messages.end(),
+            std::make_move_iterator(send->messages),
+            std::make_move_iterator(send->messages + send->message_count));
+         break;
+      }
+      _stats->Add(Stats::MESSAGES_SENT, send->message_count);
+      backlog.socket = socket;
+      backlog.zero_copy.push_back(std::move(send));
+   }
+
+   //
+   // 3. What found no room in flight waits in the backlog in the order it
+   //    was queued, the next completion sends it
+   if (next < count)
+   {
+      backlog.socket = socket;
+      backlog.messages.insert(backlog.messages.end(), std::make_move_iterator(messages + next), std::make_move_iterator(messages + count));
+   }
+
+   return result;
+}  // END Send_Zero_Copy()
+
+//+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+
+/// Thread pool wait callback of a file's overlapped event, only
+/// schedules the socket, its sending thread reaps the chunk
+//+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+
+static void CALLBACK File_Chunk_Completed(PVOID context, BOOLEAN timed_out)
+{
+   Socket_Vars::File_Send* file = static_cast<Socket_Vars::File_Send*>(context);
+
+   Socket_Vars::Schedule_Send(file->socket_index, file->loop);
+}  // END File_Chunk_Completed()
+
+//+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+
+/// Starts the next chunk of the backlog's file
+//+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+
+bool Universal_Socket::Send_File_Chunk(SOCKET socket, Socket_Vars::Send_Backlog& backlog)
+{
+   bool result = true;
+   DWORD error;
+   Socket_Vars::File_Send& file = *backlog.file;
+   TRANSMIT_FILE_BUFFERS head{};
+   uint64_t remaining = file.end - file.offset;
+
+   //
+   // 1. The chunk starts where the last one ended, the frame prefix goes
+   //    ahead of the first one in the same call
+   file.chunk_size = (Socket_Vars::FILE_CHUNK_SIZE < remaining) ? Socket_Vars::FILE_CHUNK_SIZE : static_cast<DWORD>(remaining);
+   file.overlapped.Internal = 0;
+   file.overlapped.InternalHigh = 0;
+   file.overlapped.Offset = static_cast<DWORD>(file.offset);
+   file.overlapped.OffsetHigh = static_cast<DWORD>(file.offset >> 32);
+   file.socket = socket;
+   head.Head = file.header;
+   head.HeadLength = file.header_size;
+
+   //
+   // 2. The kernel reads the file into the socket, the registered wait
+   //    schedules the socket once the chunk is done
+   _stats->Add(Stats::SEND_CALLS);
+   if (!TransmitFile(socket, file.file, file.chunk_size, 0, &file.overlapped, (0 < file.header_size) ? &head : nullptr, 0))
+   {
+      error = WSAGetLastError();
+      if (WSA_IO_PENDING != error)
+      {
+         Log::Write<Log::LEVEL_ERROR>("%s TransmitFile() failed with error: %u\n", _socket_name, error);
+         if (nullptr != file.handler)
+         {
+            file.handler(file.socket_index, file.bytes_sent, file.total_bytes, error);
+         }
+         backlog.file.reset();
+         result &= false;
+         return result;
+      }
+   }
+   file.is_pending = true;
+   backlog.socket = socket;
+
+   return result;
+}  // END Send_File_Chunk()
+
+//+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+
+/// Writes what a full socket buffer left
+//+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+
+bool Universal_Socket::Flush_Backlog(SOCKET socket, Socket_Vars::Send_Backlog& backlog)
+{
+   bool result = true;
+   int bytes_sent;
+   DWORD bytes_done = 0;
+   DWORD flags;
+   DWORD error;
+   std::vector<Buffers::Buffer_View> messages;
+   std::vector<Socket_Vars::Queued_Send> datagrams;
+
+   //
+   // 1. A backlog meant for a socket since closed, or a shared memory peer
+   //    since gone, would corrupt the stream of the one that replaced it
+   if ((Socket_Vars::SHARED_MEMORY == _protocol)
+       ? (backlog.generation != _channel_generation.load(std::memory_order_acquire))
+       : (backlog.socket != socket))
+   {
+      Log::Write<Log::LEVEL_WARNING>("%s Send() socket was replaced, unsent backlog dropped!\n", _socket_name);
+      if (nullptr != backlog.file && nullptr != backlog.file->handler)
+      {
+         backlog.file->handler(backlog.file->socket_index, backlog.file->bytes_sent, backlog.file->total_bytes, WSAECONNRESET);
+      }
+      backlog.Clear();
+      return result;
+   }
+
+   //
+   // 2. Stream bytes are written from where the last write stopped
+   while (backlog.offset < backlog.stream.size())
+   {
+      bytes_sent = send(
+         socket,
+         backlog.stream.data() + backlog.offset,
+         static_cast<int>(backlog.stream.size() - backlog.offset),
+         0);
+      _stats->Add(Stats::SEND_CALLS);
+      if (SOCKET_ERROR == bytes_sent)
+      {
+         if (WSAEWOULDBLOCK == WSAGetLastError())
+         {
+            _stats->Add(Stats::WOULD_BLOCKS);
+            return result;
+         }
+         Log::Write<Log::LEVEL_ERROR>("%s Send() failed with error: %u\n", _socket_name, WSAGetLastError());
+         result &= false;
+         backlog.Clear();
+         return result;
+      }
+      backlog.offset += static_cast<size_t>(bytes_sent);
+      _stats->Add(Stats::BYTES_SENT, static_cast<uint64_t>(bytes_sent));
+   }
+   backlog.stream.clear();
+   backlog.offset = 0;
+
+   //
+   // 3. Zero-copy sends are let go of in the order they went out, once
+   //    their completion routine has run, messages behind them go out as
+   //    soon as there is room for another send in flight
+   while (!backlog.zero_copy.empty() && backlog.zero_copy.front()->is_complete)
+   {
+      if (0 != backlog.zero_copy.front()->error)
+      {
+         Log::Write<Log::LEVEL_ERROR>("%s Send() zero-copy completed with error: %u\n", _socket_name, backlog.zero_copy.front()->error);
+         result &= false;
+      }
+      _stats->Add(Stats::BYTES_SENT, backlog.zero_copy.front()->bytes_sent);
+      backlog.zero_copy.erase(backlog.zero_copy.begin());
+   }
+   if (!backlog.zero_copy.empty()
+       && (nullptr != backlog.file
+       || Socket_Vars::ZERO_COPY_MAX_IN_FLIGHT <= backlog.zero_copy.size()))
+   {
+      return result;
+   }
+
+   //
+   // 4. A file holds the backlog until its last chunk is done, each done
+   //    chunk is reported and the next one started
+   if (nullptr != backlog.file)
+   {
+      Socket_Vars::File_Send& file = *backlog.file;
+      error = 0;
+      if (file.is_pending)
+      {
+         if (!WSAGetOverlappedResult(socket, &file.overlapped, &bytes_done, FALSE, &flags))
+         {
+            error = WSAGetLastError();
+            if (WSA_IO_INCOMPLETE == error)
+            {
+               return result;
+            }
+         }
+         file.is_pending = false;
+      }
+      if (0 == error)
+      {
+         _stats->Add(Stats::BYTES_SENT, bytes_done);
+         file.offset += file.chunk_size;
+         file.bytes_sent += file.chunk_size;
+         file.header_size = 0;
+      }
+      else
+      {
+         Log::Write<Log::LEVEL_ERROR>("%s TransmitFile() completed with error: %u\n", _socket_name, error);
+         result &= false;
+      }
+      if (nullptr != file.handler)
+      {
+         file.handler(file.socket_index, file.bytes_sent, file.total_bytes, error);
+      }
+      if (0 != error)
+      {
+         backlog.file.reset();
+      }
+      else if (file.offset == file.end)
+      {
+         _stats->Add(Stats::MESSAGES_SENT);
+         backlog.file.reset();
+      }
+      else
+      {
+         result &= Send_File_Chunk(socket, backlog);
+         return result;
+      }
+   }
+
+   //
+   // 5. Messages go out as a batch again, what still does not fit
+   //    goes back in the backlog
+   if (!backlog.messages.empty())
+   {
+      messages.swap(backlog.messages);
+      result &= Send_Batch(socket, messages.data(), messages.size(), backlog);
+   }
+   else if (!backlog.datagrams.empty())
+   {
+      datagrams.swap(backlog.datagrams);
+      result &= Send_Datagrams(socket, datagrams.data(), datagrams.size(), backlog);
+   }
+
+   return result;
+}  // END Flush_Backlog()
+
+//+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+
+/// Has the event loop poll a socket with a backlog for writable
+//+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+
+void Universal_Socket::Wait_For_Writable(std::atomic<bool>& is_waiting_writable, uint16_t loop)
+{
+   //
+   // 1. The flag is set after the backlog, so the loop that sees it and
+   //    schedules the send always finds the backlog to write
+   is_waiting_writable.store(true, std::memory_order_release);
+   Socket_Vars::Wake_Event_Loop(loop);
+}  // END Wait_For_Writable()
+
+//+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+
+/// Drains up to a batch of datagrams from _socket
+//+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+
+bool Universal_Socket::Receive_Datagrams()
+{
+   bool result = true;
+   int bytes_received;
+   int sender_size;
+   int error;
+   size_t count = 0;
+
+   //
+   // 1. Drain datagrams until the socket is empty or the batch is full,
+   //    Winsock has no recvmmsg so every datagram is still its own call
+   //    but one wakeup and dispatch covers the batch
+   while (count < _udp_batch_size)
+   {
+      //
+      // 1a. Datagrams are packed one after another into the current pooled
+      //     buffer, a new one is taken when the next may not fit
+      if (_datagram_buffer.Get_Capacity() - _datagram_used < Socket_Vars::UDP_SLOT_SIZE)
+      {
+         _datagram_buffer = Buffers::Receive_Pool().Acquire(Socket_Vars::UDP_SLOT_SIZE);
+         _datagram_used = 0;
+      }
+
+      sender_size = sizeof(SOCKADDR_INET);
+      bytes_received = recvfrom(
+         _socket,
+         _datagram_buffer.Get_Buffer() + _datagram_used,
+         static_cast<int>(Socket_Vars::UDP_SLOT_SIZE),
+         0,
+         (SOCKADDR*)&_datagram_senders[count],
+         &sender_size);
+      _stats->Add(Stats::RECEIVE_CALLS);
+      if (SOCKET_ERROR == bytes_received)
+      {
+         error = WSAGetLastError();
+         if (WSAEMSGSIZE == error)
+         {
+            Log::Write<Log::LEVEL_WARNING>("%s Receive() datagram over %zu bytes dropped!\n", _socket_name, Socket_Vars::UDP_SLOT_SIZE);
+            continue;
+         }
+         if (WSAEWOULDBLOCK != error)
+         {
+            Log::Write<Log::LEVEL_ERROR>("%s Receive() failed with: %d\n", _socket_name, error);
+            result &= false;
+         }
+         break;
+      }
+      _datagrams[count] = _datagram_buffer.Slice(_datagram_used, static_cast<size_t>(bytes_received));
+      _stats->Add(Stats::BYTES_RECEIVED, static_cast<uint64_t>(bytes_received));
+      _datagram_used += static_cast<size_t>(bytes_received);
+      count++;
+   }
+
+   //
+   // 2. Hand every datagram up with its own sender, the views queued keep
+   //    the buffer out of the pool until they are released
+   for (size_t i = 0; i < count; i++)
+   {
+      Handle_Message(_datagrams[i], &_datagram_senders[i]);
+      _datagrams[i].Reset();
+   }
+
+   //
+   // 3. Nothing handed out still views the buffer, fill it again from the front
+   if (_datagram_buffer.Is_Unique())
+   {
+      _datagram_used = 0;
+   }
+
+   return result;
+}  // END Receive_Datagrams()
+
+//+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+
+/// Drains up to a batch of datagrams, each with its group
+//+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+
+bool Universal_Socket::Receive_Group_Datagrams()
+{
+   bool result = true;
+   int func_result;
+   int error;
+   DWORD bytes_received;
+   size_t count = 0;
+   size_t last_hit = 0;
+   uint32_t group;
+   uint8_t key[sizeof(Socket_Vars::Multicast_Group::key)];
+   SOCKADDR_INET sender;
+   WSABUF buffer;
+   WSAMSG message;
+   WSACMSGHDR* control_header;
+   IN_PKTINFO packet_info;
+   IN6_PKTINFO packet_info6;
+   union
+   {
+      WSACMSGHDR header;
+      char buffer[WSA_CMSG_SPACE(sizeof(IN6_PKTINFO))];
+   } control;
+   Buffers::Buffer_View datagram;
+
+   //
+   // 1. One snapshot of the joined groups covers the batch, a join or
+   //    leave made meanwhile is seen from the next wakeup
+   std::shared_ptr<const Socket_Vars::Multicast_Groups> groups = _groups.load(std::memory_order_acquire);
+
+   //
+   // 2. Drain datagrams until the socket is empty or the batch is full,
+   //    Winsock has no recvmmsg so every datagram is its own call
+   while (count < _udp_batch_size)
+   {
+      //
+      // 2a. Datagrams are packed one after another into the current pooled
+      //     buffer, a new one is taken when the next may not fit
+      if (_datagram_buffer.Get_Capacity() - _datagram_used < Socket_Vars::UDP_SLOT_SIZE)
+      {
+         _datagram_buffer = Buffers::Receive_Pool().Acquire(Socket_Vars::UDP_SLOT_SIZE);
+         _datagram_used = 0;
+      }
+
+      buffer.buf = _datagram_buffer.Get_Buffer() + _datagram_used;
+      buffer.len = static_cast<ULONG>(Socket_Vars::UDP_SLOT_SIZE);
+      memset(&message, 0, sizeof(message));
+      message.name = (LPSOCKADDR)&sender;
+      message.namelen = sizeof(sender);
+      message.lpBuffers = &buffer;
+      message.dwBufferCount = 1;
+      message.Control.buf = control.buffer;
+      message.Control.len = sizeof(control.buffer);
+      func_result = _receive_message(_socket, &message, &bytes_received, nullptr, nullptr);
+      _stats->Add(Stats::RECEIVE_CALLS);
+      if (SOCKET_ERROR == func_result)
+      {
+         error = WSAGetLastError();
+         if (WSAEMSGSIZE == error)
+         {
+            Log::Write<Log::LEVEL_WARNING>("%s Receive() datagram over %zu bytes dropped!\n", _socket_name, Socket_Vars::UDP_SLOT_SIZE);
+            continue;
+         }
+         if (WSAEWOULDBLOCK != error)
+         {
+            Log::Write<Log::LEVEL_ERROR>("%s Receive() failed with: %d\n", _socket_name, error);
+            result &= false;
+         }
+         break;
+      }
+
+      //
+      // 2b. The destination address says which group it arrived on, an
+      //     IPv4 destination is mapped the way its group's key was
+      group = Socket_Vars::NO_GROUP;
+      for (control_header = WSA_CMSG_FIRSTHDR(&message); nullptr != control_header && !groups->empty();
+           control_header = WSA_CMSG_NXTHDR(&message, control_header))
+      {
+         if (IPPROTO_IP == control_header->cmsg_level && IP_PKTINFO == control_header->cmsg_type)
+         {
+            memcpy(&packet_info, WSA_CMSG_DATA(control_header), sizeof(packet_info));
+            memset(key, 0, sizeof(key));
+            key[10] = 0xFF;
+            key[11] = 0xFF;
+            memcpy(&key[12], &packet_info.ipi_addr, sizeof(packet_info.ipi_addr));
+            group = Socket_Vars::Find_Group(*groups, key, last_hit);
+         }
+         else if (IPPROTO_IPV6 == control_header->cmsg_level && IPV6_PKTINFO == control_header->cmsg_type)
+         {
+            memcpy(&packet_info6, WSA_CMSG_DATA(control_header), sizeof(packet_info6));
+            group = Socket_Vars::Find_Group(*groups, (const uint8_t*)&packet_info6.ipi6_addr, last_hit);
+         }
+      }
+
+      datagram = _datagram_buffer.Slice(_datagram_used, static_cast<size_t>(bytes_received));
+      _stats->Add(Stats::BYTES_RECEIVED, static_cast<uint64_t>(bytes_received));
+      _datagram_used += static_cast<size_t>(bytes_received);
+      count++;
+
+      //
+      // 2c. A unicast socket's handler replies to the datagram's sender, a
+      //     socket whose address is a group keeps replying to the group
+      Handle_Message(datagram, _is_multicast ? nullptr : &sender, Socket_Vars::NO_CONNECTION, group);
+      datagram.Reset();
+   }
+
+   //
+   // 3. Nothing handed out still views the buffer, fill it again from the front
+   if (_datagram_buffer.Is_Unique())
+   {
+      _datagram_used = 0;
+   }
+
+   return result;
+}  // END Receive_Group_Datagrams()
+
+//+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+
+/// Sends a batch of datagrams, coalescing runs of the same size to
+/// the same destination
+//+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+
+bool Universal_Socket::Send_Datagrams(SOCKET socket, Socket_Vars::Queued_Send* datagrams, size_t count, Socket_Vars::Send_Backlog& backlog)
+{
+   bool result = true;
+   int func_result;
+   int error;
+   DWORD bytes_sent;
+   size_t first = 0;
+   size_t last;
+   size_t segment_size;
+   size_t total_size;
+   WSABUF buffers[Socket_Vars::SEND_BATCH_SIZE];
+   WSAMSG message;
+   WSACMSGHDR* control_header;
+   union
+   {
+      WSACMSGHDR header;
+      char buffer[WSA_CMSG_SPACE(sizeof(DWORD))];
+   } control;
+
+   while (first < count)
+   {
+      //
+      // 1. Take the run of messages the size of the first going to the same
+      //    destination, a shorter message may end the run as the stack's
+      //    last segment
+      const SOCKADDR_INET& destination = datagrams[first].destination;
+      segment_size = datagrams[first].message.Size();
+      total_size = 0;
+      last = first;
+      while (last < count
+             && 0 < datagrams[last].message.Size()
+             && datagrams[last].message.Size() <= segment_size
+             && total_size + datagrams[last].message.Size() <= Socket_Vars::UDP_COALESCE_LIMIT
+             && destination.si_family == datagrams[last].destination.si_family
+             && 0 == memcmp(&destination, &datagrams[last].destination, Address_Size(destination)))
+      {
+         buffers[last - first].buf = const_cast<char*>(datagrams[last].message.Data());
+         buffers[last - first].len = static_cast<ULONG>(datagrams[last].message.Size());
+         total_size += datagrams[last].message.Size();
+         last++;
+         if (datagrams[last - 1].message.Size() < segment_size)
+         {
+            break;
+         }
+      }
+
+      //
+      // 2. A run of one, a socket not batching datagrams, or a stack without
+      //    segmentation offload, sends every message as a plain datagram
+      if (1 >= last - first
+          || 1 >= _udp_batch_size
+          || !_is_send_segmentation_supported)
+      {
+         last = (last == first) ? first + 1 : last;
+         for (size_t i = first; i < last; i++)
+         {
+            if (Send_Datagram(socket, datagrams[i].destination, datagrams[i].message.Data(), datagrams[i].message.Size()))
+            {
+               continue;
+            }
+            if (WSAEWOULDBLOCK == WSAGetLastError())
+            {
+               backlog.socket = socket;
+               backlog.datagrams.assign(std::make_move_iterator(datagrams + i), std::make_move_iterator(datagrams + count));
+               return result;
+            }
+            Log::Write<Log::LEVEL_ERROR>("%s Send() failed with error: %u\n", _socket_name, WSAGetLastError());
+            result &= false;
+         }
+         first = last;
+         continue;
+      }
+
+      //
+      // 3. Send the run as one message the stack splits into segment_size
+      //    datagrams, the payload is gathered straight from the queue
+      memset(&message, 0, sizeof(message));
+      memset(&control, 0, sizeof(control));
+      message.name = reinterpret_cast<LPSOCKADDR>(const_cast<SOCKADDR_INET*>(&destination));
+      message.namelen = Address_Size(destination);
+      message.lpBuffers = buffers;
+      message.dwBufferCount = static_cast<ULONG>(last - first);
+      message.Control.buf = control.buffer;
+      message.Control.len = sizeof(control.buffer);
+      control_header = WSA_CMSG_FIRSTHDR(&message);
+      control_header->cmsg_level = IPPROTO_UDP;
+      control_header->cmsg_type = UDP_SEND_MSG_SIZE;
+      control_header->cmsg_len = WSA_CMSG_LEN(sizeof(DWORD));
+      *reinterpret_cast<DWORD*>(WSA_CMSG_DATA(control_header)) = static_cast<DWORD>(segment_size);
+
+      func_result = WSASendMsg(socket, &message, 0, &bytes_sent, nullptr, nullptr);
+      _stats->Add(Stats::SEND_CALLS);
+      if (SOCKET_ERROR == func_result)
+      {
+         error = WSAGetLastError();
+
+         //
+         // 3a. Older stacks reject the option, resend the run one datagram at a time
+         if (WSAEINVAL == error || WSAEOPNOTSUPP == error)
+         {
+            Log::Write<Log::LEVEL_WARNING>("%s UDP send segmentation unsupported, sending datagrams singly\n", _socket_name);
+            _is_send_segmentation_supported = false;
+            continue;
+         }
+         if (WSAEWOULDBLOCK == error)
+         {
+            _stats->Add(Stats::WOULD_BLOCKS);
+            backlog.socket = socket;
+            backlog.datagrams.assign(std::make_move_iterator(datagrams + first), std::make_move_iterator(datagrams + count));
+            return result;
+         }
+         Log::Write<Log::LEVEL_ERROR>("%s Send() failed with error: %d\n", _socket_name, error);
+         result &= false;
+      }
+      else
+      {
+         _stats->Add(Stats::BYTES_SENT, bytes_sent);
+         _stats->Add(Stats::MESSAGES_SENT, last - first);
+      }
+      first = last;
+   }
+
+   return result;
+}  // END Send_Datagrams()
+
+//+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+
+/// Reads what is waiting on the given socket into its decoder
+//+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+
+bool Universal_Socket::Receive_Frames(SOCKET socket, Framing::Frame_Decoder& decoder, uint32_t connection)
+{
+   bool result = true;
+   int bytes_received;
+   size_t space;
+   char* write_buffer;
+   Buffers::Buffer_View frame;
+   SOCKADDR_INET sender;
+   int sender_size = sizeof(sender);
+   Framing::Frame_Decoder::Result frame_result;
+
+   //
+   // 1. Read straight into the decoder's buffer, no staging copy
+   write_buffer = decoder.Get_Write_Buffer(space);
+   if (Socket_Vars::Is_Stream(_protocol))
+   {
+      bytes_received = recv(socket, write_buffer, static_cast<int>(space), 0);
+   }
+   else   // UDP
+   {
+      bytes_received = recvfrom(socket, write_buffer, static_cast<int>(space), 0, (SOCKADDR*)&sender, &sender_size);
+   }
+   _stats->Add(Stats::RECEIVE_CALLS);
+
+   if (0 == bytes_received)
+   {
+      Log::Write<Log::LEVEL_INFO>("%s Receive() 0 bytes, closing socket!\n", _socket_name);
+      result &= false;
+      return result;
+   }
+   else if (SOCKET_ERROR == bytes_received)
+   {
+      // Readiness can be stale, nothing to read is not a failure
+      if (WSAEWOULDBLOCK == WSAGetLastError())
+      {
+         return result;
+      }
+      Log::Write<Log::LEVEL_ERROR>("%s Receive() failed, closing socket!\n", _socket_name);
+      result &= false;
+      return result;
+   }
+   decoder.Commit(static_cast<size_t>(bytes_received));
+   _stats->Add(Stats::BYTES_RECEIVED, static_cast<uint64_t>(bytes_received));
+
+   // The idle timer compares this with the wheel's tick when it fires,
+   // reading the tick is cheaper than moving the timer on every read
+   if (0 != _idle_timeout && Socket_Vars::NO_CONNECTION == connection)
+   {
+      _last_receive_tick = Socket_Vars::Get_Timer_Wheel(Socket_Vars::Get_Event_Loop(_event_handle_index)).Get_Tick();
+   }
+   else if (0 != _idle_timeout)
+   {
+      Connection& state = _connections->Get(connection);
+      state.last_receive_tick = Socket_Vars::Get_Timer_Wheel(state.loop.load(std::memory_order_relaxed)).Get_Tick();
+   }
+
+   //
+   // 2. Hand every whole message up as a view of the buffer it was read into
+   while (Framing::Frame_Decoder::FRAME == (frame_result = decoder.Next_Frame(frame)))
+   {
+      Handle_Message(frame, (Socket_Vars::UDP == _protocol) ? &sender : nullptr, connection);
+   }
+
+   //
+   // 3. A bad prefix loses track of where messages start, shut the socket
+   //    down so it closes through the normal path
+   if (Framing::Frame_Decoder::FRAME_ERROR == frame_result)
+   {
+      Log::Write<Log::LEVEL_WARNING>("%s Receive() bad or oversized frame, closing socket!\n", _socket_name);
+      shutdown(socket, SD_BOTH);
+      result &= false;
+   }
+
+   return result;
+}  // END Receive_Frames()
+
+//+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+
+/// Creates a socket handle for the selected I/O engine
+//+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+
+SOCKET Universal_Socket::Open_Socket(int type, int protocol)
+{
+   DWORD flags = WSA_FLAG_OVERLAPPED;
+
+   // Registered I/O request queues can only be created on flagged sockets
+   if (Socket_Vars::REGISTERED_IO == _io_engine)
+   {
+      flags |= WSA_FLAG_REGISTERED_IO;
+   }
+
+   // AF_UNIX has only the one protocol of each type
+   if (Socket_Vars::UNIX_STREAM == _protocol)
+   {
+      return WSASocket(AF_UNIX, type, 0, nullptr, 0, flags);
+   }
+
+   return WSASocket(_family, type, protocol, nullptr, 0, flags);
+}  // END Open_Socket()
+
+//+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+
+/// Hands a connected or bound _socket to the engine
+//+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+
+bool Universal_Socket::Attach_Socket()
+{
+   bool result = true;
+   int func_result;
+
+   //
+   // 1. Registered I/O sockets post their receives on the engine
+   if (Socket_Vars::REGISTERED_IO == _io_engine)
+   {
+      result &= Registered_IO::Register_Socket(this, _socket, _event_handle_index, Socket_Vars::UDP == _protocol);
+      if (!result)
+      {
+         Log::Write<Log::LEVEL_ERROR>("ERROR, %s Register_Socket() failed!\n", _socket_name);
+      }
+      return result;
+   }
+
+   //
+   // 2. Event select sockets are associated with their event
+   result &= Select_Events();
+
+   return result;
+}  // END Attach_Socket()
+
+//+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+
+/// Associates _socket with the socket's event
+//+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+
+bool Universal_Socket::Select_Events()
+{
+   bool result = true;
+   int func_result;
+
+   //
+   // 1. Create an event for the socket, a reconnect reuses it
+   if (WSA_INVALID_EVENT == Socket_Vars::Get_Socket_Event(_event_handle_index))
+   {
+      HANDLE event = WSACreateEvent();
+      Socket_Vars::Get_Socket_Event(_event_handle_index) = event;
+      if (WSA_INVALID_EVENT == Socket_Vars::Get_Socket_Event(_event_handle_index))
+      {
+         Log::Write<Log::LEVEL_ERROR>("ERROR, %s WSACreateEvent() failed with: %u\n", _socket_name, WSAGetLastError());
+         result &= false;
+         return result;
+      }
+   }
+
+   //
+   // 2. Use 'WSAEventSelect' to associate an event with the socket
+   func_result = WSAEventSelect(
+      _socket,
+      Socket_Vars::Get_Socket_Event(_event_handle_index),
+      FD_CONNECT | FD_ACCEPT | FD_READ | FD_WRITE | FD_CLOSE);
+   if (SOCKET_ERROR == func_result)
+   {
+      Log::Write<Log::LEVEL_ERROR>("ERROR, %s WSAEventSelect() failed with: %u\n", _socket_name, WSAGetLastError());
+      result &= false;
+      return result;
+   }
+
+   return result;
+}  // END Select_Events()
+
+//+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+
+/// Opens a new TCP client socket and starts a non-blocking connect
+//+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+
+bool Universal_Socket::Begin_Connect()
+{
+   bool result = true;
+   int func_result;
+   int send_buffer_size = 0;
+
+   //
+   // 1. Open a new socket, one whose connect failed cannot connect again
+   _socket = Open_Socket(
+      SOCK_STREAM,   // type = TCP
+      IPPROTO_TCP);  // protocol = TCP
+   if (INVALID_SOCKET == _socket)
+   {
+      Log::Write<Log::LEVEL_ERROR>("ERROR, Client socket() failed with: %u\n", WSAGetLastError());
+      result &= false;
+      return result;
+   }
+
+   // With no send buffer an overlapped send is written straight from the
+   // message, which is what makes zero-copy sends zero-copy
+   if (_is_zero_copy)
+   {
+      setsockopt(_socket, SOL_SOCKET, SO_SNDBUF, (char*)&send_buffer_size, sizeof(int));
+   }
+
+   //
+   // 2. Associate the event before connecting, FD_CONNECT then reports how
+   //    the connect went, registered I/O sockets register once connected
+   result &= Select_Events();
+   if (!result)
+   {
+      return result;
+   }
+
+   //
+   // 3. Start the connect, the socket is non-blocking so it completes later
+   //    on the event loop, or fails once _deadline passes
+   func_result = connect(_socket, Stream_Address(), Stream_Address_Size());
+   if (0 == func_result)
+   {
+      result &= Complete_Connect();
+   }
+   else if (WSAEWOULDBLOCK == WSAGetLastError())
+   {
+      _connect_state = Socket_Vars::CONNECT_PENDING;
+      _deadline = std::chrono::steady_clock::now() + std::chrono::milliseconds(_connect_timeout);
+   }
+   else
+   {
+      Log::Write<Log::LEVEL_ERROR>("ERROR, Client connect() failed with: %u\n", WSAGetLastError());
+      result &= false;
+   }
+
+   return result;
+}  // END Begin_Connect()
+
+//+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+
+/// Makes a TCP client whose connect completed ready
+//+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+
+bool Universal_Socket::Complete_Connect()
+{
+   bool result = true;
+
+   _connect_state = Socket_Vars::CONNECT_IDLE;
+
+   //
+   // 1. Registered I/O sockets drop the event select used to connect
+   //    and complete on the engine instead
+   if (Socket_Vars::REGISTERED_IO == _io_engine)
+   {
+      WSAEventSelect(_socket, nullptr, 0);
+      result &= Registered_IO::Register_Socket(this, _socket, _event_handle_index, false);
+      if (!result)
+      {
+         Log::Write<Log::LEVEL_ERROR>("ERROR, %s Register_Socket() failed!\n", _socket_name);
+         return result;
+      }
+   }
+
+   //
+   // 2. The backoff starts over, anything queued while disconnected can go now
+   Log::Write<Log::LEVEL_INFO>("TCP Client %s: Ready for sending and/or receiving messages...\n", _socket_name);
+   _reconnect_attempts = 0;
+   _decoder.Configure(_framing, _max_frame_size);
+   _is_socket_connected = true;
+   Socket_Vars::Schedule_Send(_event_handle_index);
+
+   return result;
+}  // END Complete_Connect()
+
+//-+-+-+-+-+-+-+-+-+-+-+PUBLIC FUNCTIONS+-+-+-+-+-+-+-+-+-+-+-+-+-+
+
+//+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+
+/// Constructor
+//+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+
+Universal_Socket::Universal_Socket
+(
+   Socket_Vars::Protocol protocol_type,
+   Socket_Vars::Connection_Type connection_type,
+   std::string ip_address,
+   uint16_t port,
+   std::string name
+)
+{
+   //Initialize private variables
+   _protocol = protocol_type;
+   _connection = connection_type;
+   _io_engine = Socket_Vars::EVENT_SELECT;
+   _ip_address = ip_address;
+   _port = port;
+   _socket_name = name;
+   _stats = nullptr;
+   _socket = INVALID_SOCKET;
+   _listen_socket = INVALID_SOCKET;
+   _is_socket_connected = false;
+   _is_stopping.store(false, std::memory_order_relaxed);
+   _is_peer_closed.store(false, std::memory_order_relaxed);
+   _is_waiting_writable.store(false, std::memory_order_relaxed);
+   _is_zero_copy = false;
+   _zero_copy_threshold = Socket_Vars::ZERO_COPY_THRESHOLD;
+   _file_count.store(0, std::memory_order_relaxed);
+   _channel_stop_event = (Socket_Vars::SHARED_MEMORY == protocol_type) ? CreateEventA(nullptr, TRUE, FALSE, nullptr) : nullptr;
+   _is_channel_running.store(false, std::memory_order_relaxed);
+   _channel_generation.store(0, std::memory_order_relaxed);
+   _is_spinning = false;
+   _connect_state = Socket_Vars::CONNECT_IDLE;
+   _reconnect_attempts = 0;
+   _reconnect_base_delay = Socket_Vars::RECONNECT_BASE_DELAY;
+   _reconnect_max_delay = Socket_Vars::RECONNECT_MAX_DELAY;
+   _connect_timeout = Socket_Vars::CONNECT_TIMEOUT;
+   _jitter.seed(std::random_device()());
+   _deadline_timer = 0;
+   _idle_timer = 0;
+   _heartbeat_timer = 0;
+   _last_receive_tick = 0;
+   _idle_timeout = 0;
+   _heartbeat_interval = 0;
+   _framing = Framing::NONE;
+   _max_frame_size = Framing::DEFAULT_MAX_FRAME_SIZE;
+   _udp_batch_size = 1;
+   _is_send_segmentation_supported = true;
+   _datagram_used = 0;
+   _next_loop = 0;
+   _slow_policy = Socket_Vars::SLOW_DROP;
+   _family = (Socket_Vars::UDP == protocol_type && std::string::npos != ip_address.find(':')) ? AF_INET6 : AF_INET;
+   _is_multicast = false;
+   _multicast_interface = 0;
+   _multicast_ttl = Socket_Vars::MULTICAST_TTL;
+   _is_multicast_loopback = true;
+   _receive_message = nullptr;
+   _groups.store(std::make_shared<const Socket_Vars::Multicast_Groups>(), std::memory_order_relaxed);
+   _has_groups.store(false, std::memory_order_relaxed);
+   _next_group = 0;
+   memset(&_address, 0, sizeof(SOCKADDR_IN));
+   memset(&_address6, 0, sizeof(SOCKADDR_IN6));
+   memset(&_last_sender, 0, sizeof(SOCKADDR_INET));
+   memset(&_unix_address, 0, sizeof(SOCKADDR_UN));
+
+   // function level variables
+   int func_result = 0;
+   WORD wVersionRequested = MAKEWORD(2, 2);  // Request Winsock v2
+   WSADATA wsa_data;
+
+   //
+   // 1. Retrieve details of Windows Sockets implementation
+   func_result = WSAStartup(wVersionRequested, &wsa_data);
+   if (0 != func_result)
+   {
+      Log::Write<Log::LEVEL_ERROR>("ERROR loading WinSock v2!\n");
+   }
+
+   //
+   // 2. Create a new event and take a registry slot for it
+   HANDLE event = WSA_INVALID_EVENT;
+   if (!Socket_Vars::Add_Event_To_Event_List(event, _event_handle_index))
+   {
+      Log::Write<Log::LEVEL_ERROR>("ERROR, too many sockets exist, failed creation of socket!\n");
+      return;
+   }
+
+   //
+   // 3. Messages not on an accepted connection are handled on the socket's
+   //    own strand, its queue index picks the strand's worker
+   _stats = &Socket_Vars::Sockets().Get_Slot(_event_handle_index).stats;
+   _context.reset(new Socket_Vars::Message_Context());
+   _context->socket_index = _event_handle_index;
+   _context->stats = _stats;
+   _context->socket_name = _socket_name;
+   _context->connections = nullptr;
+   _context->handler = Socket_Vars::Default_Message_Handler;
+   _context->is_async = false;
+   _context->strand.Initialize(
+      Socket_Vars::RECEIVE_QUEUE_CAPACITY,
+      Socket_Vars::Dispatch_Message,
+      _context.get(),
+      static_cast<uint16_t>(_event_handle_index));
+
+}  // End Constructor
+
+//+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+    
+/// Opens the socket ready to receive and or send
+//+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+
+bool Universal_Socket::Start()
+{
+   bool result = true;
+   uint8_t key[sizeof(Socket_Vars::Multicast_Group::key)];
+
+   //
+   // 1. Datagrams and shared memory records already arrive whole, only
+   //    streams are framed, Registered I/O only takes AF_INET sockets
+   _decoder.Configure(Socket_Vars::Is_Stream(_protocol) ? _framing : Framing::NONE, _max_frame_size);
+   if ((Socket_Vars::UNIX_STREAM == _protocol || Socket_Vars::SHARED_MEMORY == _protocol) && Socket_Vars::REGISTERED_IO == _io_engine)
+   {
+      Log::Write<Log::LEVEL_WARNING>("%s UNIX_STREAM and SHARED_MEMORY sockets use EVENT_SELECT, not REGISTERED_IO!\n", _socket_name);
+      _io_engine = Socket_Vars::EVENT_SELECT;
+   }
+
+   //
+   // 2. IPv6 and multicast datagrams are read with their destination by
+   //    WSARecvMsg(), Registered I/O has no such receive
+   if (Socket_Vars::UDP == _protocol && Socket_Vars::REGISTERED_IO == _io_engine &&
+       (AF_INET6 == _family || _has_groups.load(std::memory_order_acquire) || Socket_Vars::Get_Group_Key(_ip_address, _family, key)))
+   {
+      Log::Write<Log::LEVEL_WARNING>("%s IPv6 and multicast UDP sockets use EVENT_SELECT, not REGISTERED_IO!\n", _socket_name);
+      _io_engine = Socket_Vars::EVENT_SELECT;
+   }
+
+   //
+   // 3. Start the socket for the specified protocol and connection type,
+   //    UNIX_STREAM sockets start the way TCP sockets do
+   if (Socket_Vars::Is_Stream(_protocol))
+   {
+      if (Socket_Vars::SERVER == _connection)
+      {
+         result &= TCP_Server_Start();
+      }
+      else if (Socket_Vars::CLIENT == _connection)
+      {
+         result &= TCP_Client_Start();
+      }
+      else
+      {
+         Log::Write<Log::LEVEL_ERROR>("Invalid connection type specified for TCP Socket!\n");
+         result &= false;
+      }
+   }
+   else if (Socket_Vars::UDP == _protocol)
+   {
+      result &= UDP_Socket_Start();
+   }
+   else if (Socket_Vars::SHARED_MEMORY == _protocol)
+   {
+      result &= Shared_Memory_Start();
+   }
+   else
+   {
+      Log::Write<Log::LEVEL_ERROR>("Invalid protocol type specified for Socket!\n");
+      result &= false;
+   }
+
+   return result;
+}  // END Start()
+
+//+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+
+/// Handles the event that was triggered on this socket
+//+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+
+bool Universal_Socket::Handle_Event(short revents)
+{
+   bool result = true;
+   int func_result;
+   WSANETWORKEVENTS networkEvents;
+   SOCKET polled_socket;
+
+   //
+   // 0. A socket waiting with a backlog is writable again, its sending
+   //    thread writes the backlog, a connect in progress completes as
+   //    writable and is finished below
+   if ((revents & POLLWRNORM) && _is_waiting_writable.exchange(false, std::memory_order_acq_rel))
+   {
+      Socket_Vars::Schedule_Send(_event_handle_index);
+   }
+   if (0 == (revents & ~POLLWRNORM) && Socket_Vars::CONNECT_PENDING != _connect_state)
+   {
+      return result;
+   }
+
+   //
+   // 1. Enumerate the events of the socket that was polled, the
+   //    _listen_socket until a client is accepted
+   polled_socket = Get_Polled_Socket();
+   if (INVALID_SOCKET == polled_socket)
+   {
+      return result;
+   }
+   func_result = WSAEnumNetworkEvents(
+      polled_socket,
+      Socket_Vars::Get_Socket_Event(_event_handle_index),
+      &networkEvents
+   );
+
+   //
+   // 2. Check for socket error
+   if (SOCKET_ERROR == func_result)
+   {
+      Log::Write<Log::LEVEL_ERROR>("WSAEnumNetworkEvents() failed with: %u\n", WSAGetLastError());
+      result &= false;
+      return result;
+   }
+
+   //
+   // 3. A client's connect finished, a refused or unreachable server
+   //    is tried again after the backoff
+   if ((networkEvents.lNetworkEvents & FD_CONNECT) && Socket_Vars::CONNECT_PENDING == _connect_state)
+   {
+      if (0 != networkEvents.iErrorCode[FD_CONNECT_BIT])
+      {
+         Log::Write<Log::LEVEL_ERROR>("%s connect() failed with: %d\n", _socket_name, networkEvents.iErrorCode[FD_CONNECT_BIT]);
+         result &= Reconnect();
+         return result;
+      }
+      result &= Complete_Connect();
+      if (!result)
+      {
+         result = Reconnect();
+         return result;
+      }
+   }
+
+   //
+   // 4. Event fired for this socket was a socket accept,
+   //    servers with a connection table take every waiting client
+   if ((networkEvents.lNetworkEvents & FD_ACCEPT) && (nullptr != _connections))
+   {
+      result &= Accept_Connections();
+   }
+   else if ((networkEvents.lNetworkEvents & FD_ACCEPT))
+   {
+      _socket = accept(_listen_socket, nullptr, nullptr);
+      if (INVALID_SOCKET == _socket) 
+      {
+         Log::Write<Log::LEVEL_ERROR>("%s accept() failed with: %u!\n", _socket_name, WSAGetLastError());
+         result &= false;
+         return result;
+      }
+      Log::Write<Log::LEVEL_INFO>("%s accept() succeeded!\n", _socket_name);
+      _stats->Add(Stats::ACCEPTS);
+
+      // Registered I/O connections drop the event select inherited from
+      // the listen socket and complete on the engine instead
+      if (Socket_Vars::REGISTERED_IO == _io_engine)
+      {
+         WSAEventSelect(_socket, nullptr, 0);
+         result &= Registered_IO::Register_Socket(this, _socket, _event_handle_index, false);
+         if (!result)
+         {
+            Log::Write<Log::LEVEL_ERROR>("%s Register_Socket() failed!\n", _socket_name);
+            Close_Connection();
+            return result;
+         }
+      }
+
+      // If socket is connected and ready to send and receive, then
+      // set the flag to true, anything queued while disconnected can go now
+      _decoder.Configure(_framing, _max_frame_size);
+      _is_socket_connected = true;
+      Socket_Vars::Schedule_Send(_event_handle_index);
+   }
+
+   // 
+   // 5. Event fired for this socket was a receive, every whole message
+   //    that arrived is handled, IPv6 and multicast datagrams with the
+   //    group they arrived on
+   if ((networkEvents.lNetworkEvents & FD_READ) && Socket_Vars::UDP == _protocol &&
+       (AF_INET6 == _family || _is_multicast || _has_groups.load(std::memory_order_acquire)))
+   {
+      result &= Receive_Group_Datagrams();
+   }
+   else if ((networkEvents.lNetworkEvents & FD_READ) && Socket_Vars::UDP == _protocol && 1 < _udp_batch_size)
+   {
+      result &= Receive_Datagrams();
+   }
+   else if ((networkEvents.lNetworkEvents & FD_READ))
+   {
+      result &= Receive_Frames(_socket, _decoder, Socket_Vars::NO_CONNECTION);
+   }
+
+   //
+   // 6. Event fired for this socket was a close, the reconnect is driven
+   //    by this event loop, nothing blocks waiting for the peer
+   if ((networkEvents.lNetworkEvents & FD_CLOSE))
+   {
+      Log::Write<Log::LEVEL_INFO>("%s Socket Disconnected!\n", _socket_name);
+      result &= Reconnect();
+   }
+
+   return result;
+}  // END Handle_Event()
+
+//+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+
+/// Handles the event that was triggered on an accepted connection
+//+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+
+bool Universal_Socket::Handle_Connection_Event(uint32_t connection, short revents)
+{
+   bool result = true;
+   Connection& state = _connections->Get(connection);
+   uint16_t loop = state.loop.load(std::memory_order_relaxed);
+
+   //
+   // 0. A connection waiting with a backlog is writable again, schedule it
+   //    on its loop's sending thread, there may be nothing to read
+   if ((revents & POLLWRNORM) && state.is_waiting_writable.exchange(false, std::memory_order_acq_rel))
+   {
+      _connections->Schedule_Send(connection);
+      Socket_Vars::Schedule_Send(_event_handle_index, loop);
+   }
+   if (0 == (revents & ~POLLWRNORM))
+   {
+      return result;
+   }
+
+   //
+   // 1. Read the messages, a failed or empty read means the client left
+   result &= Receive_Frames(
+      state.socket,
+      _connections->Get_Queues(connection).decoder,
+      connection);
+   if (!result)
+   {
+      //
+      // 2. Free the slot, the sending thread closes the socket once
+      //    nothing can still be sending on it
+      Log::Write<Log::LEVEL_INFO>("%s Connection %u Disconnected!\n", _socket_name, connection);
+      Drop_Connection(connection);
+      result = true;
+   }
+
+   return result;
+}  // END Handle_Connection_Event()
+
+//+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+
+/// Queues a message to be sent over the socket
+//+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+
+bool Universal_Socket::Send(const char* buffer)
+{
+   return Send(buffer, strlen(buffer));
+}  // END Send()
+
+//+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+
+/// Queues a binary message to be sent over the socket
+//+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+
+bool Universal_Socket::Send(const char* buffer, size_t length)
+{
+   // The sending thread frames and writes it, so a full socket buffer
+   // never loses part of a message
+   return Socket_Vars::Queue_Message(_event_handle_index, Buffers::Copy_To_Send_Pool(buffer, length));
+}  // END Send()
+
+//+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+
+/// Queues part of a file to be sent over the socket
+//+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+
+bool Universal_Socket::Send_File(const std::string& path, uint64_t offset, uint64_t length, Socket_Vars::File_Progress_Handler handler)
+{
+   bool result = true;
+   LARGE_INTEGER file_size;
+   std::unique_ptr<Socket_Vars::File_Send> file = std::make_unique<Socket_Vars::File_Send>();
+
+   //
+   // 1. Only a TCP client's own stream can carry a file, accepted
+   //    connections and registered I/O send from buffers of their own
+   if (Socket_Vars::TCP != _protocol || nullptr != _connections || Socket_Vars::REGISTERED_IO == _io_engine)
+   {
+      Log::Write<Log::LEVEL_WARNING>("%s Send_File() is only for TCP clients!\n", _socket_name);
+      result &= false;
+      return result;
+   }
+
+   //
+   // 2. Open the file and check the range here, so a bad path or range is
+   //    refused to the caller rather than logged by the sending thread
+   file->file = CreateFileA(path.c_str(), GENERIC_READ, FILE_SHARE_READ, nullptr, OPEN_EXISTING, FILE_FLAG_SEQUENTIAL_SCAN, nullptr);
+   if (INVALID_HANDLE_VALUE == file->file || !GetFileSizeEx(file->file, &file_size))
+   {
+      Log::Write<Log::LEVEL_ERROR>("%s Send_File() could not open %s, error: %u\n", _socket_name, path, GetLastError());
+      result &= false;
+      return result;
+   }
+   if (0 == length && offset < static_cast<uint64_t>(file_size.QuadPart))
+   {
+      length = static_cast<uint64_t>(file_size.QuadPart) - offset;
+   }
+   if (0 == length || static_cast<uint64_t>(file_size.QuadPart) < offset + length)
+   {
+      Log::Write<Log::LEVEL_WARNING>("%s Send_File() range is not in %s!\n", _socket_name, path);
+      result &= false;
+      return result;
+   }
+   if (Framing::NONE != _framing)
+   {
+      if (_max_frame_size < length)
+      {
+         Log::Write<Log::LEVEL_WARNING>("%s Send_File() of %llu bytes is over the max frame size!\n", _socket_name, length);
+         result &= false;
+         return result;
+      }
+      file->header_size = Framing::Encode_Header(_framing, static_cast<uint32_t>(length), file->header);
+   }
+   file->offset = offset;
+   file->end = offset + length;
+   file->total_bytes = length;
+   file->socket_index = _event_handle_index;
+   file->loop = Socket_Vars::Get_Event_Loop(_event_handle_index);
+   file->handler = handler;
+
+   //
+   // 3. Every chunk completes on the event, a thread pool wait on it puts
+   //    the socket back on its sending thread's schedule
+   file->overlapped.hEvent = CreateEvent(nullptr, FALSE, FALSE, nullptr);
+   if (nullptr == file->overlapped.hEvent ||
+       !RegisterWaitForSingleObject(&file->wait, file->overlapped.hEvent, File_Chunk_Completed, file.get(), INFINITE, WT_EXECUTEDEFAULT))
+   {
+      Log::Write<Log::LEVEL_ERROR>("%s Send_File() wait could not be registered, error: %u\n", _socket_name, GetLastError());
+      file->wait = nullptr;
+      result &= false;
+      return result;
+   }
+
+   //
+   // 4. Queue it behind any other file and wake the sending thread
+   {
+      std::lock_guard<std::mutex> lock(_file_lock);
+      _files.push_back(std::move(file));
+      _file_count.fetch_add(1, std::memory_order_release);
+   }
+   Socket_Vars::Schedule_Send(_event_handle_index);
+
+   return result;
+}  // END Send_File()
+
+//+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+
+/// Passes a socket to the process at the other end
+//+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+
+bool Universal_Socket::Send_Socket(SOCKET handle)
+{
+   bool result = true;
+   int func_result;
+   DWORD peer_process = 0;
+   DWORD bytes_returned = 0;
+   WSAPROTOCOL_INFOW info;
+
+   //
+   // 1. Only a framed client has the one peer and delivers the duplicate
+   //    to it whole
+   if (Socket_Vars::UNIX_STREAM != _protocol || nullptr != _connections || Framing::NONE == _framing || !_is_socket_connected)
+   {
+      Log::Write<Log::LEVEL_WARNING>("%s Send_Socket() is only for connected, framed UNIX_STREAM clients!\n", _socket_name);
+      result &= false;
+      return result;
+   }
+
+   //
+   // 2. Winsock has no SCM_RIGHTS, the socket is duplicated for the peer's
+   //    process instead, which AF_UNIX reports
+   func_result = WSAIoctl(_socket, SIO_AF_UNIX_GETPEERPID, nullptr, 0, &peer_process, sizeof(peer_process), &bytes_returned, nullptr, nullptr);
+   if (SOCKET_ERROR == func_result)
+   {
+      Log::Write<Log::LEVEL_ERROR>("%s Send_Socket() peer process not found, error: %u\n", _socket_name, WSAGetLastError());
+      result &= false;
+      return result;
+   }
+   func_result = WSADuplicateSocketW(handle, peer_process, &info);
+   if (SOCKET_ERROR == func_result)
+   {
+      Log::Write<Log::LEVEL_ERROR>("%s Send_Socket() WSADuplicateSocket() failed with: %u\n", _socket_name, WSAGetLastError());
+      result &= false;
+      return result;
+   }
+
+   //
+   // 3. The duplicate goes out in order with the other messages
+   result &= Socket_Vars::Queue_Message(_event_handle_index, Buffers::Copy_To_Send_Pool(reinterpret_cast<const char*>(&info), sizeof(info)));
+
+   return result;
+}  // END Send_Socket()
+
+//+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+
+/// Sends a batch of messages over the socket
+//+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+
+bool Universal_Socket::Send_Batch(Socket_Vars::Queued_Send* queued, size_t count)
+{
+   bool result = true;
+   SOCKADDR_INET send_address;
+   Buffers::Buffer_View messages[Socket_Vars::SEND_BATCH_SIZE];
+
+   //
+   // 1. Every UDP message is a datagram of its own, one without a
+   //    destination goes where the socket sends as of this batch
+   if (Socket_Vars::UDP == _protocol)
+   {
+      send_address = Get_Send_Address();
+      for (size_t i = 0; i < count; i++)
+      {
+         if (0 == queued[i].destination.si_family)
+         {
+            queued[i].destination = send_address;
+         }
+      }
+      result &= Send_Datagrams(_socket, queued, count, _backlog);
+   }
+   else
+   {
+      for (size_t i = 0; i < count; i++)
+      {
+         messages[i] = std::move(queued[i].message);
+      }
+      result &= Send_Batch(_socket, messages, count, _backlog);
+   }
+
+   //
+   // 2. A full shared memory ring schedules the socket once there is room,
+   //    it is never polled for writable
+   if (!_backlog.Is_Empty() && !_backlog.Is_Waiting_Completion() && Socket_Vars::SHARED_MEMORY != _protocol)
+   {
+      Wait_For_Writable(_is_waiting_writable, Socket_Vars::Get_Event_Loop(_event_handle_index));
+   }
+
+   return result;
+}  // END Send_Batch()
+
+//+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+
+/// Frames a message once and queues it for every subscriber
+//+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+
+bool Universal_Socket::Broadcast(uint32_t group, const char* buffer, size_t length)
+{
+   bool result = true;
+   char header[Framing::MAX_HEADER_SIZE];
+   size_t header_size = 0;
+   Buffers::Buffer_View broadcast;
+
+   //
+   // 1. Only a server's accepted connections subscribe
+   if (nullptr == _connections)
+   {
+      Log::Write<Log::LEVEL_ERROR>("%s Broadcast() needs a TCP or UNIX_STREAM server!\n", _socket_name);
+      result &= false;
+      return result;
+   }
+   if (Socket_Vars::BROADCAST_ALL != group && Socket_Vars::MAX_BROADCAST_GROUPS <= group)
+   {
+      Log::Write<Log::LEVEL_ERROR>("%s Broadcast() group %u is out of range!\n", _socket_name, group);
+      result &= false;
+      return result;
+   }
+   if (Framing::NONE != _framing && _max_frame_size < length)
+   {
+      Log::Write<Log::LEVEL_WARNING>("%s Broadcast() message of %zu bytes is over the max frame size!\n", _socket_name, length);
+      result &= false;
+      return result;
+   }
+
+   //
+   // 2. Frame it once, prefix and all, into a buffer every subscriber shares
+   if (Framing::NONE != _framing)
+   {
+      header_size = Framing::Encode_Header(_framing, static_cast<uint32_t>(length), header);
+   }
+   broadcast = Buffers::Broadcast_Pool().Acquire(header_size + length);
+   memcpy(broadcast.Get_Buffer(), header, header_size);
+   memcpy(broadcast.Get_Buffer() + header_size, buffer, length);
+   broadcast = broadcast.Slice(0, header_size + length);
+
+   //
+   // 3. Each open connection of every loop is walked, never the free
+   //    slots, a subscriber queues a reference, one whose queue is full
+   //    is too far behind, it loses the broadcast or is marked for its
+   //    loop to drop so it never holds buffers others have long sent
+   for (uint16_t loop = 0; loop < _connections->Get_Loop_Count(); loop++)
+   {
+      bool is_queued = false;
+      _connections->For_Each_Active(loop, [&](uint32_t connection)
+      {
+         Connection& state = _connections->Get(connection);
+         if (Socket_Vars::BROADCAST_ALL != group && 0 == (state.groups.load(std::memory_order_relaxed) & (uint64_t{ 1 } << group)))
+         {
+            return;
+         }
+         if (_connections->Queue_Broadcast(connection, broadcast))
+         {
+            is_queued = true;
+            return;
+         }
+         _stats->Add(Stats::MESSAGES_DROPPED);
+         if (Socket_Vars::SLOW_DISCONNECT == _slow_policy && !state.is_too_slow.exchange(true, std::memory_order_acq_rel))
+         {
+            Log::Write<Log::LEVEL_WARNING>("%s Connection %u fell behind on broadcasts, dropping it!\n", _socket_name, connection);
+            Socket_Vars::Wake_Event_Loop(loop);
+         }
+      });
+
+      //
+      // 4. Wake the loop's sending thread once if anything was queued on it
+      if (is_queued)
+      {
+         Socket_Vars::Schedule_Send(_event_handle_index, loop);
+      }
+   }
+
+   return result;
+}  // END Broadcast()
+
+//+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+
+/// Subscribes an accepted connection to a broadcast group
+//+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+
+bool Universal_Socket::Subscribe(uint32_t connection, uint32_t group)
+{
+   return (nullptr != _connections) && _connections->Set_Subscribed(connection, group, true);
+}  // END Subscribe()
+
+//+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+
+/// Unsubscribes an accepted connection from a broadcast group
+//+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+
+bool Universal_Socket::Unsubscribe(uint32_t connection, uint32_t group)
+{
+   return (nullptr != _connections) && _connections->Set_Subscribed(connection, group, false);
+}  // END Unsubscribe()
+
+//+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+
+/// Joins a UDP socket to a multicast group of its own family
+//+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+
+uint32_t Universal_Socket::Join_Group(const std::string& group_address, uint32_t interface_index)
+{
+   Socket_Vars::Multicast_Group joined;
+   std::shared_ptr<Socket_Vars::Multicast_Groups> groups;
+
+   //
+   // 1. Only a UDP socket joins, and only a group of its own family
+   if (Socket_Vars::UDP != _protocol || !Socket_Vars::Get_Group_Key(group_address, _family, joined.key))
+   {
+      Log::Write<Log::LEVEL_ERROR>("%s Join_Group() %s is not a multicast group of the socket's family!\n", _socket_name, group_address);
+      return Socket_Vars::NO_GROUP;
+   }
+   joined.interface_index = interface_index;
+
+   //
+   // 2. An open socket joins now, a closed one joins once it is bound, a
+   //    socket already started on Registered I/O cannot tell groups apart
+   std::lock_guard<std::mutex> lock(_group_lock);
+   if (INVALID_SOCKET != _socket && Socket_Vars::REGISTERED_IO == _io_engine)
+   {
+      Log::Write<Log::LEVEL_ERROR>("%s Join_Group() needs EVENT_SELECT, not REGISTERED_IO!\n", _socket_name);
+      return Socket_Vars::NO_GROUP;
+   }
+   joined.group = _next_group++;
+   if (INVALID_SOCKET != _socket && !Set_Membership(joined, true))
+   {
+      return Socket_Vars::NO_GROUP;
+   }
+
+   //
+   // 3. Publish a copy with the group in key order, the receiving thread
+   //    keeps the snapshot it has until its next wakeup
+   groups = std::make_shared<Socket_Vars::Multicast_Groups>(*_groups.load(std::memory_order_acquire));
+   groups->insert(
+      std::upper_bound(groups->begin(), groups->end(), joined,
+         [](const Socket_Vars::Multicast_Group& left, const Socket_Vars::Multicast_Group& right)
+         {
+            return 0 > memcmp(left.key, right.key, sizeof(left.key));
+         }),
+      joined);
+   _groups.store(std::move(groups), std::memory_order_release);
+   _has_groups.store(true, std::memory_order_release);
+
+   return joined.group;
+}  // END Join_Group()
+
+//+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+
+/// Leaves a multicast group Join_Group() joined
+//+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+
+bool Universal_Socket::Leave_Group(uint32_t group)
+{
+   bool result = true;
+   std::shared_ptr<Socket_Vars::Multicast_Groups> groups;
+
+   //
+   // 1. Find the group in a copy of the snapshot
+   std::lock_guard<std::mutex> lock(_group_lock);
+   groups = std::make_shared<Socket_Vars::Multicast_Groups>(*_groups.load(std::memory_order_acquire));
+   auto joined = std::find_if(groups->begin(), groups->end(),
+      [group](const Socket_Vars::Multicast_Group& candidate) { return group == candidate.group; });
+   if (groups->end() == joined)
+   {
+      Log::Write<Log::LEVEL_WARNING>("%s Leave_Group() group %u was not joined!\n", _socket_name, group);
+      result &= false;
+      return result;
+   }
+
+   //
+   // 2. An open socket drops its membership, datagrams already received
+   //    for the group are still handed up with its id
+   if (INVALID_SOCKET != _socket)
+   {
+      result &= Set_Membership(*joined, false);
+   }
+   groups->erase(joined);
+   _groups.store(std::move(groups), std::memory_order_release);
+
+   return result;
+}  // END Leave_Group()
+
+//+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+
+/// Writes what is left in the send backlog
+//+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+
+bool Universal_Socket::Flush_Send_Backlog()
+{
+   bool result = true;
+
+   if (_backlog.Is_Empty())
+   {
+      return result;
+   }
+
+   result &= Flush_Backlog(_socket, _backlog);
+   if (!_backlog.Is_Empty() && !_backlog.Is_Waiting_Completion() && Socket_Vars::SHARED_MEMORY != _protocol)
+   {
+      Wait_For_Writable(_is_waiting_writable, Socket_Vars::Get_Event_Loop(_event_handle_index));
+   }
+
+   return result;
+}  // END Flush_Send_Backlog()
+
+//+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+
+/// Starts the next queued file once nothing else waits
+//+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+
+bool Universal_Socket::Send_Queued_File()
+{
+   bool result = true;
+
+   //
+   // 1. A file goes once everything queued ahead of it is written, it then
+   //    holds the backlog so messages queued meanwhile follow it
+   if (0 == _file_count.load(std::memory_order_acquire) || !_backlog.Is_Empty())
+   {
+      return result;
+   }
+   {
+      std::lock_guard<std::mutex> lock(_file_lock);
+      _backlog.file = std::move(_files.front());
+      _files.erase(_files.begin());
+      _file_count.fetch_sub(1, std::memory_order_relaxed);
+   }
+
+   //
+   // 2. Its first chunk goes now, the rest as each one completes
+   _backlog.socket = _socket;
+   result &= Send_File_Chunk(_socket, _backlog);
+
+   return result;
+}  // END Send_Queued_File()
+
+//+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+
+/// Bounds the bytes queued on the socket
+//+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+
+void Universal_Socket::Set_Watermarks(size_t low_watermark, size_t high_watermark, size_t limit, Socket_Vars::Watermark_Handler handler)
+{
+   Socket_Vars::Socket_Slot& slot = Socket_Vars::Sockets().Get_Slot(_event_handle_index);
+
+   // The high watermark is never under the low, the limit never under the high
+   slot.low_watermark = low_watermark;
+   slot.high_watermark = (high_watermark < low_watermark) ? low_watermark : high_watermark;
+   slot.send_buffer_limit = (limit < slot.high_watermark) ? slot.high_watermark : limit;
+   slot.watermark_handler = handler;
+}  // END Set_Watermarks()
+
+//+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+
+/// Sends everything queued for the accepted connections
+//+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+
+bool Universal_Socket::Send_Connections(uint16_t loop)
+{
+   bool result = true;
+   size_t message_count;
+   size_t connection_count;
+   Socket_Vars::Queued_Send queued;
+   Buffers::Buffer_View messages[Socket_Vars::SEND_BATCH_SIZE];
+   Buffers::Buffer_View broadcasts[Socket_Vars::SEND_BATCH_SIZE];
+   uint32_t connections[Socket_Vars::SEND_BATCH_SIZE];
+
+   //
+   // 1. The loop owning the server broadcasts messages queued on the
+   //    server itself to every open connection, framed once and shared,
+   //    they wait on the server's queue while no client is connected,
+   //    every other loop is scheduled to send its share
+   if (Socket_Vars::Get_Event_Loop(_event_handle_index) == loop)
+   {
+      while (Is_Socket_Connected() && Socket_Vars::Get_Send_Queue(_event_handle_index).Pop(queued))
+      {
+         Socket_Vars::Release_Send_Bytes(_event_handle_index, queued.message.Size());
+         Broadcast(Socket_Vars::BROADCAST_ALL, queued.message.Data(), queued.message.Size());
+      }
+      queued.message.Reset();
+      for (uint16_t other = 0; other < Socket_Vars::event_loop_count; other++)
+      {
+         if (other != loop)
+         {
+            Socket_Vars::Schedule_Send(_event_handle_index, other);
+         }
+      }
+   }
+
+   //
+   // 2. Service only this loop's connections with something queued
+   do
+   {
+      connection_count = _connections->Take_Pending_Sends(loop, connections, Socket_Vars::SEND_BATCH_SIZE);
+      for (size_t i = 0; i < connection_count; i++)
+      {
+         Connection& state = _connections->Get(connections[i]);
+         Connection_Queues& queues = _connections->Get_Queues(connections[i]);
+
+         //
+         // 2a. A removed connection is released in step 3
+         if (!state.is_connected.load(std::memory_order_acquire))
+         {
+            continue;
+         }
+
+         //
+         // 2b. Anything a full socket buffer left goes first
+         if (!queues.backlog.Is_Empty())
+         {
+            result &= Flush_Backlog(state.socket, queues.backlog);
+         }
+
+         //
+         // 2c. Send every message waiting on the connection's queue, each
+         //     batch in one gathered write, nothing more is popped while a
+         //     backlog waits so a slow client holds only its own queue
+         while (queues.backlog.Is_Empty())
+         {
+            message_count = queues.send_queue.Pop_Batch(messages, Socket_Vars::SEND_BATCH_SIZE);
+            if (0 < message_count)
+            {
+               queues.send_waiters.Wake();
+               result &= Send_Batch(state.socket, messages, message_count, queues.backlog);
+            }
+            if (Socket_Vars::SEND_BATCH_SIZE != message_count)
+            {
+               break;
+            }
+         }
+
+         //
+         // 2d. Then every broadcast waiting, each batch gathered from the
+         //     shared buffers in one write, ordered among themselves but
+         //     not against the messages above
+         while (queues.backlog.Is_Empty())
+         {
+            message_count = queues.broadcast_queue.Pop_Batch(broadcasts, Socket_Vars::SEND_BATCH_SIZE);
+            if (0 < message_count)
+            {
+               result &= Send_Broadcasts(state.socket, broadcasts, message_count, queues.backlog);
+            }
+            if (Socket_Vars::SEND_BATCH_SIZE != message_count)
+            {
+               break;
+            }
+         }
+         if (!queues.backlog.Is_Empty())
+         {
+            Wait_For_Writable(state.is_waiting_writable, loop);
+         }
+      }
+   } while (Socket_Vars::SEND_BATCH_SIZE == connection_count);
+
+   //
+   // 3. Close and free this loop's removed connections once nothing is
+   //    left listed to send on them
+   _connections->Release_Closed(loop);
+
+   return result;
+}  // END Send_Connections()
+
+//+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+
+/// Handles a complete message received on this socket
+//+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+
+void Universal_Socket::Handle_Message(const Buffers::Buffer_View& message, const SOCKADDR_INET* sender, uint32_t connection, uint32_t group)
+{
+   bool result;
+   Socket_Vars::Received_Message received{ message, connection };
+
+   received.group = group;
+
+   //
+   // 1. The sender travels with the message for Reply(), and becomes
+   //    where the socket sends, group sockets pass none and keep the group
+   if (nullptr != sender)
+   {
+      received.sender = *sender;
+      std::lock_guard<std::mutex> lock(_sender_lock);
+      _last_sender = *sender;
+   }
+
+   //
+   // 2. Post a view of the message to the strand of the connection it arrived
+   //    on, or of the socket, the pooled buffer is shared, never copied, and
+   //    the handler runs on the handler pool so this thread only moves bytes
+   _stats->Add(Stats::MESSAGES_RECEIVED);
+   received.queued_at = std::chrono::steady_clock::now();
+   if (Socket_Vars::NO_CONNECTION != connection)
+   {
+      result = _connections->Get_Queues(connection).strand.Post(std::move(received));
+   }
+   else
+   {
+      result = _context->strand.Post(std::move(received));
+   }
+   if (!result)
+   {
+      Log::Write<Log::LEVEL_WARNING>("%s handler is behind, message dropped!\n", _socket_name);
+      _stats->Add(Stats::MESSAGES_DROPPED);
+   }
+}  // END Handle_Message()
+
+//+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+
+/// Posts an accepted connection's opening or closing
+//+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+
+void Universal_Socket::Post_Connection_Event(uint32_t connection, Socket_Vars::Receive_Event event)
+{
+   Socket_Vars::Received_Message received{ Buffers::Buffer_View(), connection, event };
+
+   // Unlike a message an event is never dropped, a coroutine would wait
+   // on the connection forever, it takes a cell messages are kept out of
+   // so the event loop never waits behind a slow handler
+   if (!_connections->Get_Queues(connection).strand.Post_Reserved(received))
+   {
+      Log::Write<Log::LEVEL_ERROR>("%s connection %u event %u lost, strand full!\n", _socket_name, connection, static_cast<unsigned>(event));
+   }
+}  // END Post_Connection_Event()
+
+//+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+
+/// Places a message on one accepted connection's queue
+//+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+
+bool Universal_Socket::Queue_Connection_Message(uint32_t connection, Buffers::Buffer_View message)
+{
+   return Socket_Vars::Queue_Connection_Message(_event_handle_index, _connections.get(), connection, std::move(message));
+}  // END Queue_Connection_Message()
+
+//+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+
+/// Copies a message into the send pool and queues it on one connection
+//+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+
+bool Universal_Socket::Queue_Connection_Message(uint32_t connection, const std::string& message)
+{
+   return Queue_Connection_Message(connection, Buffers::Copy_To_Send_Pool(message.data(), message.size()));
+}  // END Queue_Connection_Message()
+
+//+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+
+/// Frees an accepted connection's slot and cancels its timers
+//+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+
+void Universal_Socket::Drop_Connection(uint32_t connection)
+{
+   Connection& state = _connections->Get(connection);
+   uint16_t loop = state.loop.load(std::memory_order_relaxed);
+   Timers::Timer_Wheel& wheel = Socket_Vars::Get_Timer_Wheel(loop);
+
+   if (_context->is_async)
+   {
+      Post_Connection_Event(connection, Socket_Vars::CONNECTION_CLOSED);
+   }
+   wheel.Cancel(state.idle_timer);
+   wheel.Cancel(state.heartbeat_timer);
+   state.idle_timer = 0;
+   state.heartbeat_timer = 0;
+   _connections->Remove(connection);
+   Socket_Vars::Schedule_Send(_event_handle_index, loop);
+}  // END Drop_Connection()
+
+//+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+
+/// Starts an accepted connection's idle and heartbeat timers
+//+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+
+void Universal_Socket::Arm_Connection_Timers(uint32_t connection, Timers::Timer_Wheel& wheel)
+{
+   Connection& state = _connections->Get(connection);
+
+   state.last_receive_tick = wheel.Get_Tick();
+   if (0 != _idle_timeout)
+   {
+      state.idle_timer = wheel.Schedule(
+         _idle_timeout,
+         Timer_Expired,
+         this,
+         (static_cast<uint64_t>(Socket_Vars::TIMER_IDLE) << 32) | connection);
+   }
+   if (0 != _heartbeat_interval)
+   {
+      state.heartbeat_timer = wheel.Schedule(
+         _heartbeat_interval,
+         Timer_Expired,
+         this,
+         (static_cast<uint64_t>(Socket_Vars::TIMER_HEARTBEAT) << 32) | connection);
+   }
+}  // END Arm_Connection_Timers()
+
+//+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+
+/// Wheel callback of every socket and connection timer
+//+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+
+void Universal_Socket::Timer_Expired(void* context, uint64_t data)
+{
+   Universal_Socket* socket = static_cast<Universal_Socket*>(context);
+
+   if (!socket->Handle_Timer(static_cast<Socket_Vars::Timer_Kind>(data >> 32), static_cast<uint32_t>(data)))
+   {
+      Log::Write<Log::LEVEL_ERROR>("%s Handle_Timer() returned false!\n", socket->_socket_name);
+   }
+}  // END Timer_Expired()
+
+//+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+
+/// Runs a timer that fired
+//+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+
+bool Universal_Socket::Handle_Timer(Socket_Vars::Timer_Kind kind, uint32_t connection)
+{
+   bool result = true;
+   uint16_t loop;
+   uint64_t idle;
+   Timers::Timer_Id* timer;
+   uint64_t* last_receive_tick;
 
    //
-   // 2. Initialize the SOCKADDR_IN
-   _address.sin_family = AF_INET;
-   _address.sin_port = htons(_port);
-   // InetPton() requires IP Address as a PCWSTR
-   // this is the conversion of std::string to PCWSTR
-   std::wstring w_str(_ip_address.begin(), _ip_address.end());
-   PCWSTR pcwstr_ip = w_str.c_str();
-   InetPton(AF_INET, pcwstr_ip, &_address.sin_addr.s_addr);
+   // 1. A connect or backoff deadline, Arm_Timers() arms it again if it
+   //    fired before the deadline or the deadline moved
+   if (Socket_Vars::TIMER_DEADLINE == kind)
+   {
+      _deadline_timer = 0;
+      result &= Handle_Timeout(std::chrono::steady_clock::now());
+      return result;
+   }
 
    //
-   // 3. Listen on specific port for incoming messages
-   func_result = bind(_socket, (SOCKADDR*)&_address, sizeof(_address));
-   if (0 != func_result)
+   // 2. The socket's own link or one accepted client's, whose timer it
+   //    is, the id has already gone stale
+   if (Socket_Vars::NO_CONNECTION == connection)
    {
-      printf("ERROR, UDP bind() failed with: %u\n", WSAGetLastError());
-      result &= false;
-      return result;
+      loop = Socket_Vars::Get_Event_Loop(_event_handle_index);
+      timer = (Socket_Vars::TIMER_IDLE == kind) ? &_idle_timer : &_heartbeat_timer;
+      last_receive_tick = &_last_receive_tick;
    }
    else
    {
-      printf("UDP Socket %s: Ready for sending and/or receiving messages...\n", _socket_name.c_str());
-      result &= true;
-      _is_socket_connected = true;
+      Connection& state = _connections->Get(connection);
+      loop = state.loop.load(std::memory_order_relaxed);
+      timer = (Socket_Vars::TIMER_IDLE == kind) ? &state.idle_timer : &state.heartbeat_timer;
+      last_receive_tick = &state.last_receive_tick;
+   }
+   Timers::Timer_Wheel& wheel = Socket_Vars::Get_Timer_Wheel(loop);
+   *timer = 0;
+   if (Socket_Vars::NO_CONNECTION == connection && !_is_socket_connected)
+   {
+      return result;
    }
 
    //
-   // 4. Create an event for the listen socket
-   HANDLE event = WSACreateEvent();
-   Socket_Vars::socket_events[_event_handle_index] = event;
-   if (WSA_INVALID_EVENT == Socket_Vars::socket_events[_event_handle_index])
+   // 3. A heartbeat is queued like any other message and the next is due
+   //    an interval on
+   if (Socket_Vars::TIMER_HEARTBEAT == kind)
    {
-      printf("ERROR, Client WSACreateEvent() failed with: %u\n", WSAGetLastError());
-      result &= false;
+      if (Socket_Vars::NO_CONNECTION == connection)
+      {
+         result &= Socket_Vars::Queue_Message(_event_handle_index, _heartbeat_message);
+      }
+      else
+      {
+         result &= Queue_Connection_Message(connection, _heartbeat_message);
+      }
+      *timer = wheel.Schedule(_heartbeat_interval, Timer_Expired, this, (static_cast<uint64_t>(kind) << 32) | connection);
       return result;
    }
 
    //
-   // 5. Use 'WSAEventSelect' to associate an event with the socket
-   func_result = WSAEventSelect(
-      _socket,
-      Socket_Vars::socket_events[_event_handle_index],
-      FD_ACCEPT | FD_READ | FD_WRITE | FD_CLOSE);
-   if (SOCKET_ERROR == func_result)
+   // 4. A link that received something since waits out the rest of the
+   //    timeout from then, a silent one is closed, a client reconnects
+   //    and a single client server waits for the next accept
+   idle = wheel.Get_Tick() - *last_receive_tick;
+   if (idle < _idle_timeout)
    {
-      printf("ERROR, Server WSAEventSelect() failed with: %u\n", WSAGetLastError());
-      result &= false;
+      *timer = wheel.Schedule(_idle_timeout - idle, Timer_Expired, this, (static_cast<uint64_t>(kind) << 32) | connection);
       return result;
    }
+   _stats->Add(Stats::IDLE_TIMEOUTS);
+   if (Socket_Vars::NO_CONNECTION == connection)
+   {
+      Log::Write<Log::LEVEL_WARNING>("%s received nothing for %u ms, closing socket!\n", _socket_name, _idle_timeout);
+      result &= Reconnect();
+   }
+   else
+   {
+      Log::Write<Log::LEVEL_WARNING>("%s Connection %u received nothing for %u ms, dropping it!\n", _socket_name, connection, _idle_timeout);
+      Drop_Connection(connection);
+   }
 
    return result;
-}  // END UDP_Socket_Start()
-
-//-+-+-+-+-+-+-+-+-+-+-+PUBLIC FUNCTIONS+-+-+-+-+-+-+-+-+-+-+-+-+-+
+}  // END Handle_Timer()
 
 //+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+
-/// Constructor
+/// Gets the socket the owning loop polls
 //+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+
-Universal_Socket::Universal_Socket
-(
-   Socket_Vars::Protocol protocol_type,
-   Socket_Vars::Connection_Type connection_type,
-   std::string ip_address,
-   uint16_t port,
-   std::string name
-)
+SOCKET Universal_Socket::Get_Polled_Socket()
 {
-   //Initialize private variables
-   _protocol = protocol_type;
-   _connection = connection_type;
-   _ip_address = ip_address;
-   _port = port;
-   _socket_name = name;
-   _socket = INVALID_SOCKET;
-   _listen_socket = INVALID_SOCKET;
-   _is_socket_connected = false;
-   memset(&_address, 0, sizeof(SOCKADDR_IN));
-
-   // function level variables
-   int func_result = 0;
-   WORD wVersionRequested = MAKEWORD(2, 2);  // Request Winsock v2
-   WSADATA wsa_data;
-
    //
-   // 1. Retrieve details of Windows Sockets implementation
-   func_result = WSAStartup(wVersionRequested, &wsa_data);
-   if (0 != func_result)
+   // 1. A registered I/O socket with its peer attached polls nothing, an
+   //    accept left pending on the listen socket would keep a level
+   //    triggered poll ready on every pass, it is taken once the peer leaves
+   if (Socket_Vars::CONNECT_PENDING == _connect_state)
    {
-      printf("ERROR loading WinSock v2!\n");
+      return _socket;
    }
-
-   //
-   // 2. Create a new event and add it to the global list of socket events
-   HANDLE event = WSA_INVALID_EVENT;
-   if (!Socket_Vars::Add_Event_To_Event_List(event, _event_handle_index))
+   if (INVALID_SOCKET == _socket)
    {
-      printf("ERROR, too many events exist, failed creation of socket!\n");
+      return _listen_socket;
    }
+   if (Socket_Vars::REGISTERED_IO == _io_engine)
+   {
+      return INVALID_SOCKET;
+   }
+   return _socket;
+}  // END Get_Polled_Socket()
 
-}  // End Constructor
-
-//+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+    
-/// Opens the socket ready to receive and or send
 //+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+
-bool Universal_Socket::Start()
+/// Gets where a message without a destination of its own is sent
+//+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+
+SOCKADDR_INET Universal_Socket::Get_Send_Address()
 {
-   bool result = true;
+   SOCKADDR_INET address;
 
    //
-   // 1. Start the socket for the specified protocol and connection type
-   if (Socket_Vars::TCP == _protocol)
+   // 1. A unicast UDP socket answers the last sender it heard from
+   if (!_is_multicast)
    {
-      if (Socket_Vars::SERVER == _connection)
-      {
-         result &= TCP_Server_Start();
-      }
-      else if (Socket_Vars::CLIENT == _connection)
-      {
-         result &= TCP_Client_Start();
-      }
-      else
+      std::lock_guard<std::mutex> lock(_sender_lock);
+      if (0 != _last_sender.si_family)
       {
-         printf("Invalid connection type specified for TCP Socket!\n");
-         result &= false;
+         return _last_sender;
       }
    }
-   else if (Socket_Vars::UDP == _protocol)
-   {
-      result &= UDP_Socket_Start();
-   }
-   else
-   {
-      printf("Invalid protocol type specified for Socket!\n");
-      result &= false;
-   }
 
-   return result;
-}  // END Start()
+   //
+   // 2. Until then, and always for a group, the configured address
+   memset(&address, 0, sizeof(address));
+   memcpy(&address, Peer_Address(), Peer_Address_Size());
+
+   return address;
+}  // END Get_Send_Address()
 
 //+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+
-/// Handles the event that was triggered on this socket
+/// Appends every socket the event loop should poll
 //+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+
-bool Universal_Socket::Handle_Event()
+void Universal_Socket::Get_Poll_Sockets(std::vector<WSAPOLLFD>& poll_fds, std::vector<uint32_t>& connections, uint16_t loop)
 {
-   bool result = true;
-   int func_result;
-   WSANETWORKEVENTS networkEvents;
-   char* buffer;
-   static int send_count = 1;
+   WSAPOLLFD poll_fd;
+   poll_fd.events = POLLRDNORM;     // Covers accept, read and close
+   poll_fd.revents = 0;
 
    //
-   // 1. If _socket is not initialized yet, then the event fired for this socket
-   //    must be an accept, in which case it is on the _listen_socket
-   if (INVALID_SOCKET == _socket)
+   // 0. A registered I/O peer that left is closed on the owning loop, a
+   //    server goes back to accepting and a client backs off and reconnects
+   if (Socket_Vars::Get_Event_Loop(_event_handle_index) == loop && _is_peer_closed.exchange(false, std::memory_order_acq_rel))
+   {
+      Log::Write<Log::LEVEL_INFO>("%s Socket Disconnected!\n", _socket_name);
+      Reconnect();
+   }
+
+   //
+   // 1. The listen socket until a TCP client has been accepted, registered
+   //    I/O sockets complete on the engine so only accepts are polled,
+   //    only the loop owning the socket polls it
+   if (Socket_Vars::Get_Event_Loop(_event_handle_index) != loop)
    {
-      func_result = WSAEnumNetworkEvents(
-         _listen_socket,
-         Socket_Vars::socket_events[_event_handle_index],
-         &networkEvents
-      );
+      poll_fd.fd = INVALID_SOCKET;
    }
    else
    {
-      func_result = WSAEnumNetworkEvents(
-         _socket,
-         Socket_Vars::socket_events[_event_handle_index],
-         &networkEvents
-      );
+      poll_fd.fd = Get_Polled_Socket();
+      if (Socket_Vars::CONNECT_PENDING == _connect_state)
+      {
+         poll_fd.events = POLLWRNORM;  // A connect completes as writable
+      }
+      else if (_socket == poll_fd.fd && _is_waiting_writable.load(std::memory_order_acquire))
+      {
+         poll_fd.events = POLLRDNORM | POLLWRNORM;
+      }
    }
-
-   //
-   // 2. Check for socket error
-   if (SOCKET_ERROR == func_result)
+   if (INVALID_SOCKET != poll_fd.fd)
    {
-      printf("WSAEnumNetworkEvents() failed with: %u\n", WSAGetLastError());
-      result &= false;
-      return result;
+      poll_fds.push_back(poll_fd);
+      connections.push_back(Socket_Vars::NO_CONNECTION);
    }
+   poll_fd.events = POLLRDNORM;
 
    //
-   // 3. Event fired for this socket was a socket accept
-   if ((networkEvents.lNetworkEvents & FD_ACCEPT))
+   // 2. Every accepted client handed to this loop
+   if (nullptr != _connections)
    {
-      _socket = accept(_listen_socket, nullptr, nullptr);
-      if (INVALID_SOCKET == _socket) 
+      // The newly adopted are the last of the loop's list, their timers
+      // go on this loop's wheel
+      uint32_t adopted = _connections->Adopt(loop);
+      const std::vector<uint32_t>& active = _connections->Get_Active(loop);
+      for (size_t j = active.size() - adopted; j < active.size(); j++)
       {
-         printf("%s accept() failed with: %u!\n", _socket_name.c_str(), WSAGetLastError());
-         result &= false;
-         return result;
+         Arm_Connection_Timers(active[j], Socket_Vars::Get_Timer_Wheel(loop));
       }
-      printf("%s accept() succeeded!\n", _socket_name.c_str());
-      // If socket is connected and ready to send and receive, then
-      // set the flag to true
-      _is_socket_connected = true;
-   }
+      for (size_t j = 0; j < active.size(); )
+      {
+         Connection& state = _connections->Get(active[j]);
 
-   // 
-   // 4. Event fired for this socket was a socket accept
-   if ((networkEvents.lNetworkEvents & FD_READ))
-   {
-      result &= Receive(buffer);
-      std::string my_string = "Hey Client!";
-      my_string += std::to_string(send_count++);
-      Socket_Vars::send_queue[_event_handle_index].push(my_string);
+         // A subscriber too far behind on broadcasts is dropped, the last
+         // active connection is swapped into its position
+         if (state.is_too_slow.load(std::memory_order_acquire))
+         {
+            Drop_Connection(active[j]);
+            continue;
+         }
+         poll_fd.fd = state.socket;
+         poll_fd.events = state.is_waiting_writable.load(std::memory_order_acquire)
+            ? (POLLRDNORM | POLLWRNORM)
+            : POLLRDNORM;
+         poll_fds.push_back(poll_fd);
+         connections.push_back(active[j]);
+         j++;
+      }
    }
+}  // END Get_Poll_Sockets()
 
-   //
-   // 5. Event fired for this socket was a close
-   if ((networkEvents.lNetworkEvents & FD_CLOSE))
+//+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+
+/// Closes the connected socket after the peer left
+//+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+
+void Universal_Socket::Close_Connection()
+{
+   Log::Write<Log::LEVEL_INFO>("%s Socket Disconnected!\n", _socket_name);
+
+   if (Socket_Vars::REGISTERED_IO == _io_engine)
    {
-      printf("%s Socket Disconnected!\n", _socket_name.c_str());
-      std::thread reconnect_thread(&Universal_Socket::Reconnect, this);
-      reconnect_thread.detach();
+      Registered_IO::Unregister_Socket(_event_handle_index);
    }
 
-   return result;
-}  // END Handle_Event()
+   _is_socket_connected = false;
+   closesocket(_socket);
+   _socket = INVALID_SOCKET;
+}  // END Close_Connection()
 
 //+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+
-/// Sends a message over the socket
+/// Flags that a registered I/O peer left and wakes the owning loop
 //+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+
-bool Universal_Socket::Send(const char* buffer)
+void Universal_Socket::Signal_Peer_Closed()
+{
+   _is_peer_closed.store(true, std::memory_order_release);
+   Socket_Vars::Wake_Event_Loop(Socket_Vars::Get_Event_Loop(_event_handle_index));
+}  // END Signal_Peer_Closed()
+
+//+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+
+/// Closes the socket and schedules the next connect
+//+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+
+bool Universal_Socket::Reconnect()
 {
    bool result = true;
-   int bytes_sent;
-   int buffer_length;
-   
-   //
-   // 1. Get the length of the message
-   buffer_length = static_cast<int>(strlen(buffer));
+   uint32_t delay;
 
    //
-   // 2. Send the message
-   if (Socket_Vars::TCP == _protocol)
+   // 1. Close the socket and mark it as invalid
+   if (Socket_Vars::REGISTERED_IO == _io_engine && _is_socket_connected)
    {
-      bytes_sent = send(_socket, buffer, buffer_length, 0);
+      Registered_IO::Unregister_Socket(_event_handle_index);
    }
-   else   // UDP
+   if (INVALID_SOCKET != _socket)
    {
-      bytes_sent = sendto(_socket, buffer, buffer_length, 0, (SOCKADDR*)&_address, sizeof(_address));
+      closesocket(_socket);
+      _socket = INVALID_SOCKET;
    }
+   _is_socket_connected = false;
+   _connect_state = Socket_Vars::CONNECT_IDLE;
 
    //
-   // 3. Check if the send operation was successful
-   if (bytes_sent == SOCKET_ERROR) {
-      printf("%s Send() failed with error: %u\n", _socket_name.c_str(), WSAGetLastError());
-      result &= false;
+   // 2. A TCP server polls its listen socket again and accepts the next
+   //    client as it arrives, there is nothing to wait for
+   if (Socket_Vars::Is_Stream(_protocol) && Socket_Vars::SERVER == _connection)
+   {
+      Log::Write<Log::LEVEL_INFO>("%s Waiting for reconnection...\n", _socket_name);
+      return result;
    }
 
    //
-   // 4. Ensure all bytes were sent
-   if (bytes_sent != buffer_length) {
-      printf("%s Send() not all bytes were sent!\n", _socket_name.c_str());
-      result &= false;
+   // 3. Clients and UDP sockets back off, the delay doubles on every failed
+   //    attempt up to the most and half of it is random so peers dropped
+   //    together do not all retry together
+   if (_is_stopping.load(std::memory_order_acquire))
+   {
+      return result;
+   }
+   _stats->Add(Stats::RECONNECTS);
+   delay = _reconnect_max_delay;
+   if (_reconnect_attempts < 31 && (_reconnect_max_delay >> _reconnect_attempts) >= _reconnect_base_delay)
+   {
+      delay = _reconnect_base_delay << _reconnect_attempts;
    }
+   delay = (delay / 2) + static_cast<uint32_t>(_jitter() % ((delay / 2) + 1));
+   _reconnect_attempts++;
+
+   _deadline = std::chrono::steady_clock::now() + std::chrono::milliseconds(delay);
+   _connect_state = Socket_Vars::CONNECT_WAITING;
+   Log::Write<Log::LEVEL_INFO>("%s Reconnecting in %u ms...\n", _socket_name, delay);
 
    return result;
-}  // END Send()
+}  // END Reconnect()
 
 //+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+
-/// Opens the socket ready to receive and or send
+/// Puts the socket's deadline, idle and heartbeat timers on the wheel
 //+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+
-bool Universal_Socket::Receive(char* &buffer)
+void Universal_Socket::Arm_Timers(uint16_t loop)
 {
-   bool result = true;
-   int bytes_received = 0;
-   constexpr uint16_t MAX_RECV_SIZE{ 1024 };
-   char recv_buffer[MAX_RECV_SIZE];
-   int address_size = sizeof(_address);
+   int64_t delay;
+   bool is_linked;
+
+   if (Socket_Vars::Get_Event_Loop(_event_handle_index) != loop)
+   {
+      return;
+   }
+   Timers::Timer_Wheel& wheel = Socket_Vars::Get_Timer_Wheel(loop);
 
    //
-   // 1. Receive the message from the socket
-   if (Socket_Vars::TCP == _protocol)
+   // 1. A connect or backoff moves the deadline, its timer follows, a
+   //    timer that fired early is armed again for what is left
+   if (Socket_Vars::CONNECT_IDLE == _connect_state)
    {
-      bytes_received = recv(_socket, recv_buffer, MAX_RECV_SIZE - 1, 0);
+      wheel.Cancel(_deadline_timer);
+      _deadline_timer = 0;
    }
-   else   // UDP
+   else if (0 == _deadline_timer || _armed_deadline != _deadline)
    {
-      bytes_received = recvfrom(_socket, recv_buffer, MAX_RECV_SIZE - 1, 0, (SOCKADDR*)&_address, &address_size);
+      wheel.Cancel(_deadline_timer);
+      delay = std::chrono::ceil<std::chrono::milliseconds>(_deadline - std::chrono::steady_clock::now()).count();
+      _deadline_timer = wheel.Schedule(
+         static_cast<uint64_t>((std::max)(delay, int64_t{ 0 })),
+         Timer_Expired,
+         this,
+         (static_cast<uint64_t>(Socket_Vars::TIMER_DEADLINE) << 32) | Socket_Vars::NO_CONNECTION);
+      _armed_deadline = _deadline;
    }
-   if (bytes_received > 0)
+
+   //
+   // 2. A connected stream starts its idle and heartbeat timers, the poll
+   //    set is rebuilt every pass so a link that closed and came back is
+   //    never missed, timers of a closed link are dropped
+   is_linked = _is_socket_connected && Socket_Vars::Is_Stream(_protocol) && Socket_Vars::EVENT_SELECT == _io_engine;
+   if (!is_linked)
    {
-      //
-      // 2. Add a null-terminator to the end of the message
-      recv_buffer[bytes_received] = '\0';
-      buffer = recv_buffer;
-      printf("%s Receive() = %s\n", _socket_name.c_str(), buffer);
-      result &= true;
+      wheel.Cancel(_idle_timer);
+      wheel.Cancel(_heartbeat_timer);
+      _idle_timer = 0;
+      _heartbeat_timer = 0;
+      return;
    }
-   else if (0 == bytes_received) 
+   if (0 != _idle_timeout && 0 == _idle_timer)
    {
-      printf("%s Receive() 0 bytes, closing socket!\n", _socket_name.c_str());
-      result &= false;
+      _last_receive_tick = wheel.Get_Tick();
+      _idle_timer = wheel.Schedule(
+         _idle_timeout,
+         Timer_Expired,
+         this,
+         (static_cast<uint64_t>(Socket_Vars::TIMER_IDLE) << 32) | Socket_Vars::NO_CONNECTION);
    }
-   else {
-      printf("%s Receive() failed, closing socket!\n", _socket_name.c_str());
-      result &= false;
+   if (0 != _heartbeat_interval && 0 == _heartbeat_timer)
+   {
+      _heartbeat_timer = wheel.Schedule(
+         _heartbeat_interval,
+         Timer_Expired,
+         this,
+         (static_cast<uint64_t>(Socket_Vars::TIMER_HEARTBEAT) << 32) | Socket_Vars::NO_CONNECTION);
    }
-
-   return result;
-}  // END Receive()
+}  // END Arm_Timers()
 
 //+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+
-/// Reconnects the socket
+/// Cancels the socket's and its connections' timers on a loop
 //+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+
-bool Universal_Socket::Reconnect()
+void Universal_Socket::Cancel_Timers(uint16_t loop)
 {
-   bool result = true;
-   bool is_reconnecting = true;
-   int func_result;
-   WSANETWORKEVENTS networkEvents;
+   Timers::Timer_Wheel& wheel = Socket_Vars::Get_Timer_Wheel(loop);
 
    //
-   // 1. Close the socket and mark it as invalid
-   closesocket(_socket);
-   _socket = INVALID_SOCKET;
-   _is_socket_connected = false;
+   // 1. The socket's own timers are on its owning loop's wheel
+   if (Socket_Vars::Get_Event_Loop(_event_handle_index) == loop)
+   {
+      wheel.Cancel(_deadline_timer);
+      wheel.Cancel(_idle_timer);
+      wheel.Cancel(_heartbeat_timer);
+      _deadline_timer = 0;
+      _idle_timer = 0;
+      _heartbeat_timer = 0;
+   }
 
    //
-   // 2. Attempt to reconnect by listening for a new connection
-   //    this reconnect logic only applicable for TCP
-   while (is_reconnecting && Socket_Vars::TCP == _protocol)
+   // 2. Each accepted client's are on the wheel of the loop it was handed to
+   if (nullptr != _connections)
    {
-      printf("%s Waiting for reconnection...\n", _socket_name.c_str());
+      for (uint32_t connection : _connections->Get_Active(loop))
+      {
+         Connection& state = _connections->Get(connection);
+         wheel.Cancel(state.idle_timer);
+         wheel.Cancel(state.heartbeat_timer);
+         state.idle_timer = 0;
+         state.heartbeat_timer = 0;
+      }
+   }
+}  // END Cancel_Timers()
 
-      //
-      // 2a. Wait for the FD_ACCEPT event to be triggered
-      func_result = WSAWaitForMultipleEvents(
-         1,
-         &Socket_Vars::socket_events[_event_handle_index],
-         FALSE,
-         WSA_INFINITE, // Wait indefinitely for a new connection
-         FALSE
-      );
+//+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+
+/// Starts the next connect or gives up on a slow one
+//+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+
+bool Universal_Socket::Handle_Timeout(std::chrono::steady_clock::time_point now)
+{
+   bool result = true;
 
-      //
-      // 2b. Check for a failure
-      if (WSA_WAIT_FAILED == func_result)
+   if (now < _deadline || _is_stopping.load(std::memory_order_acquire))
+   {
+      return result;
+   }
+
+   //
+   // 1. A connect slower than the connect timeout is abandoned, WSAPoll()
+   //    may never report a connect that failed
+   if (Socket_Vars::CONNECT_PENDING == _connect_state)
+   {
+      Log::Write<Log::LEVEL_WARNING>("%s connect() timed out!\n", _socket_name);
+      result &= Reconnect();
+   }
+   //
+   // 2. The backoff passed, try again, a failed attempt backs off further
+   else if (Socket_Vars::CONNECT_WAITING == _connect_state)
+   {
+      _connect_state = Socket_Vars::CONNECT_IDLE;
+      if (Socket_Vars::UDP == _protocol)
       {
-         printf("%s WSAWaitForMultipleEvents() failed with: %u\n", _socket_name.c_str(), WSAGetLastError());
-         result &= false;
-         return result;
+         result &= UDP_Socket_Start();
       }
-
-      //
-      // 2c. Check if the event was for FD_ACCEPT
-      func_result = WSAEnumNetworkEvents(_listen_socket, Socket_Vars::socket_events[_event_handle_index], &networkEvents);
-      if (SOCKET_ERROR == func_result)
+      else
       {
-         printf("%s WSAEnumNetworkEvents() failed with: %u\n", _socket_name.c_str(), WSAGetLastError());
-         result &= false;
-         return result;
+         result &= Begin_Connect();
       }
-
-      //
-      // 2d. Event fired was a socket accept, accept the new connection and exit reconnection logic
-      if ((networkEvents.lNetworkEvents & FD_ACCEPT) &&
-         (0 == networkEvents.iErrorCode[FD_ACCEPT_BIT]))
+      if (!result)
       {
-         _socket = accept(_listen_socket, nullptr, nullptr);
-         if (INVALID_SOCKET == _socket)
-         {
-            printf("accept() failed with: %u!\n", WSAGetLastError());
-            continue; // Try again
-         }
-         else
-         {
-            printf("accept() succeeded! New client connected.\n");
-            _is_socket_connected = true;
-            is_reconnecting = false; // Exit the loop and return to normal processing
-         }
+         result = Reconnect();
       }
-   }  // END while is_reconnecting && TCP
-
-   //
-   // 3. Reconnection logic for UDP socket
-   if (Socket_Vars::UDP == _protocol)
-   {
-      result &= UDP_Socket_Start();
-   }  // END if UDP
+   }
 
    return result;
-}  // END Reconnect()
+}  // END Handle_Timeout()
 
 //+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+    
 /// Closes the socket
@@ -641,18 +3950,56 @@ bool Universal_Socket::Stop()
    int func_result;
 
    //
-   // 1. Shutdown the connection
-   func_result = shutdown(_socket, SD_SEND);
-   if (SOCKET_ERROR == func_result) {
-      printf("shutdown() failed with: %u\n", WSAGetLastError());
-      result &= false;
+   // 1. Shutdown the connection, a server may never have had a client
+   if (INVALID_SOCKET != _socket)
+   {
+      func_result = shutdown(_socket, SD_SEND);
+      if (SOCKET_ERROR == func_result) {
+         Log::Write<Log::LEVEL_ERROR>("shutdown() failed with: %u\n", WSAGetLastError());
+         result &= false;
+      }
    }
 
    //
-   // 2. Cleanup
-   WSACloseEvent(Socket_Vars::socket_events[_event_handle_index]);
+   // 2. Cleanup, the connection table closes every accepted client, a
+   //    shared memory link's thread is stopped before its channel goes
+   if (Socket_Vars::REGISTERED_IO == _io_engine)
+   {
+      Registered_IO::Unregister_Socket(_event_handle_index);
+   }
+   if (_channel_thread.joinable())
+   {
+      Cancel_Reconnect();
+      _channel_thread.join();
+   }
+   _channel.reset();
+   if (nullptr != _channel_stop_event)
+   {
+      CloseHandle(_channel_stop_event);
+      _channel_stop_event = nullptr;
+   }
+   _connections.reset();
+   WSACloseEvent(Socket_Vars::Get_Socket_Event(_event_handle_index));
    closesocket(_socket);
+   _socket = INVALID_SOCKET;
+   if (INVALID_SOCKET != _listen_socket)
+   {
+      closesocket(_listen_socket);
+      _listen_socket = INVALID_SOCKET;
+   }
    WSACleanup();
 
    return result;
-}  // END Stop()
\ No newline at end of file
+}  // END Stop()
+
+//+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+
+/// Checks nothing is handling the socket
+//+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+
+bool Universal_Socket::Is_Idle()
+{
+   if (_is_channel_running.load(std::memory_order_acquire) || !_context->strand.Is_Idle())
+   {
+      return false;
+   }
+   return nullptr == _connections || _connections->Is_Idle();
+}  // END Is_Idle()
\ No newline at end of file
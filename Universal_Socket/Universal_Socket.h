@@ -15,59 +15,481 @@
 //  ECE      08-14-2024   Added _is_socket_connected flag
 //  ECE      08-15-2024   Added getter for connection type
 //  ECE      08-16-2024   Implement UDP option
+//  ECE      10-17-2026   Removed MAX_EVENTS cap, added Get_Poll_Socket
+//  ECE      10-17-2026   Added Registered I/O engine option
+//  ECE      10-17-2026   Added Queue_Message and send wakeups
+//  ECE      10-17-2026   Lock free send and receive queues
+//  ECE      10-17-2026   TCP servers accept many clients into a connection table
+//  ECE      10-17-2026   Optional length prefixed framing, binary sends
+//  ECE      10-17-2026   Gathered batch sends with partial write resume
+//  ECE      10-17-2026   Batched UDP receives and segmented UDP sends
+//  ECE      10-17-2026   Received messages are pooled buffer views, no copies
+//  ECE      10-17-2026   Sockets and connections are sharded across event loops
+//  ECE      10-17-2026   Received messages are handled on the work stealing pool
+//  ECE      10-17-2026   Coroutine receive, send and accept
+//  ECE      10-17-2026   Sockets live in the registry, no MAX_SOCKETS ceiling
+//  ECE      10-17-2026   Non-blocking connect and reconnect with backoff, no threads
+//  ECE      10-17-2026   Send backlogs resumed when writable, send watermarks
+//  ECE      10-17-2026   Counters and latency histograms in the registry slot
+//  ECE      10-17-2026   Includes the asynchronous log
+//  ECE      10-17-2026   Added Set_Zero_Copy for large TCP client sends
+//  ECE      10-17-2026   Added Send_File, files streamed by TransmitFile
+//  ECE      10-17-2026   Added UNIX_STREAM protocol and Send_Socket
+//  ECE      10-17-2026   Added SHARED_MEMORY protocol and Set_Spin_Then_Block
+//  ECE      10-17-2026   Connects, backoffs, idle timeouts and heartbeats run on the timer wheel
+//  ECE      10-17-2026   Added Broadcast, Subscribe and a slow subscriber policy
+//  ECE      10-17-2026   IPv6 UDP sockets, multicast groups demultiplexed on receive
+//  ECE      10-17-2026   Queued messages are held in pooled buffers
+//  ECE      10-17-2026   Zero-copy clients keep the default send buffer
+//  ECE      10-17-2026   Added Send_Datagram_To, datagrams carry their sender to the handler
+//  ECE      10-17-2026   Zero-copy clients have no send buffer and send every message overlapped
+//  ECE      10-17-2026   Async sends park on a full queue instead of retrying
+//  ECE      10-17-2026   Added Queue_Datagram and Get_Send_Address, removed Send_Datagram_To
 //+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+
 
 #pragma once
 
+#include "Async_Task.h"
+#include "Buffer_Pool.h"
+#include "Connection_Table.h"
+#include "Lock_Free_Queue.h"
+#include "Message_Framing.h"
+#include "Shared_Memory.h"
+#include "Socket_Log.h"
+#include "Socket_Stats.h"
+#include "Timer_Wheel.h"
+#include "Work_Pool.h"
+
 #include <WinSock2.h>
 #include <WS2tcpip.h>
+#include <afunix.h>
+#include <MSWSock.h>
+#include <atomic>
+#include <chrono>
 #include <iostream>
+#include <memory>
 #include <string>
 #include <mutex>
-#include <queue>
+#include <random>
+#include <span>
+#include <thread>
+#include <vector>
 
 namespace Socket_Vars
 {
-   constexpr uint16_t MAX_EVENTS{ 100 };
-   constexpr uint16_t MAX_SOCKETS{ 100 };
+   // Most event loops, each one receiving and one sending thread
+   constexpr uint16_t MAX_EVENT_LOOPS{ 64 };
+
+   // Number of event loops sockets and accepted connections are spread
+   // across, set before the first socket is created
+   extern uint16_t event_loop_count;
+
+   // Most messages waiting on each socket's queues
+   constexpr size_t SEND_QUEUE_CAPACITY{ 1024 };
+   constexpr size_t RECEIVE_QUEUE_CAPACITY{ 1024 };
+
+   // Most messages popped and written per gathered send
+   constexpr size_t SEND_BATCH_SIZE{ 64 };
+
+   // Bytes queued on a socket before its producers are told to hold off,
+   // and told again once it drains to the low watermark, Queue_Message()
+   // refuses messages past the limit
+   constexpr size_t SEND_LOW_WATERMARK{ 256 * 1024 };
+   constexpr size_t SEND_HIGH_WATERMARK{ 1024 * 1024 };
+   constexpr size_t SEND_BUFFER_LIMIT{ 4 * 1024 * 1024 };
+
+   // Messages at least this long go out in a zero-copy send of their own,
+   // shorter ones are gathered several to a send
+   constexpr size_t ZERO_COPY_THRESHOLD{ 64 * 1024 };
+
+   // Zero-copy sends a socket keeps in flight, with no send buffer each one
+   // waits on the peer's ACK, so the next ones are queued behind it and the
+   // link does not idle between them
+   constexpr size_t ZERO_COPY_MAX_IN_FLIGHT{ 8 };
+
+   // Bytes of a file sent per TransmitFile() call, the socket goes back to
+   // its sending thread's schedule between chunks so others get a turn
+   constexpr DWORD FILE_CHUNK_SIZE{ 1024 * 1024 };
+
+   // Largest datagram received into each slot of a batched UDP socket
+   constexpr size_t UDP_SLOT_SIZE{ 4096 };
+
+   // Most bytes coalesced into one segmented UDP send
+   constexpr size_t UDP_COALESCE_LIMIT{ 65000 };
+
+   // Hops a multicast datagram is sent for, 1 keeps it on the local subnet
+   constexpr uint8_t MULTICAST_TTL{ 1 };
+
+   // A multicast group a UDP socket joined, keyed by the group's address as
+   // IPv6 bytes, an IPv4 group mapped to ::ffff:a.b.c.d, a socket's groups
+   // are kept sorted by key for its receiving thread to search
+   struct Multicast_Group
+   {
+      uint8_t key[16];
+      uint32_t interface_index;        // Interface joined on, 0 for the system's choice
+      uint32_t group;                  // Id handed to the handler with each datagram
+   };
+   typedef std::vector<Multicast_Group> Multicast_Groups;
 
-   // List of all socket event handles
-   extern HANDLE socket_events[MAX_EVENTS];
+   // Delay before the first reconnect attempt, doubled on every failed
+   // attempt up to the most, in milliseconds
+   constexpr uint32_t RECONNECT_BASE_DELAY{ 100 };
+   constexpr uint32_t RECONNECT_MAX_DELAY{ 30000 };
 
-   // Number of events in the socket_events list
-   extern uint16_t event_count;
+   // Longest a non-blocking connect may take before it is retried, in milliseconds
+   constexpr uint32_t CONNECT_TIMEOUT{ 5000 };
 
-   // Mutexs for send and receive queues
-   extern std::mutex receive_mutex[MAX_SOCKETS];
-   extern std::mutex send_mutex[MAX_SOCKETS];
+   // Every message handled is logged at LEVEL_DEBUG while true, turned off
+   // when measuring, release builds compile the logging out
+   extern bool print_messages;
 
-   // Receive and send queues for each socket,
-   // if you have a message to be sent, place it on the send queue
-   // if a message is received, it will be placed on the receive queue
-   extern std::queue<std::string> receive_queue[MAX_SOCKETS];
-   extern std::queue<std::string> send_queue[MAX_SOCKETS];
+   // Signaled whenever a socket is scheduled on an event loop,
+   // the loop's sending thread sleeps on it while nothing is scheduled
+   extern HANDLE send_wake_events[MAX_EVENT_LOOPS];
 
    enum Protocol : uint8_t
    {
-      TCP   = 1,
-      UDP   = 2
+      TCP         = 1,
+      UDP         = 2,
+      UNIX_STREAM = 3,  // AF_UNIX between processes on this host, ip_address is the path
+      SHARED_MEMORY = 4 // Rings in a mapping shared with one process on this host,
+                        // ip_address names the mapping, no socket underneath
    };
 
+   // TCP and UNIX_STREAM are byte streams, framed, connected and accepted
+   inline bool Is_Stream(Protocol protocol) { return TCP == protocol || UNIX_STREAM == protocol; }
+
    enum Connection_Type : uint8_t
    {
       CLIENT  = 1,
       SERVER  = 2
    };
 
+   enum IO_Engine : uint8_t
+   {
+      EVENT_SELECT   = 1,  // WSAEventSelect + recv/send per message
+      REGISTERED_IO  = 2   // Registered I/O, posted receives and batched sends
+   };
+
+   enum Connect_State : uint8_t
+   {
+      CONNECT_IDLE      = 1,  // Connected, listening or bound
+      CONNECT_WAITING   = 2,  // Backing off until the next attempt
+      CONNECT_PENDING   = 3   // Non-blocking connect in progress
+   };
+
+   enum Timer_Kind : uint8_t
+   {
+      TIMER_DEADLINE    = 1,  // Connect backoff or connect timeout
+      TIMER_IDLE        = 2,  // Nothing received for the idle timeout
+      TIMER_HEARTBEAT   = 3   // Next heartbeat is due
+   };
+
+   struct Message_Context;
+
+   // Called with true when a socket's queued bytes reach its high watermark
+   // and with false once they drain to its low watermark, on the thread that
+   // crossed it, so it must not block
+   typedef void (*Watermark_Handler)(uint32_t socket_index, bool is_throttled);
+
+   //+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+
+   /// @brief   co_await of an async send, queues the message at
+   /// @brief   once, on a full queue the awaiter is parked until
+   /// @brief   the sending thread makes room, no thread waits
+   //+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+
+   class Send_Awaiter : public Work_Pool::Task
+   {
+   public:
+
+      Send_Awaiter(Message_Context* context, uint32_t connection, std::span<const char> message);
+
+      bool await_ready() { return Try_Queue(); }
+      bool await_suspend(std::coroutine_handle<> handle);
+      bool await_resume() { return _result; }
+
+      void Run() override;
+
+   private:
+
+      Message_Context* _context;
+      uint32_t _connection;
+      Buffers::Buffer_View _message;
+      bool _result;
+      std::coroutine_handle<> _handle;
+
+      //+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+
+      /// @brief   Queues the message and wakes its sending thread
+      /// @return  bool              True once done, _result says how
+      //+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+
+      bool Try_Queue();
+
+      //+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+
+      /// @brief   Tries once more, then parks on the waiters of the
+      /// @brief   full queue, Run() tries again when it is woken
+      /// @return  bool              True if parked, false once done
+      //+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+
+      bool Park();
+
+   };  // END class Send_Awaiter
+
+   //+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+
+   /// @brief   One accepted client of an async TCP server, as
+   /// @brief   handed out by Async_Accept()
+   //+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+
+   class Async_Connection
+   {
+   public:
+
+      Async_Connection() : _context(nullptr), _connection(NO_CONNECTION) {}
+      Async_Connection(Message_Context* context, uint32_t connection) : _context(context), _connection(connection) {}
+
+      //+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+
+      /// @brief   Awaits the client's next message, one coroutine
+      /// @brief   at a time, a CONNECTION_CLOSED event comes after
+      /// @brief   the last message
+      /// @return  Awaiter           co_await it for a Received_Message
+      //+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+
+      Async::Channel<Received_Message>::Awaiter Async_Receive();
+
+      //+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+
+      /// @brief   Sends a message to the client
+      /// @param   std::span         Message, copied onto the send queue
+      /// @return  Send_Awaiter      co_await it, false if the client left
+      //+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+
+      Send_Awaiter Async_Send(std::span<const char> message) { return Send_Awaiter(_context, _connection, message); }
+
+      inline uint32_t Get_Connection() const { return _connection; }
+
+   private:
+
+      Message_Context* _context;
+      uint32_t _connection;
+
+   };  // END class Async_Connection
+
+   // Called on a handler pool worker for every message a socket receives,
+   // messages of one socket, or of one accepted connection, are handled one
+   // at a time in the order they arrived, the view is released afterwards
+   typedef void (*Message_Handler)(Message_Context& context, Received_Message& received);
+
+   // What a message handler needs to know about the socket and to reply,
+   // allocated once per socket, strands and coroutines keep its address
+   struct Message_Context
+   {
+      uint32_t socket_index;
+      std::string socket_name;
+      Connection_Table* connections;   // Accepted clients of a TCP server, or nullptr
+      Message_Handler handler;
+      Message_Strand strand;           // Messages not on an accepted connection
+      Stats::Socket_Stats* stats;      // The socket's, in its registry slot
+      bool is_async;                   // Connection events are posted, see Set_Async()
+      Async::Channel<Received_Message> received;      // Messages not on a connection, when async
+      Async::Channel<Async_Connection> accepted;      // Clients of an async TCP server
+   };
+
    //+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+
    /// @brief   When creating a socket, an event HANDLE must
-   /// @brief   also be created and added to the socket_events
-   /// @brief   list, this manages that
-   /// @param   HANDLE            event to be added to socket_events
-   /// @param   uint16_t          returning index where event was added
+   /// @brief   also be created and given a registry slot, this
+   /// @brief   manages that
+   /// @param   HANDLE            event to be stored in the slot
+   /// @param   uint32_t          returning index of the slot taken
    /// @return  bool              Result of the addition
    //+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+
-   extern bool Add_Event_To_Event_List(HANDLE& event, uint16_t& event_list_index);
+   extern bool Add_Event_To_Event_List(HANDLE& event, uint32_t& event_list_index);
+
+   //+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+
+   /// @brief   Gets a socket's event HANDLE from its slot
+   /// @param   uint32_t          Index of the socket's queues
+   /// @return  HANDLE&           Event of the socket
+   //+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+
+   extern HANDLE& Get_Socket_Event(uint32_t socket_index);
+
+   //+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+
+   /// @brief   Gets a socket's send queue, if you have a message
+   /// @brief   to be sent, place it on the queue with Queue_Message(),
+   /// @brief   only the Socket_Sending_Thread pops it
+   /// @param   uint32_t          Index of the socket's queues
+   /// @return  MPSC_Queue&       Send queue of the socket
+   //+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+
+   extern Lock_Free::MPSC_Queue<Queued_Send>& Get_Send_Queue(uint32_t socket_index);
+
+   //+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+
+   /// @brief   Places a message on a socket's send queue and
+   /// @brief   wakes the sending thread
+   /// @param   uint32_t          Index of the socket's queues
+   /// @param   Buffer_View       Message to be sent, in a pooled buffer
+   /// @return  bool              False if the send queue is full
+   //+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+
+   extern bool Queue_Message(uint32_t socket_index, Buffers::Buffer_View message);
+
+   //+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+
+   /// @brief   Copies a message into the send pool and queues it
+   /// @param   uint32_t          Index of the socket's queues
+   /// @param   std::string       Message to be sent
+   /// @return  bool              False if the send queue is full
+   //+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+
+   extern bool Queue_Message(uint32_t socket_index, const std::string& message);
+
+   //+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+
+   /// @brief   Places a datagram for the given address on a UDP
+   /// @brief   socket's send queue and wakes the sending thread,
+   /// @brief   Reply() uses it to answer a datagram's sender
+   /// @param   uint32_t          Index of the socket's queues
+   /// @param   SOCKADDR_INET     Address to send to
+   /// @param   Buffer_View       Datagram to be sent, in a pooled buffer
+   /// @return  bool              False if the send queue is full
+   //+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+
+   extern bool Queue_Datagram(uint32_t socket_index, const SOCKADDR_INET& destination, Buffers::Buffer_View message);
+
+   //+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+
+   /// @brief   Checks whether a socket's queued bytes passed its
+   /// @brief   high watermark and have not yet drained to its low
+   /// @param   uint32_t          Index of the socket's queues
+   /// @return  bool              True while producers should hold off
+   //+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+
+   extern bool Is_Send_Throttled(uint32_t socket_index);
+
+   //+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+
+   /// @brief   Takes bytes popped from a socket's send queue off
+   /// @brief   its count, the socket's sending thread only
+   /// @param   uint32_t          Index of the socket's queues
+   /// @param   size_t            Bytes popped
+   /// @return  None
+   //+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+
+   extern void Release_Send_Bytes(uint32_t socket_index, size_t bytes);
+
+   //+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+
+   /// @brief   Opens the socket a peer passed with Send_Socket(),
+   /// @brief   from the message it arrived in
+   /// @param   char*             Received message
+   /// @param   size_t            Length of the message
+   /// @return  SOCKET            Socket now owned by this process, or
+   /// @return  SOCKET            INVALID_SOCKET if it was not one
+   //+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+
+   extern SOCKET Open_Passed_Socket(const char* message, size_t length);
+
+   //+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+
+   /// @brief   Places a message on one of a TCP server's accepted
+   /// @brief   connections and wakes the sending thread of its loop
+   /// @param   uint32_t          Index of the server's queues
+   /// @param   Connection_Table* Server's accepted clients
+   /// @param   uint32_t          Connection index
+   /// @param   Buffer_View       Message to be sent, in a pooled buffer
+   /// @return  bool              False if the connection is closed or full
+   //+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+
+   extern bool Queue_Connection_Message(
+      uint32_t socket_index,
+      Connection_Table* connections,
+      uint32_t connection,
+      Buffers::Buffer_View message);
+
+   //+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+
+   /// @brief   Replies to a received message, to the accepted
+   /// @brief   connection it arrived on or else to the socket's peer,
+   /// @brief   safe from any handler
+   /// @param   Message_Context   Context the handler was called with
+   /// @param   Received_Message  Message being replied to
+   /// @param   Buffer_View       Reply to be sent, in a pooled buffer
+   /// @return  bool              False if the reply could not be queued
+   //+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+
+   extern bool Reply(Message_Context& context, const Received_Message& received, Buffers::Buffer_View message);
+
+   //+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+
+   /// @brief   Copies a reply into the send pool and queues it
+   /// @param   Message_Context   Context the handler was called with
+   /// @param   Received_Message  Message being replied to
+   /// @param   std::string       Reply to be sent
+   /// @return  bool              False if the reply could not be queued
+   //+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+
+   extern bool Reply(Message_Context& context, const Received_Message& received, const std::string& message);
+
+   //+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+
+   /// @brief   Handler every socket starts with, logs the message
+   /// @brief   when print_messages is set and replies to the sender
+   /// @param   Message_Context   Context of the receiving socket
+   /// @param   Received_Message  Message, not null-terminated
+   /// @return  None
+   //+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+
+   extern void Default_Message_Handler(Message_Context& context, Received_Message& received);
+
+   //+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+
+   /// @brief   Handler of an async socket, delivers each message
+   /// @brief   to the channel a coroutine awaits it on, and each
+   /// @brief   accepted client to the socket's accepted channel
+   /// @param   Message_Context   Context of the receiving socket
+   /// @param   Received_Message  Message or connection event, moved out
+   /// @return  None
+   //+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+
+   extern void Async_Message_Handler(Message_Context& context, Received_Message& received);
+
+   //+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+
+   /// @brief   Gets the event loop that polls and sends for a socket
+   /// @param   uint32_t          Index of the socket's queues
+   /// @return  uint16_t          Event loop
+   //+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+
+   inline uint16_t Get_Event_Loop(uint32_t socket_index) { return static_cast<uint16_t>(socket_index % event_loop_count); }
+
+   //+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+
+   /// @brief   Schedules a socket for an event loop's sending
+   /// @brief   thread, a socket already scheduled on the loop is
+   /// @brief   not added twice
+   /// @param   uint32_t          Index of the socket's queues
+   /// @param   uint16_t          Event loop to send on
+   /// @return  None
+   //+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+
+   extern void Schedule_Send(uint32_t socket_index, uint16_t loop);
+
+   //+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+
+   /// @brief   Schedules a socket on the event loop that owns it
+   /// @param   uint32_t          Index of the socket's queues
+   /// @return  None
+   //+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+
+   inline void Schedule_Send(uint32_t socket_index) { Schedule_Send(socket_index, Get_Event_Loop(socket_index)); }
+
+   //+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+
+   /// @brief   Takes every socket scheduled on an event loop,
+   /// @brief   that loop's sending thread only
+   /// @param   uint16_t          Event loop
+   /// @param   std::vector       Returning indexes of scheduled sockets
+   /// @return  None
+   //+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+
+   extern void Take_Scheduled_Sends(uint16_t loop, std::vector<uint32_t>& socket_indexes);
+
+   //+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+
+   /// @brief   Opens the loopback socket other threads wake an
+   /// @brief   event loop's WSAPoll() with, that loop's receiving
+   /// @brief   thread only, before it first polls
+   /// @param   uint16_t          Event loop
+   /// @return  SOCKET            Wake socket to poll, or INVALID_SOCKET
+   //+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+
+   extern SOCKET Open_Event_Loop(uint16_t loop);
+
+   //+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+
+   /// @brief   Wakes an event loop blocked in WSAPoll() so it
+   /// @brief   rebuilds its poll set, only the first wake since
+   /// @brief   the loop last woke sends anything
+   /// @param   uint16_t          Event loop
+   /// @return  None
+   //+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+
+   extern void Wake_Event_Loop(uint16_t loop);
+
+   //+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+
+   /// @brief   Rearms Wake_Event_Loop() and drains the wake
+   /// @brief   socket, that loop's receiving thread only
+   /// @param   uint16_t          Event loop
+   /// @return  None
+   //+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+
+   extern void Clear_Event_Loop_Wake(uint16_t loop);
+
+   //+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+
+   /// @brief   Gets an event loop's timer wheel, connect and
+   /// @brief   backoff deadlines, idle timeouts and heartbeats of
+   /// @brief   the loop's sockets and connections wait on it, that
+   /// @brief   loop's receiving thread only
+   /// @param   uint16_t          Event loop
+   /// @return  Timer_Wheel&      The loop's wheel
+   //+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+
+   extern Timers::Timer_Wheel& Get_Timer_Wheel(uint16_t loop);
 
 }	// END namespace Socket_Vars
 
@@ -76,7 +498,8 @@ class Universal_Socket
 public:
 
    //+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+
-   /// @brief   Constructor
+   /// @brief   Constructor, sockets are made with Create() of
+   /// @brief   Socket_Vars::Sockets() so they never move
    //+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+
    Universal_Socket(
       Socket_Vars::Protocol protocol_type,
@@ -93,30 +516,272 @@ public:
 
    //+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+
    /// @brief   Handles the event that was triggered on this socket
+   /// @param   short             Events WSAPoll() returned for it
+   /// @return  bool              Result of the event handle
+   //+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+
+   bool Handle_Event(short revents);
+
+   //+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+
+   /// @brief   Handles the event that was triggered on one of a
+   /// @brief   TCP server's accepted connections
+   /// @param   uint32_t          Connection index
+   /// @param   short             Events WSAPoll() returned for it
    /// @return  bool              Result of the event handle
    //+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+
-   bool Handle_Event();
+   bool Handle_Connection_Event(uint32_t connection, short revents);
 
    //+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+
-   /// @brief   Sends a message over the socket
+   /// @brief   Queues a message to be sent over the socket
    /// @param   unsigned char*    Buffer containing the message
-   /// @return  bool              Result of the send
+   /// @return  bool              False if the message was refused
    //+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+
    bool Send(const char* buffer);
 
    //+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+
-   /// @brief   Opens the socket ready to receive and or send
-   /// @param   unsigned char*    Buffer where message will be put in
-   /// @return  bool              Result of the receive
+   /// @brief   Queues a binary message to be sent over the socket,
+   /// @brief   framed with a length prefix when framing is set
+   /// @param   char*             Buffer containing the message
+   /// @param   size_t            Length of the message
+   /// @return  bool              False if the message was refused
+   //+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+
+   bool Send(const char* buffer, size_t length);
+
+   //+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+
+   /// @brief   Queues part of a file to be sent over a TCP client
+   /// @brief   by TransmitFile(), the kernel reads it straight into
+   /// @brief   the socket FILE_CHUNK_SIZE bytes at a time, it goes
+   /// @brief   once the messages queued ahead of it have been sent
+   /// @brief   and is one message when framing is set
+   /// @param   std::string       Path of the file
+   /// @param   uint64_t          First byte of the file to send
+   /// @param   uint64_t          Bytes to send, 0 for the rest of the file
+   /// @param   File_Progress_Handler Told after every chunk, or nullptr
+   /// @return  bool              False if the file was refused
+   //+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+
+   bool Send_File(const std::string& path, uint64_t offset = 0, uint64_t length = 0, Socket_Vars::File_Progress_Handler handler = nullptr);
+
+   //+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+
+   /// @brief   Passes a socket to the process at the other end of
+   /// @brief   a framed UNIX_STREAM client, duplicated for it by
+   /// @brief   WSADuplicateSocket(), the peer opens it with
+   /// @brief   Socket_Vars::Open_Passed_Socket()
+   /// @param   SOCKET            Socket to pass, still this process's own
+   /// @return  bool              False if it could not be passed
+   //+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+
+   bool Send_Socket(SOCKET handle);
+
+   //+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+
+   /// @brief   Starts the next queued file once nothing else waits
+   /// @brief   to be sent, the socket's sending thread only
+   /// @return  bool              Result of the send
+   //+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+
+   bool Send_Queued_File();
+
+   //+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+
+   /// @brief   Sends a batch of messages, a TCP batch is gathered
+   /// @brief   into a single WSASend() call, a UDP message without
+   /// @brief   a destination goes to Get_Send_Address(), what a full
+   /// @brief   socket buffer leaves waits in the send backlog, the
+   /// @brief   socket's sending thread only
+   /// @param   Queued_Send*      Messages popped from the send queue,
+   /// @param   Queued_Send*      they are moved from
+   /// @param   size_t            Number of messages, up to SEND_BATCH_SIZE
+   /// @return  bool              Result of the send
+   //+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+
+   bool Send_Batch(Socket_Vars::Queued_Send* queued, size_t count);
+
+   //+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+
+   /// @brief   Sends a message to every accepted connection of a
+   /// @brief   server subscribed to the group. It is framed once
+   /// @brief   into a shared buffer and each subscriber queues only
+   /// @brief   a reference, a subscriber BROADCAST_QUEUE_CAPACITY
+   /// @brief   behind is handled by the slow subscriber policy,
+   /// @brief   safe from any thread
+   /// @param   uint32_t          Group, or BROADCAST_ALL for every connection
+   /// @param   const char*       Message to be sent
+   /// @param   size_t            Length of the message
+   /// @return  bool              False if the message could not be broadcast
+   //+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+
+   bool Broadcast(uint32_t group, const char* buffer, size_t length);
+   inline bool Broadcast(uint32_t group, const std::string& message) { return Broadcast(group, message.data(), message.size()); }
+
+   //+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+
+   /// @brief   Subscribes an accepted connection to a broadcast
+   /// @brief   group, or unsubscribes it, a new connection is in
+   /// @brief   no group, safe from any thread
+   /// @param   uint32_t          Connection, as handed to the handler
+   /// @param   uint32_t          Group, under MAX_BROADCAST_GROUPS
+   /// @return  bool              False if the connection is closed
    //+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+
-   bool Receive(char* &buffer);
+   bool Subscribe(uint32_t connection, uint32_t group);
+   bool Unsubscribe(uint32_t connection, uint32_t group);
 
    //+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+
-   /// @brief   Reconnects the socket
+   /// @brief   Sets what happens to a subscriber too far behind on
+   /// @brief   broadcasts, SLOW_DROP by default
+   /// @param   Slow_Policy       Drop the broadcast or the connection
+   /// @return  None
+   //+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+
+   inline void Set_Slow_Subscriber_Policy(Socket_Vars::Slow_Policy policy) { _slow_policy = policy; }
+
+   //+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+
+   /// @brief   Joins a UDP socket to a multicast group of its own
+   /// @brief   family, every datagram sent to the group is handed
+   /// @brief   to the handler with the id returned, joins made
+   /// @brief   before Start() are made once the socket is bound,
+   /// @brief   safe from any thread
+   /// @param   std::string       Group address, 239.1.2.3 or ff15::1
+   /// @param   uint32_t          Interface index, 0 for the system's choice
+   /// @return  uint32_t          Group id, or NO_GROUP if it could not join
+   //+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+
+   uint32_t Join_Group(const std::string& group_address, uint32_t interface_index = 0);
+
+   //+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+
+   /// @brief   Leaves a multicast group Join_Group() joined, safe
+   /// @brief   from any thread
+   /// @param   uint32_t          Group id
+   /// @return  bool              False if the group was not joined
+   //+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+
+   bool Leave_Group(uint32_t group);
+
+   //+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+
+   /// @brief   Sets how a UDP socket whose ip_address is a group
+   /// @brief   sends to it, must be called before Start(), by
+   /// @brief   default the system's interface, MULTICAST_TTL and
+   /// @brief   looped back to this host
+   /// @param   uint32_t          Interface index, 0 for the system's choice
+   /// @param   uint8_t           Hops, the TTL of IPv4
+   /// @param   bool              True to receive our own datagrams
+   /// @return  None
+   //+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+
+   inline void Set_Multicast_Options(uint32_t interface_index, uint8_t ttl, bool is_loopback)
+   {
+      _multicast_interface = interface_index;
+      _multicast_ttl = ttl;
+      _is_multicast_loopback = is_loopback;
+   }
+
+   //+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+
+   /// @brief   Writes what is left in the send backlog, the event
+   /// @brief   loop schedules the socket again once it is writable
+   /// @brief   if it still does not fit, the sending thread only
+   /// @return  bool              Result of the send
+   //+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+
+   bool Flush_Send_Backlog();
+
+   //+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+
+   /// @brief   Checks for bytes waiting on a full socket buffer,
+   /// @brief   nothing more is popped to send until they are written,
+   /// @brief   zero-copy sends in flight leave room for more
+   /// @return  bool              True if nothing more may be popped
+   //+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+
+   inline bool Has_Send_Backlog()
+   {
+      return !_backlog.Is_Empty()
+         && !(_backlog.Is_Waiting_Completion()
+              && nullptr == _backlog.file
+              && _backlog.messages.empty()
+              && Socket_Vars::ZERO_COPY_MAX_IN_FLIGHT > _backlog.zero_copy.size());
+   }
+
+   //+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+
+   /// @brief   Sends everything queued for a TCP server's accepted
+   /// @brief   connections on one event loop, messages queued on
+   /// @brief   the server itself are broadcast to every connection,
+   /// @brief   that loop's Socket_Sending_Thread only
+   /// @param   uint16_t          Event loop
+   /// @return  bool              Result of the sends
+   //+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+
+   bool Send_Connections(uint16_t loop);
+
+   //+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+
+   /// @brief   Closes the socket after the peer left or a connect
+   /// @brief   failed, a TCP server goes back to accepting while
+   /// @brief   clients and UDP sockets back off and try again from
+   /// @brief   Handle_Timeout(), that loop's receiving thread only
    /// @return  bool              Result of the reconnection
    //+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+
    bool Reconnect();
 
+   //+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+
+   /// @brief   Puts the socket's connect or backoff deadline on
+   /// @brief   the loop's timer wheel once it changes, and starts
+   /// @brief   the idle and heartbeat timers once it connects,
+   /// @brief   that loop's receiving thread only, before every poll
+   /// @param   uint16_t          Event loop asking
+   /// @return  None
+   //+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+
+   void Arm_Timers(uint16_t loop);
+
+   //+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+
+   /// @brief   Cancels every timer the socket and its connections
+   /// @brief   have on a loop's wheel, the socket is leaving it,
+   /// @brief   that loop's receiving thread only
+   /// @param   uint16_t          Event loop being left
+   /// @return  None
+   //+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+
+   void Cancel_Timers(uint16_t loop);
+
+   //+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+
+   /// @brief   Starts the next connect once the backoff has passed,
+   /// @brief   or gives up on a connect slower than the connect
+   /// @brief   timeout, run by the deadline's timer on the loop's
+   /// @brief   receiving thread
+   /// @param   time_point        Time now
+   /// @return  bool              Result of the attempt
+   //+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+
+   bool Handle_Timeout(std::chrono::steady_clock::time_point now);
+
+   //+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+
+   /// @brief   Handles a complete message received on this socket,
+   /// @brief   the view is posted to the strand of the socket or of
+   /// @brief   the connection it arrived on, not copied
+   /// @param   Buffer_View       Message, not null-terminated
+   /// @param   SOCKADDR_INET*    Sender a reply goes back to, and the
+   /// @param   SOCKADDR_INET*    socket's send address, or nullptr
+   /// @param   uint32_t          Accepted connection it arrived on
+   /// @param   uint32_t          Multicast group it arrived on
+   /// @return  None
+   //+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+
+   void Handle_Message(
+      const Buffers::Buffer_View& message,
+      const SOCKADDR_INET* sender = nullptr,
+      uint32_t connection = Socket_Vars::NO_CONNECTION,
+      uint32_t group = Socket_Vars::NO_GROUP);
+
+   //+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+
+   /// @brief   Places a message on one accepted connection's queue
+   /// @brief   and wakes the sending thread of its event loop
+   /// @param   uint32_t          Connection index
+   /// @param   Buffer_View       Message to be sent, in a pooled buffer
+   /// @return  bool              False if the connection is closed or full
+   //+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+
+   bool Queue_Connection_Message(uint32_t connection, Buffers::Buffer_View message);
+
+   //+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+
+   /// @brief   Copies a message into the send pool and queues it
+   /// @brief   on one accepted connection
+   /// @param   uint32_t          Connection index
+   /// @param   std::string       Message to be sent
+   /// @return  bool              False if the connection is closed or full
+   //+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+
+   bool Queue_Connection_Message(uint32_t connection, const std::string& message);
+
+   //+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+
+   /// @brief   Closes the connected socket after the peer left,
+   /// @brief   a TCP server keeps listening for the next client
+   /// @return  None
+   //+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+
+   void Close_Connection();
+
+   //+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+
+   /// @brief   Flags that a registered I/O peer left and wakes the
+   /// @brief   owning loop, which closes the socket and reconnects
+   /// @brief   or goes back to accepting, safe from any thread
+   /// @return  None
+   //+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+
+   void Signal_Peer_Closed();
+
    //+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+
    /// @brief   Closes the socket
    /// @return  bool       Result of the closing of the socket
@@ -124,10 +789,46 @@ public:
    bool Stop();
 
    //+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+
-   /// @brief   Fetches the current connection status
+   /// @brief   Makes a reconnect in progress, or started later,
+   /// @brief   give up, the socket is being destroyed
+   /// @return  None
+   //+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+
+   inline void Cancel_Reconnect()
+   {
+      _is_stopping.store(true, std::memory_order_release);
+      if (nullptr != _channel_stop_event)
+      {
+         SetEvent(_channel_stop_event);
+      }
+   }
+
+   //+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+
+   /// @brief   Checks no message of the socket or its connections
+   /// @brief   waits on a strand
+   /// @return  bool              True once the socket can be deleted
+   //+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+
+   bool Is_Idle();
+
+   //+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+
+   /// @brief   Fetches the current connection status, a server
+   /// @brief   with a connection table is connected to any client
    /// @return  bool              _is_socket_connected
    //+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+
-   inline bool Is_Socket_Connected() { return _is_socket_connected; }
+   inline bool Is_Socket_Connected()
+   {
+      if (nullptr != _connections)
+      {
+         return 0 < _connections->Get_Active_Count();
+      }
+      return _is_socket_connected;
+   }
+
+   //+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+
+   /// @brief   Checks whether this is a TCP server that keeps its
+   /// @brief   accepted clients in a connection table
+   /// @return  bool              True if _connections exists
+   //+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+
+   inline bool Has_Connections() { return nullptr != _connections; }
 
    //+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+
    /// @brief   Gets Client or Server connection type
@@ -135,19 +836,339 @@ public:
    //+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+
    inline Socket_Vars::Connection_Type Get_Connection_Type() { return _connection; }
 
+   //+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+
+   /// @brief   Gets the name or short description of the socket
+   /// @return  std::string&      _socket_name
+   //+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+
+   inline const std::string& Get_Socket_Name() { return _socket_name; }
+
+   //+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+
+   /// @brief   Appends every socket an event loop should poll,
+   /// @brief   the listen socket or _socket first on the loop that
+   /// @brief   owns it, then each accepted connection handed to
+   /// @brief   the loop, that loop's receiving thread only
+   /// @param   std::vector       Poll entries to append to
+   /// @param   std::vector       Connection index of each entry appended
+   /// @param   uint16_t          Event loop
+   /// @return  None
+   //+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+
+   void Get_Poll_Sockets(std::vector<WSAPOLLFD>& poll_fds, std::vector<uint32_t>& connections, uint16_t loop);
+
+   //+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+
+   /// @brief   Selects the I/O engine, must be called before Start()
+   /// @param   IO_Engine         Engine used for receives and sends
+   /// @return  None
+   //+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+
+   inline void Set_IO_Engine(Socket_Vars::IO_Engine io_engine) { _io_engine = io_engine; }
+
+   //+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+
+   /// @brief   Gets the I/O engine used by this socket
+   /// @return  IO_Engine         _io_engine
+   //+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+
+   inline Socket_Vars::IO_Engine Get_IO_Engine() { return _io_engine; }
+
+   //+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+
+   /// @brief   Sets the handler run on the handler pool for every
+   /// @brief   message received, must be called before Start()
+   /// @param   Message_Handler   Handler, Default_Message_Handler to reset
+   /// @return  None
+   //+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+
+   inline void Set_Message_Handler(Socket_Vars::Message_Handler handler) { _context->handler = handler; }
+
+   //+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+
+   /// @brief   Hands every message and accepted client to the
+   /// @brief   coroutines awaiting them instead of a handler,
+   /// @brief   must be called before Start()
+   /// @return  None
+   //+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+
+   inline void Set_Async()
+   {
+      _context->handler = Socket_Vars::Async_Message_Handler;
+      _context->is_async = true;
+   }
+
+   //+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+
+   /// @brief   Awaits the next message not on an accepted
+   /// @brief   connection, one coroutine at a time, async only
+   /// @return  Awaiter           co_await it for a Received_Message
+   //+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+
+   inline Async::Channel<Socket_Vars::Received_Message>::Awaiter Async_Receive() { return _context->received.Receive(); }
+
+   //+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+
+   /// @brief   Sends a message to the socket's peer, or to every
+   /// @brief   client of a TCP server
+   /// @param   std::span         Message, copied onto the send queue
+   /// @return  Send_Awaiter      co_await it, true once queued
+   //+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+
+   inline Socket_Vars::Send_Awaiter Async_Send(std::span<const char> message)
+   {
+      return Socket_Vars::Send_Awaiter(_context.get(), Socket_Vars::NO_CONNECTION, message);
+   }
+
+   //+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+
+   /// @brief   Awaits the next client of an async TCP server,
+   /// @brief   one coroutine at a time
+   /// @return  Awaiter           co_await it for an Async_Connection
+   //+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+
+   inline Async::Channel<Socket_Vars::Async_Connection>::Awaiter Async_Accept() { return _context->accepted.Receive(); }
+
+   //+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+
+   /// @brief   Frames every TCP message with a length prefix so
+   /// @brief   messages survive TCP splitting and joining them,
+   /// @brief   must be called before Start(), both peers must match
+   /// @param   Prefix            Length prefix, NONE turns framing off
+   /// @param   uint32_t          Largest message sent or accepted
+   /// @return  None
+   //+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+
+   inline void Set_Framing(
+      Framing::Prefix prefix,
+      uint32_t max_frame_size = Framing::DEFAULT_MAX_FRAME_SIZE)
+   {
+      _framing = prefix;
+      _max_frame_size = max_frame_size;
+   }
+
+   //+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+
+   /// @brief   Gets the framing used on this socket's TCP streams
+   /// @return  Prefix            _framing
+   //+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+
+   inline Framing::Prefix Get_Framing() { return _framing; }
+
+   //+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+
+   /// @brief   Batches a UDP socket, each wakeup drains up to
+   /// @brief   datagrams into pooled buffers and runs of same
+   /// @brief   sized sends go out as one segmented send, must be
+   /// @brief   called before Start(), 1 turns batching off
+   /// @param   uint16_t          Most datagrams received per wakeup
+   /// @return  None
+   //+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+
+   inline void Set_UDP_Batch_Size(uint16_t datagrams) { _udp_batch_size = (0 == datagrams) ? 1 : datagrams; }
+
+   //+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+
+   /// @brief   Sends a TCP client's messages straight from their
+   /// @brief   own memory, the send buffer is set to 0 so Winsock
+   /// @brief   locks the messages of an overlapped send instead of
+   /// @brief   copying them, several sends are kept in flight,
+   /// @brief   must be called before Start(), not for servers
+   /// @param   bool              True to send zero-copy
+   /// @param   size_t            Shortest message sent on its own
+   /// @return  None
+   //+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+
+   inline void Set_Zero_Copy(bool is_zero_copy, size_t threshold = Socket_Vars::ZERO_COPY_THRESHOLD)
+   {
+      _is_zero_copy = is_zero_copy;
+      _zero_copy_threshold = (0 == threshold) ? 1 : threshold;
+   }
+
+   //+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+
+   /// @brief   Has a SHARED_MEMORY socket's receiving thread poll
+   /// @brief   its empty ring SPIN_COUNT times before it sleeps,
+   /// @brief   trading a core for wakeup latency, must be called
+   /// @brief   before Start()
+   /// @param   bool              True to spin before blocking
+   /// @return  None
+   //+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+
+   inline void Set_Spin_Then_Block(bool is_spinning) { _is_spinning = is_spinning; }
+
+   //+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+
+   /// @brief   Closes a connected stream that has received nothing
+   /// @brief   for the timeout, a client reconnects, a server's
+   /// @brief   client is dropped, event select sockets only, must
+   /// @brief   be called before Start()
+   /// @param   uint32_t          Timeout, in milliseconds, 0 for none
+   /// @return  None
+   //+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+
+   inline void Set_Idle_Timeout(uint32_t idle_timeout) { _idle_timeout = idle_timeout; }
+
+   //+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+
+   /// @brief   Queues a message every interval while the socket is
+   /// @brief   connected, on a server to each of its clients, so a
+   /// @brief   peer's idle timeout only fires on a dead link, must
+   /// @brief   be called before Start()
+   /// @param   uint32_t          Interval, in milliseconds, 0 for none
+   /// @param   std::string       Heartbeat message, framed like any other
+   /// @return  None
+   //+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+
+   inline void Set_Heartbeat(uint32_t interval, const std::string& message)
+   {
+      _heartbeat_interval = interval;
+      _heartbeat_message = Buffers::Copy_To_Send_Pool(message.data(), message.size());
+   }
+
+   //+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+
+   /// @brief   Bounds the bytes queued on the socket, the handler
+   /// @brief   is told when producers should hold off and when they
+   /// @brief   may go on, must be called before Start()
+   /// @param   size_t            Low watermark, in bytes
+   /// @param   size_t            High watermark, in bytes
+   /// @param   size_t            Most bytes queued, Queue_Message() refuses past it
+   /// @param   Watermark_Handler Handler, or nullptr to only poll Is_Send_Throttled()
+   /// @return  None
+   //+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+
+   void Set_Watermarks(size_t low_watermark, size_t high_watermark, size_t limit, Socket_Vars::Watermark_Handler handler);
+
+   //+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+
+   /// @brief   Sets how reconnects back off, the delay doubles on
+   /// @brief   every failed attempt and half of it is random so
+   /// @brief   peers dropped together do not retry together, must
+   /// @brief   be called before Start()
+   /// @param   uint32_t          First delay, in milliseconds
+   /// @param   uint32_t          Most delay, in milliseconds
+   /// @param   uint32_t          Longest a connect may take, in milliseconds
+   /// @return  None
+   //+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+
+   inline void Set_Reconnect_Backoff(
+      uint32_t base_delay,
+      uint32_t max_delay = Socket_Vars::RECONNECT_MAX_DELAY,
+      uint32_t connect_timeout = Socket_Vars::CONNECT_TIMEOUT)
+   {
+      _reconnect_base_delay = (0 == base_delay) ? 1 : base_delay;
+      _reconnect_max_delay = (max_delay < _reconnect_base_delay) ? _reconnect_base_delay : max_delay;
+      _connect_timeout = connect_timeout;
+   }
+
+   //+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+
+   /// @brief   Gets the index of this socket's registry slot
+   /// @return  uint32_t          _event_handle_index
+   //+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+
+   inline uint32_t Get_Queue_Index() { return _event_handle_index; }
+
+   //+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+
+   /// @brief   Gets this socket's counters and histograms, read
+   /// @brief   them through Socket_Registry::Get_Snapshot()
+   /// @return  Socket_Stats&     Stats in the registry slot
+   //+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+
+   inline Stats::Socket_Stats& Get_Stats() { return *_stats; }
+
+   //+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+
+   /// @brief   Gets the address messages without a destination of
+   /// @brief   their own are sent to, the last sender a unicast UDP
+   /// @brief   socket heard from, else its configured address
+   /// @return  SOCKADDR_INET     Address to send to
+   //+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+
+   SOCKADDR_INET Get_Send_Address();
+
 private:
 
    SOCKET _socket;
    SOCKET _listen_socket;
    SOCKADDR_IN _address;
+   SOCKADDR_UN _unix_address;             // UNIX_STREAM path bound or connected to
    Socket_Vars::Protocol _protocol;
    Socket_Vars::Connection_Type _connection;
+   Socket_Vars::IO_Engine _io_engine;
    std::string _ip_address;
    uint16_t _port;
    std::string _socket_name;
-   uint16_t _event_handle_index;
+   uint32_t _event_handle_index;
+   Stats::Socket_Stats* _stats;
    bool _is_socket_connected;
 
+   // Set once the socket is destroyed, no more reconnects are started
+   std::atomic<bool> _is_stopping;
+
+   // Set by the registered I/O completion thread when the peer left, the
+   // owning loop closes the socket, nothing else closes it under the loop
+   std::atomic<bool> _is_peer_closed;
+
+   // What a full socket buffer left of the last batch, the event loop polls
+   // for writable while _is_waiting_writable is set
+   Socket_Vars::Send_Backlog _backlog;
+   std::atomic<bool> _is_waiting_writable;
+
+   // Every message is sent zero-copy, those under _zero_copy_threshold
+   // bytes gathered several to a send
+   bool _is_zero_copy;
+   size_t _zero_copy_threshold;
+
+   // Files waiting for the send backlog, queued by any thread, the
+   // sending thread only takes the lock while _file_count is not 0
+   std::mutex _file_lock;
+   std::vector<std::unique_ptr<Socket_Vars::File_Send>> _files;
+   std::atomic<uint32_t> _file_count;
+
+   // Link of a SHARED_MEMORY socket, read by its own thread and written
+   // by the sending thread, the lock keeps a reattach from swapping it
+   // under a write, each attach bumps the generation so a backlog meant
+   // for the last peer is dropped
+   std::unique_ptr<Shared_Memory::Channel> _channel;
+   std::mutex _channel_lock;
+   std::thread _channel_thread;
+   HANDLE _channel_stop_event;
+   std::atomic<bool> _is_channel_running;
+   std::atomic<uint64_t> _channel_generation;
+   bool _is_spinning;
+
+   // Connects and reconnects run on the owning event loop, _deadline ends
+   // the backoff or the connect in progress
+   Socket_Vars::Connect_State _connect_state;
+   std::chrono::steady_clock::time_point _deadline;
+   uint32_t _reconnect_attempts;
+   uint32_t _reconnect_base_delay;
+   uint32_t _reconnect_max_delay;
+   uint32_t _connect_timeout;
+   std::minstd_rand _jitter;
+
+   // Timers on the owning loop's wheel, its receiving thread only, the
+   // deadline timer is moved whenever _deadline changes, the idle timer
+   // checks _last_receive_tick when it fires rather than being pushed
+   // back on every read
+   Timers::Timer_Id _deadline_timer;
+   std::chrono::steady_clock::time_point _armed_deadline;
+   Timers::Timer_Id _idle_timer;
+   Timers::Timer_Id _heartbeat_timer;
+   uint64_t _last_receive_tick;
+   uint32_t _idle_timeout;
+   uint32_t _heartbeat_interval;
+   Buffers::Buffer_View _heartbeat_message;   // Queued by reference every interval
+   Framing::Prefix _framing;
+   uint32_t _max_frame_size;
+
+   // Splits what arrives on _socket into messages
+   Framing::Frame_Decoder _decoder;
+
+   // Batched UDP receives, datagrams are packed into the current pooled
+   // buffer and every datagram keeps its own sender
+   uint16_t _udp_batch_size;
+   bool _is_send_segmentation_supported;
+   Buffers::Buffer_View _datagram_buffer;
+   size_t _datagram_used;
+   std::vector<Buffers::Buffer_View> _datagrams;
+   std::vector<SOCKADDR_INET> _datagram_senders;
+
+   // UDP sockets are AF_INET6 when ip_address is an IPv6 address and send
+   // to _address6, a socket whose ip_address is a multicast group binds the
+   // wildcard address and always sends to the group. A unicast socket sends
+   // to the last sender it heard from once one arrives, _last_sender is
+   // written by the receiving thread and read by the sending thread under
+   // _sender_lock, replies go to the sender each datagram carries
+   ADDRESS_FAMILY _family;
+   SOCKADDR_IN6 _address6;
+   std::mutex _sender_lock;
+   SOCKADDR_INET _last_sender;
+   bool _is_multicast;
+   uint32_t _multicast_interface;
+   uint8_t _multicast_ttl;
+   bool _is_multicast_loopback;
+   LPFN_WSARECVMSG _receive_message;
+
+   // Joined groups, joins and leaves take _group_lock and publish a new
+   // sorted snapshot, the receiving thread reads it without locking
+   std::mutex _group_lock;
+   std::atomic<std::shared_ptr<const Socket_Vars::Multicast_Groups>> _groups;
+   std::atomic<bool> _has_groups;
+   uint32_t _next_group;
+
+   // Accepted clients of a TCP server, nullptr for every other socket,
+   // each accepted client goes to the next event loop in turn
+   std::unique_ptr<Connection_Table> _connections;
+   uint16_t _next_loop;
+   Socket_Vars::Slow_Policy _slow_policy;
+
+   // Handler, strand and reply details of the socket, the strand's
+   // messages are handled on the handler pool
+   std::unique_ptr<Socket_Vars::Message_Context> _context;
+
    //+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+
    /// @brief   Opens the socket as a TCP Server
    /// @return  bool       Result of the opening of the socket
@@ -160,10 +1181,304 @@ private:
    //+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+
    bool TCP_Client_Start();
 
+   //+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+
+   /// @brief   Fills in the address a stream socket binds or
+   /// @brief   connects to, _address for TCP, _unix_address with
+   /// @brief   _ip_address as its path for UNIX_STREAM
+   /// @return  bool       False if the path is too long
+   //+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+
+   bool Set_Stream_Address();
+
+   // Address Set_Stream_Address() filled in, and its size
+   inline SOCKADDR* Stream_Address() { return (Socket_Vars::UNIX_STREAM == _protocol) ? (SOCKADDR*)&_unix_address : (SOCKADDR*)&_address; }
+   inline int Stream_Address_Size() { return (Socket_Vars::UNIX_STREAM == _protocol) ? sizeof(_unix_address) : sizeof(_address); }
+
+   //+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+
+   /// @brief   Gets the socket the owning loop polls, and whose
+   /// @brief   events Handle_Event() enumerates, the listen socket
+   /// @brief   until a client is accepted, nothing for a registered
+   /// @brief   I/O socket with its peer attached, it completes on
+   /// @brief   the engine and further clients wait in the backlog
+   /// @return  SOCKET      Socket polled, or INVALID_SOCKET
+   //+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+
+   SOCKET Get_Polled_Socket();
+
    //+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+
    /// @brief   Opens the socket as UDP
    /// @return  bool       Result of the opening of the socket
    //+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+
    bool UDP_Socket_Start();
 
+   //+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+
+   /// @brief   Sets the bound UDP socket up for multicast, every
+   /// @brief   datagram carries its destination, sends follow the
+   /// @brief   multicast options and the groups already asked for
+   /// @brief   are joined
+   /// @return  bool       Result of the options
+   //+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+
+   bool Configure_Multicast();
+
+   //+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+
+   /// @brief   Adds or drops _socket's membership of one group
+   /// @param   Multicast_Group   Group to join or leave
+   /// @param   bool              True to join, false to leave
+   /// @return  bool              Result of the membership change
+   //+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+
+   bool Set_Membership(const Socket_Vars::Multicast_Group& group, bool is_join);
+
+   // Configured address of a UDP socket, and its size
+   inline const SOCKADDR* Peer_Address() { return (AF_INET6 == _family) ? (SOCKADDR*)&_address6 : (SOCKADDR*)&_address; }
+   inline int Peer_Address_Size() { return (AF_INET6 == _family) ? sizeof(_address6) : sizeof(_address); }
+
+   //+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+
+   /// @brief   Opens the socket as a shared memory link, its own
+   /// @brief   thread attaches and receives
+   /// @return  bool       Result of the opening of the socket
+   //+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+
+   bool Shared_Memory_Start();
+
+   //+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+
+   /// @brief   Attaches to the peer, hands every message it writes
+   /// @brief   to the strand and reattaches once it leaves, until
+   /// @brief   the stop event is set
+   /// @return  None
+   //+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+
+   void Shared_Memory_Thread();
+
+   //+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+
+   /// @brief   Makes the channel, a server waits for its client,
+   /// @brief   a client retries with backoff until a server is up
+   /// @return  bool       False once the socket is stopping
+   //+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+
+   bool Attach_Channel();
+
+   //+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+
+   /// @brief   Copies a batch into the shared memory ring, what a
+   /// @brief   full ring refuses waits in the backlog until the
+   /// @brief   reader makes room
+   /// @param   uint64_t    Channel generation the batch is meant for
+   /// @param   Buffer_View* Messages to be sent, may be moved from
+   /// @param   size_t      Number of messages, up to SEND_BATCH_SIZE
+   /// @param   Send_Backlog Empty backlog, returns what was not sent
+   /// @return  bool        Result of the send
+   //+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+
+   bool Send_Shared(uint64_t generation, Buffers::Buffer_View* messages, size_t count, Socket_Vars::Send_Backlog& backlog);
+
+   //+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+
+   /// @brief   Accepts every pending client into the connection
+   /// @brief   table until the backlog is empty
+   /// @return  bool       Result of the accepts
+   //+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+
+   bool Accept_Connections();
+
+   //+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+
+   /// @brief   Sends one datagram over the given socket
+   /// @param   SOCKET      Socket to send on
+   /// @param   SOCKADDR_INET Address to send to
+   /// @param   char*       Buffer containing the message
+   /// @param   size_t      Length of the message
+   /// @return  bool        Result of the send, WSAGetLastError() says why
+   //+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+
+   bool Send_Datagram(SOCKET socket, const SOCKADDR_INET& destination, const char* buffer, size_t length);
+
+   //+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+
+   /// @brief   Sends a batch of messages over the given socket,
+   /// @brief   what does not fit in the socket buffer is kept
+   /// @param   SOCKET      Socket to send on
+   /// @param   Buffer_View* Messages to be sent, may be moved from
+   /// @param   size_t      Number of messages, up to SEND_BATCH_SIZE
+   /// @param   Send_Backlog Empty backlog, returns what was not sent
+   /// @return  bool        Result of the send
+   //+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+
+   bool Send_Batch(SOCKET socket, Buffers::Buffer_View* messages, size_t count, Socket_Vars::Send_Backlog& backlog);
+
+   //+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+
+   /// @brief   Writes gathered buffers until they have all gone,
+   /// @brief   what a full socket buffer leaves is copied to the
+   /// @brief   backlog's stream
+   /// @param   SOCKET      Socket to send on
+   /// @param   WSABUF*     Buffers, trimmed as they are written
+   /// @param   DWORD       Number of buffers
+   /// @param   Send_Backlog Backlog, returns what was not sent
+   /// @return  bool        Result of the send
+   //+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+
+   bool Write_Buffers(SOCKET socket, WSABUF* buffers, DWORD buffer_count, Socket_Vars::Send_Backlog& backlog);
+
+   //+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+
+   /// @brief   Writes a batch of framed broadcasts straight from
+   /// @brief   their shared buffers in one gathered write, then
+   /// @brief   lets go of them, what a full socket buffer leaves
+   /// @brief   is copied to the backlog
+   /// @param   SOCKET      Socket to send on
+   /// @param   Buffer_View* Broadcasts, released on return
+   /// @param   size_t      Number of broadcasts, up to SEND_BATCH_SIZE
+   /// @param   Send_Backlog Backlog, returns what was not sent
+   /// @return  bool        Result of the send
+   //+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+
+   bool Send_Broadcasts(SOCKET socket, Buffers::Buffer_View* broadcasts, size_t count, Socket_Vars::Send_Backlog& backlog);
+
+   //+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+
+   /// @brief   Starts overlapped sends straight from the messages,
+   /// @brief   each kept in the backlog until its completion
+   /// @brief   routine runs on this sending thread, what finds no
+   /// @brief   room in flight waits in the backlog
+   /// @param   SOCKET      Socket to send on
+   /// @param   Buffer_View* Messages, moved from
+   /// @param   size_t      Number of messages
+   /// @param   Send_Backlog Backlog holding the sends in flight
+   /// @return  bool        False if a send failed
+   //+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+
+   bool Send_Zero_Copy(SOCKET socket, Buffers::Buffer_View* messages, size_t count, Socket_Vars::Send_Backlog& backlog);
+
+   //+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+
+   /// @brief   Starts an overlapped TransmitFile() of the backlog's
+   /// @brief   file from where it got to, its registered wait
+   /// @brief   schedules the socket again once the chunk is done
+   /// @param   SOCKET      Socket to send on
+   /// @param   Send_Backlog Backlog holding the file
+   /// @return  bool        Result of the send
+   //+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+
+   bool Send_File_Chunk(SOCKET socket, Socket_Vars::Send_Backlog& backlog);
+
+   //+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+
+   /// @brief   Writes what a full socket buffer left, a backlog
+   /// @brief   meant for a socket since replaced is dropped
+   /// @param   SOCKET      Socket to send on
+   /// @param   Send_Backlog Backlog, emptied as far as it fits
+   /// @return  bool        Result of the send
+   //+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+
+   bool Flush_Backlog(SOCKET socket, Socket_Vars::Send_Backlog& backlog);
+
+   //+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+
+   /// @brief   Drains up to a batch of datagrams from _socket and
+   /// @brief   handles each with its own sender
+   /// @return  bool        False if the receive failed
+   //+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+
+   bool Receive_Datagrams();
+
+   //+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+
+   /// @brief   Drains up to a batch of datagrams from an IPv6 or
+   /// @brief   multicast UDP _socket, each handed up with the group
+   /// @brief   its destination address belongs to
+   /// @return  bool        False if the receive failed
+   //+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+
+   bool Receive_Group_Datagrams();
+
+   //+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+
+   /// @brief   Sends a batch of datagrams, each to its destination,
+   /// @brief   runs of the same size to the same destination go out
+   /// @brief   in one send the stack splits into datagrams
+   /// @param   SOCKET      Socket to send on
+   /// @param   Queued_Send* Datagrams to be sent, may be moved from
+   /// @param   size_t      Number of datagrams, up to SEND_BATCH_SIZE
+   /// @param   Send_Backlog Empty backlog, returns the datagrams not sent
+   /// @return  bool        Result of the send
+   //+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+
+   bool Send_Datagrams(SOCKET socket, Socket_Vars::Queued_Send* datagrams, size_t count, Socket_Vars::Send_Backlog& backlog);
+
+   //+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+
+   /// @brief   Has the event loop poll a socket with a backlog for
+   /// @brief   writable, it schedules the send again once it is
+   /// @param   atomic<bool>  Waiting flag of the socket or connection
+   /// @param   uint16_t      Event loop polling the socket
+   /// @return  None
+   //+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+
+   void Wait_For_Writable(std::atomic<bool>& is_waiting_writable, uint16_t loop);
+
+   //+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+
+   /// @brief   Reads what is waiting on the given socket into its
+   /// @brief   decoder and handles every whole message
+   /// @param   SOCKET            Socket to receive from
+   /// @param   Frame_Decoder     Decoder of the socket's stream
+   /// @param   uint32_t          Accepted connection, or NO_CONNECTION
+   /// @return  bool              False if the socket closed or failed
+   //+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+
+   bool Receive_Frames(SOCKET socket, Framing::Frame_Decoder& decoder, uint32_t connection);
+
+   //+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+
+   /// @brief   Frees an accepted connection's slot and cancels its
+   /// @brief   timers, the sending thread closes the socket once
+   /// @brief   nothing can still be sending on it
+   /// @param   uint32_t          Connection index
+   /// @return  None
+   //+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+
+   void Drop_Connection(uint32_t connection);
+
+   //+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+
+   /// @brief   Starts an accepted connection's idle and heartbeat
+   /// @brief   timers on the wheel of the loop it was handed to
+   /// @param   uint32_t          Connection index
+   /// @param   Timer_Wheel&      Wheel of the connection's loop
+   /// @return  None
+   //+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+
+   void Arm_Connection_Timers(uint32_t connection, Timers::Timer_Wheel& wheel);
+
+   //+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+
+   /// @brief   Wheel callback of every socket and connection timer,
+   /// @brief   the data says which timer and which connection
+   /// @param   void*             Socket
+   /// @param   uint64_t          Timer kind above, connection below
+   /// @return  None
+   //+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+
+   static void Timer_Expired(void* context, uint64_t data);
+
+   //+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+
+   /// @brief   Runs a timer that fired, a deadline starts or gives
+   /// @brief   up on a connect, an idle timer closes a silent link
+   /// @brief   or waits out the rest, a heartbeat is queued
+   /// @param   Timer_Kind        Which timer fired
+   /// @param   uint32_t          Connection, or NO_CONNECTION
+   /// @return  bool              Result of handling it
+   //+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+
+   bool Handle_Timer(Socket_Vars::Timer_Kind kind, uint32_t connection);
+
+   //+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+
+   /// @brief   Posts an accepted connection's opening or closing
+   /// @brief   to its strand, in order with its messages, into a
+   /// @brief   cell the strand keeps for it so it never waits
+   /// @param   uint32_t          Connection index
+   /// @param   Receive_Event     CONNECTION_OPENED or CONNECTION_CLOSED
+   /// @return  None
+   //+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+
+   void Post_Connection_Event(uint32_t connection, Socket_Vars::Receive_Event event);
+
+   //+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+
+   /// @brief   Creates a socket handle for the selected I/O engine
+   /// @brief   in the protocol's family, AF_UNIX for UNIX_STREAM
+   /// @brief   and _family for UDP
+   /// @param   int         Socket type, SOCK_STREAM or SOCK_DGRAM
+   /// @param   int         Protocol, IPPROTO_TCP or IPPROTO_UDP
+   /// @return  SOCKET      New socket or INVALID_SOCKET
+   //+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+
+   SOCKET Open_Socket(int type, int protocol);
+
+   //+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+
+   /// @brief   Hands a connected or bound _socket to the engine,
+   /// @brief   event select sockets are associated with their event
+   /// @return  bool       Result of the association
+   //+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+
+   bool Attach_Socket();
+
+   //+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+
+   /// @brief   Associates _socket with the socket's event, the
+   /// @brief   event is created once and kept across reconnects,
+   /// @brief   this also makes _socket non-blocking
+   /// @return  bool       Result of the association
+   //+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+
+   bool Select_Events();
+
+   //+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+
+   /// @brief   Opens a new TCP client socket and starts a
+   /// @brief   non-blocking connect, it completes on the event loop
+   /// @return  bool       False if the connect could not be started
+   //+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+
+   bool Begin_Connect();
+
+   //+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+
+   /// @brief   Makes a TCP client whose connect completed ready to
+   /// @brief   send and receive, anything queued meanwhile goes now
+   /// @return  bool       Result of attaching the connected socket
+   //+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+
+   bool Complete_Connect();
+
 };	// END class Universal_Socket
\ No newline at end of file
@@ -0,0 +1,354 @@
+//+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+
+// 
+//  ___________ __  .__                       ___________
+//  \_   _____//  |_|  |__ _____    ____      \_   _____/
+//   |    __)_\   __\  |  \\__  \  /    \      |    __)_ 
+//   |        \|  | |   Y  \/ __ \|   |  \     |        \
+//  /_______  /|__| |___|  (____  /___|  / /\ /_______  /
+//          \/           \/     \/     \/  \/         \/ 
+// 
+// Work Pool Implementation File
+//
+//  Author   Date         Description
+// --------------------------------------------------------
+//  ECE      10-17-2026   Initial Implementation
+//  ECE      10-17-2026   Task_Inbox is a Lock_Free::Link_Queue of tasks
+//  ECE      10-17-2026   Added Defer for tasks waiting on other tasks
+//  ECE      10-17-2026   Messages go to the asynchronous log
+//+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+
+
+#include "Work_Pool.h"
+#include "Socket_Log.h"
+
+#include <thread>
+
+namespace Work_Pool
+{
+   // Pool and worker index of the calling thread, nullptr off the pool
+   static thread_local Pool* current_pool = nullptr;
+   static thread_local uint16_t current_worker = 0;
+
+   //+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+
+   /// Pool every received message is handled on
+   //+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+
+   Pool& Handler_Pool()
+   {
+      static Pool pool;
+      return pool;
+   }  // END Handler_Pool()
+
+   //-+-+-+-+-+-+-+-+-+-+-+Task_Deque FUNCTIONS+-+-+-+-+-+-+-+-+-+-+-+-+
+
+   //+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+
+   /// Allocates the ring
+   //+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+
+   void Task_Deque::Initialize(size_t capacity)
+   {
+      size_t size = 2;
+      while (size < capacity)
+      {
+         size <<= 1;
+      }
+
+      _tasks.reset(new std::atomic<Task*>[size]);
+      _mask = static_cast<int64_t>(size) - 1;
+      for (size_t i = 0; i < size; i++)
+      {
+         _tasks[i].store(nullptr, std::memory_order_relaxed);
+      }
+      _top.store(0, std::memory_order_relaxed);
+      _bottom.store(0, std::memory_order_relaxed);
+   }  // END Initialize()
+
+   //+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+
+   /// Pushes a task on the bottom
+   //+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+
+   bool Task_Deque::Push(Task* task)
+   {
+      int64_t bottom = _bottom.load(std::memory_order_relaxed);
+      int64_t top = _top.load(std::memory_order_acquire);
+
+      if (_mask < bottom - top)
+      {
+         return false;    // Full
+      }
+
+      // The release store publishes the task to thieves
+      _tasks[bottom & _mask].store(task, std::memory_order_relaxed);
+      _bottom.store(bottom + 1, std::memory_order_release);
+      return true;
+   }  // END Push()
+
+   //+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+
+   /// Pops the newest task off the bottom
+   //+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+
+   Task* Task_Deque::Pop()
+   {
+      Task* task = nullptr;
+
+      //
+      // 1. Reserve the bottom task before looking at the top, so a thief
+      //    and the owner never both take the same task
+      int64_t bottom = _bottom.load(std::memory_order_relaxed) - 1;
+      _bottom.store(bottom, std::memory_order_seq_cst);
+      int64_t top = _top.load(std::memory_order_seq_cst);
+
+      //
+      // 2. Empty, put the bottom back
+      if (top > bottom)
+      {
+         _bottom.store(bottom + 1, std::memory_order_relaxed);
+         return nullptr;
+      }
+
+      //
+      // 3. More than one task left, no thief can reach this one
+      task = _tasks[bottom & _mask].load(std::memory_order_relaxed);
+      if (top < bottom)
+      {
+         return task;
+      }
+
+      //
+      // 4. The last task, race the thieves for it on the top
+      if (!_top.compare_exchange_strong(top, top + 1, std::memory_order_seq_cst, std::memory_order_relaxed))
+      {
+         task = nullptr;
+      }
+      _bottom.store(bottom + 1, std::memory_order_relaxed);
+
+      return task;
+   }  // END Pop()
+
+   //+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+
+   /// Steals the oldest task off the top
+   //+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+
+   Task* Task_Deque::Steal()
+   {
+      Task* task;
+      int64_t top = _top.load(std::memory_order_seq_cst);
+      int64_t bottom = _bottom.load(std::memory_order_seq_cst);
+
+      if (top >= bottom)
+      {
+         return nullptr;
+      }
+
+      // Read before claiming, once the top moves the owner may reuse the cell
+      task = _tasks[top & _mask].load(std::memory_order_relaxed);
+      if (!_top.compare_exchange_strong(top, top + 1, std::memory_order_seq_cst, std::memory_order_relaxed))
+      {
+         return nullptr;   // Lost to the owner or another thief
+      }
+
+      return task;
+   }  // END Steal()
+
+   //-+-+-+-+-+-+-+-+-+-+-+Pool FUNCTIONS+-+-+-+-+-+-+-+-+-+-+-+-+-+
+
+   //+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+
+   /// Constructor
+   //+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+
+   Pool::Pool()
+   {
+      for (uint16_t i = 0; i < MAX_WORKERS; i++)
+      {
+         _workers[i].wake_event = nullptr;
+         _workers[i].is_sleeping.store(false, std::memory_order_relaxed);
+      }
+      _worker_count.store(0, std::memory_order_relaxed);
+   }  // END Constructor
+
+   //+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+
+   /// Starts the worker threads
+   //+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+
+   bool Pool::Start(uint16_t worker_count)
+   {
+      bool result = true;
+
+      //
+      // 1. Only once, the workers run for the life of the program
+      if (0 != _worker_count.load(std::memory_order_acquire))
+      {
+         Log::Write<Log::LEVEL_WARNING>("Work pool already started!\n");
+         result &= false;
+         return result;
+      }
+      if (0 == worker_count || MAX_WORKERS < worker_count)
+      {
+         worker_count = (0 == worker_count) ? 1 : MAX_WORKERS;
+      }
+
+      //
+      // 2. Every worker's deque and wake event exist before any thread runs
+      for (uint16_t i = 0; i < worker_count; i++)
+      {
+         _workers[i].deque.Initialize(DEQUE_CAPACITY);
+         _workers[i].wake_event = CreateEvent(nullptr, FALSE, FALSE, nullptr);
+      }
+      _worker_count.store(worker_count, std::memory_order_release);
+
+      //
+      // 3. Start the workers, worker 0 picks up anything submitted before now
+      for (uint16_t i = 0; i < worker_count; i++)
+      {
+         std::thread(&Pool::Worker_Thread, this, i).detach();
+      }
+
+      return result;
+   }  // END Start()
+
+   //+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+
+   /// Submits a task
+   //+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+
+   void Pool::Submit(Task* task)
+   {
+      uint16_t worker_count = _worker_count.load(std::memory_order_acquire);
+      uint16_t worker;
+
+      //
+      // 1. A worker keeps its own follow on work, newest first and
+      //    stealable by idle workers
+      if (this == current_pool && _workers[current_worker].deque.Push(task))
+      {
+         return;
+      }
+
+      //
+      // 2. Everyone else hands the task to its home worker's inbox and
+      //    wakes that worker, before Start() it waits for worker 0
+      worker = (0 == worker_count) ? 0 : task->Get_Home_Worker() % worker_count;
+      _workers[worker].inbox.Push(task);
+      if (0 != worker_count)
+      {
+         Wake_Worker(worker);
+      }
+   }  // END Submit()
+
+   //+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+
+   /// Submits a task behind everything waiting on its home worker
+   //+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+
+   void Pool::Defer(Task* task)
+   {
+      uint16_t worker_count = _worker_count.load(std::memory_order_acquire);
+      uint16_t worker = (0 == worker_count) ? 0 : task->Get_Home_Worker() % worker_count;
+
+      // The inbox is only emptied once the worker's deque is, so the
+      // worker runs everything it already holds first
+      _workers[worker].inbox.Push(task);
+      if (0 != worker_count)
+      {
+         Wake_Worker(worker);
+      }
+   }  // END Defer()
+
+   //+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+
+   /// Wakes a worker if it is asleep
+   //+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+
+   bool Pool::Wake_Worker(uint16_t index)
+   {
+      if (_workers[index].is_sleeping.exchange(false, std::memory_order_seq_cst))
+      {
+         SetEvent(_workers[index].wake_event);
+         return true;
+      }
+      return false;
+   }  // END Wake_Worker()
+
+   //+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+
+   /// Steals the oldest task of the next busy worker
+   //+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+
+   Task* Pool::Steal(uint16_t thief)
+   {
+      Task* task;
+      uint16_t worker_count = _worker_count.load(std::memory_order_acquire);
+
+      for (uint16_t i = 1; i < worker_count; i++)
+      {
+         task = _workers[(thief + i) % worker_count].deque.Steal();
+         if (nullptr != task)
+         {
+            return task;
+         }
+      }
+      return nullptr;
+   }  // END Steal()
+
+   //+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+
+   /// Main loop of each worker thread
+   //+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+
+   void Pool::Worker_Thread(uint16_t index)
+   {
+      Worker& self = _workers[index];
+      uint16_t worker_count = _worker_count.load(std::memory_order_acquire);
+      Task* task;
+      size_t moved;
+
+      current_pool = this;
+      current_worker = index;
+
+      while (true)
+      {
+         //
+         // 1. Newest task on the worker's own deque first
+         task = self.deque.Pop();
+
+         //
+         // 2. Move tasks submitted from outside the pool onto the deque where
+         //    idle workers can steal them, the deque is empty so half of it
+         //    always fits, more than one task is worth waking a neighbour for
+         if (nullptr == task)
+         {
+            for (moved = 0; moved < DEQUE_CAPACITY / 2; moved++)
+            {
+               task = self.inbox.Pop();
+               if (nullptr == task)
+               {
+                  break;
+               }
+               self.deque.Push(task);
+            }
+            if (1 < moved)
+            {
+               for (uint16_t i = 1; i < worker_count && !Wake_Worker((index + i) % worker_count); i++)
+               {
+               }
+            }
+            task = self.deque.Pop();
+         }
+
+         //
+         // 3. Otherwise steal the oldest task of a busy worker
+         if (nullptr == task)
+         {
+            task = Steal(index);
+         }
+
+         if (nullptr != task)
+         {
+            task->Run();
+            continue;
+         }
+
+         //
+         // 4. Nothing anywhere, sleep until a task is submitted to this worker,
+         //    the flag is raised before the last look so a submit in between
+         //    still wakes it
+         self.is_sleeping.store(true, std::memory_order_seq_cst);
+         if (!self.inbox.Empty())
+         {
+            self.is_sleeping.store(false, std::memory_order_relaxed);
+            continue;
+         }
+         if (WAIT_OBJECT_0 != WaitForSingleObject(self.wake_event, INFINITE))
+         {
+            Log::Write<Log::LEVEL_ERROR>("Work pool worker %u wait failed with: %u\n", index, GetLastError());
+            break;
+         }
+         self.is_sleeping.store(false, std::memory_order_relaxed);
+      }
+
+      Log::Write<Log::LEVEL_INFO>("Closing work pool worker %u!\n", index);
+   }  // END Worker_Thread()
+
+}  // END namespace Work_Pool
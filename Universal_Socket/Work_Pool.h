@@ -0,0 +1,344 @@
+//+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+
+// 
+//  ___________ __  .__                       ___________
+//  \_   _____//  |_|  |__ _____    ____      \_   _____/
+//   |    __)_\   __\  |  \\__  \  /    \      |    __)_ 
+//   |        \|  | |   Y  \/ __ \|   |  \     |        \
+//  /_______  /|__| |___|  (____  /___|  / /\ /_______  /
+//          \/           \/     \/     \/  \/         \/ 
+// 
+// Work Pool Header File
+//
+//  Author   Date         Description
+// --------------------------------------------------------
+//  ECE      10-17-2026   Initial Implementation
+//  ECE      10-17-2026   Task_Inbox is a Lock_Free::Link_Queue of tasks
+//  ECE      10-17-2026   Added Defer and Strand::Is_Idle
+//  ECE      10-17-2026   Strands may keep cells back for Post_Reserved
+//+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+
+
+#pragma once
+
+#include "Lock_Free_Queue.h"
+
+#include <WinSock2.h>
+#include <atomic>
+#include <cstddef>
+#include <cstdint>
+#include <memory>
+#include <utility>
+
+namespace Work_Pool
+{
+   // Most worker threads in a pool
+   constexpr uint16_t MAX_WORKERS{ 64 };
+
+   // Tasks each worker's deque holds, tasks past this wait in its inbox
+   constexpr size_t DEQUE_CAPACITY{ 4096 };
+
+   // Most items a strand handles before letting other tasks run
+   constexpr size_t STRAND_BATCH_SIZE{ 64 };
+
+   //+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+
+   /// @brief   Work a pool runs, a task is submitted again only
+   /// @brief   after it has been taken off every list
+   //+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+
+   class Task : public Lock_Free::Queue_Link
+   {
+   public:
+
+      Task() : _home_worker(0) {}
+      virtual ~Task() {}
+
+      //+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+
+      /// @brief   Does the work, called on one worker at a time
+      /// @return  None
+      //+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+
+      virtual void Run() = 0;
+
+      //+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+
+      /// @brief   Sets the worker the task is submitted to from
+      /// @brief   outside the pool, keeping it on one core's caches
+      /// @param   uint16_t          Worker, wrapped to the worker count
+      /// @return  None
+      //+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+
+      inline void Set_Home_Worker(uint16_t worker) { _home_worker = worker; }
+
+      //+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+
+      /// @brief   Gets the worker the task is submitted to
+      /// @return  uint16_t          _home_worker
+      //+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+
+      inline uint16_t Get_Home_Worker() { return _home_worker; }
+
+   private:
+
+      uint16_t _home_worker;
+
+   };  // END class Task
+
+   //+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+
+   /// @brief   Bounded work stealing deque, the owning worker
+   /// @brief   pushes and pops the newest task, any other worker
+   /// @brief   steals the oldest
+   //+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+
+   class Task_Deque
+   {
+   public:
+
+      //+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+
+      /// @brief   Allocates the ring, must be called before use
+      /// @param   size_t            Capacity, rounded up to a power of two
+      /// @return  None
+      //+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+
+      void Initialize(size_t capacity);
+
+      //+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+
+      /// @brief   Pushes a task on the bottom, owner only
+      /// @param   Task*             Task to push
+      /// @return  bool              False if the deque is full
+      //+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+
+      bool Push(Task* task);
+
+      //+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+
+      /// @brief   Pops the newest task off the bottom, owner only
+      /// @return  Task*             Task, or nullptr if empty
+      //+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+
+      Task* Pop();
+
+      //+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+
+      /// @brief   Steals the oldest task off the top, any thread
+      /// @return  Task*             Task, or nullptr if empty or lost
+      //+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+
+      Task* Steal();
+
+   private:
+
+      std::unique_ptr<std::atomic<Task*>[]> _tasks;
+      int64_t _mask = 0;
+      alignas(Lock_Free::CACHE_LINE_SIZE) std::atomic<int64_t> _top{ 0 };      // Moved by thieves
+      alignas(Lock_Free::CACHE_LINE_SIZE) std::atomic<int64_t> _bottom{ 0 };   // Moved by the owner
+
+   };  // END class Task_Deque
+
+   // Unbounded list of tasks linked through the tasks themselves,
+   // so a submit from outside the pool never fails
+   typedef Lock_Free::Link_Queue<Task> Task_Inbox;
+
+   //+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+
+   /// @brief   Fixed set of worker threads, each with its own
+   /// @brief   deque and inbox, idle workers steal from busy ones
+   //+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+
+   class Pool
+   {
+   public:
+
+      //+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+
+      /// @brief   Constructor, no thread runs until Start()
+      //+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+
+      Pool();
+
+      //+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+
+      /// @brief   Starts the worker threads, once, they run for
+      /// @brief   the life of the program, tasks submitted before
+      /// @brief   wait for the first worker
+      /// @param   uint16_t          Number of workers, up to MAX_WORKERS
+      /// @return  bool              False if already started
+      //+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+
+      bool Start(uint16_t worker_count);
+
+      //+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+
+      /// @brief   Submits a task, a worker submits to its own deque,
+      /// @brief   any other thread to the task's home worker
+      /// @param   Task*             Task on no other list
+      /// @return  None
+      //+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+
+      void Submit(Task* task);
+
+      //+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+
+      /// @brief   Submits a task behind everything already waiting
+      /// @brief   on its home worker, a task waiting on other tasks
+      /// @brief   uses it so it is not run again ahead of them
+      /// @param   Task*             Task on no other list
+      /// @return  None
+      //+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+
+      void Defer(Task* task);
+
+      //+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+
+      /// @brief   Gets the number of running workers
+      /// @return  uint16_t          0 until Start()
+      //+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+
+      inline uint16_t Get_Worker_Count() { return _worker_count.load(std::memory_order_acquire); }
+
+   private:
+
+      struct alignas(Lock_Free::CACHE_LINE_SIZE) Worker
+      {
+         Task_Deque deque;
+         Task_Inbox inbox;
+         HANDLE wake_event;
+         std::atomic<bool> is_sleeping;
+      };
+
+      Worker _workers[MAX_WORKERS];
+      std::atomic<uint16_t> _worker_count;
+
+      //+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+
+      /// @brief   Main loop of each worker thread
+      /// @param   uint16_t          Index of the worker
+      /// @return  None
+      //+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+
+      void Worker_Thread(uint16_t index);
+
+      //+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+
+      /// @brief   Steals the oldest task of the next busy worker
+      /// @param   uint16_t          Index of the worker stealing
+      /// @return  Task*             Task, or nullptr if none was found
+      //+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+
+      Task* Steal(uint16_t thief);
+
+      //+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+
+      /// @brief   Wakes a worker if it is asleep
+      /// @param   uint16_t          Index of the worker
+      /// @return  bool              True if it was asleep
+      //+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+
+      bool Wake_Worker(uint16_t index);
+
+   };  // END class Pool
+
+   //+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+
+   /// @brief   Pool every received message is handled on
+   /// @return  Pool&             The one handler pool
+   //+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+
+   Pool& Handler_Pool();
+
+   //+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+
+   /// @brief   Serial queue of items run on the handler pool, the
+   /// @brief   strand is submitted as one task so its items are
+   /// @brief   handled in order and never on two workers at once
+   //+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+
+   template <typename T>
+   class Strand : public Task
+   {
+   public:
+
+      typedef void (*Handler)(void* context, T& item);
+
+      Strand() : _handler(nullptr), _context(nullptr), _capacity(0), _reserved(0) { _pending.store(0, std::memory_order_relaxed); }
+
+      //+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+
+      /// @brief   Allocates the queue, must be called before use
+      /// @param   size_t            Most items waiting at once
+      /// @param   Handler           Called on a worker for every item
+      /// @param   void*             Passed to the handler
+      /// @param   uint16_t          Worker the strand is submitted to
+      /// @param   size_t            Cells kept back for Post_Reserved
+      /// @return  None
+      //+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+
+      void Initialize(size_t capacity, Handler handler, void* context, uint16_t home_worker, size_t reserved = 0)
+      {
+         _queue.Initialize(capacity + reserved);
+         _capacity = capacity;
+         _reserved = reserved;
+         _handler = handler;
+         _context = context;
+         Set_Home_Worker(home_worker);
+      }
+
+      //+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+
+      /// @brief   Queues an item, safe from any thread, only the
+      /// @brief   producer that finds nothing pending submits it,
+      /// @brief   the reserved cells are left alone
+      /// @param   T                 Item, moved into the queue
+      /// @return  bool              False if the queue is full
+      //+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+
+      bool Post(T item)
+      {
+         // Pending never counts under what is queued, so with a single
+         // producer the reserved cells are free whenever this refuses
+         if (0 != _reserved && _capacity <= _pending.load(std::memory_order_acquire))
+         {
+            return false;
+         }
+         return Enqueue(item);
+      }
+
+      //+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+
+      /// @brief   Queues an item that may take a reserved cell, for
+      /// @brief   items that must never be dropped or waited on,
+      /// @brief   no more than reserved of them may be pending
+      /// @param   T                 Item, moved into the queue
+      /// @return  bool              False if the queue is full
+      //+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+
+      bool Post_Reserved(T item)
+      {
+         return Enqueue(item);
+      }
+
+      //+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+
+      /// @brief   Handles up to STRAND_BATCH_SIZE items, then goes
+      /// @brief   back on the pool if more are pending
+      /// @return  None
+      //+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+
+      void Run() override
+      {
+         size_t pending = _pending.load(std::memory_order_acquire);
+         size_t handled = 0;
+
+         // Never more than were counted, so the count cannot go below zero
+         while (handled < pending && handled < STRAND_BATCH_SIZE)
+         {
+            T item;
+            if (!_queue.Pop(item))
+            {
+               break;   // An earlier producer has not published yet
+            }
+            _handler(_context, item);
+            handled++;
+         }
+
+         // The strand stays submitted while anything is pending, the read
+         // modify write hands the queue to whichever worker runs it next
+         if (handled != _pending.fetch_sub(handled, std::memory_order_acq_rel))
+         {
+            Handler_Pool().Submit(this);
+         }
+      }
+
+      //+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+
+      /// @brief   Checks every posted item has been handled, a
+      /// @brief   strand that is idle with no one left to post to
+      /// @brief   it is done with its context
+      /// @return  bool              True if nothing is pending
+      //+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+
+      inline bool Is_Idle() { return 0 == _pending.load(std::memory_order_acquire); }
+
+   private:
+
+      Lock_Free::MPSC_Queue<T> _queue;
+      std::atomic<size_t> _pending;   // Posted and not yet handled, submitted while not 0
+      Handler _handler;
+      void* _context;
+      size_t _capacity;               // Cells Post() may fill
+      size_t _reserved;               // Cells past them only Post_Reserved() fills
+
+      //+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+
+      /// @brief   Pushes an item and submits the strand if it was idle
+      /// @param   T&                Item, moved into the queue
+      /// @return  bool              False if the queue is full
+      //+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+
+      bool Enqueue(T& item)
+      {
+         if (!_queue.Push(std::move(item)))
+         {
+            return false;
+         }
+         if (0 == _pending.fetch_add(1, std::memory_order_acq_rel))
+         {
+            Handler_Pool().Submit(this);
+         }
+         return true;
+      }
+
+   };  // END class Strand
+
+}  // END namespace Work_Pool